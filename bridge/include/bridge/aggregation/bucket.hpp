@@ -0,0 +1,166 @@
+// Copyright (c) 2021 Bridge Project (Marcos Pontes)
+
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to
+//  deal in the Software without restriction, including without limitation the
+//  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+//  sell copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+//  IN THE SOFTWARE.
+
+//! \brief Range and filters bucket aggregations, each computed in a single pass over the hits.
+
+#ifndef BRIDGE_BUCKET_HPP_
+#define BRIDGE_BUCKET_HPP_
+
+#include <algorithm>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "bridge/collector/collector.hpp"
+#include "bridge/fastfield/numeric_column.hpp"
+#include "bridge/postings/doc_set.hpp"
+
+namespace bridge::aggregation {
+
+    /**
+     * @brief A bucket of a range aggregation: the documents whose value is in [from, to).
+     */
+    struct range_bucket {
+        std::string key;
+        std::optional<double> from; //!< Smallest value, included, none for no lower bound.
+        std::optional<double> to;   //!< Largest value, excluded, none for no upper bound.
+        uint64_t doc_count = 0;
+
+        bool operator==(const range_bucket &other) const = default;
+    };
+
+    /**
+     * @brief Counts the matching documents of a segment in ranges of a fast field, e.g. price facets.
+     *
+     * @details The bounds of every range are sorted once into a small array of boundaries, padded to a power
+     * of two minus one. The value of a document is located among the boundaries with a branch-free binary
+     * search, which the compiler turns into conditional moves, and the count of the elementary interval it
+     * falls in is incremented: a single pass over the column and no unpredictable branch, whatever the number
+     * of buckets. Each range then sums the elementary intervals it spans, so ranges may overlap or leave gaps.
+     */
+    class range_collector : public collector::collector {
+      public:
+        /**
+         * @brief Construct a new collector.
+         *
+         * @param column Fast field of the segment. It must outlive the collector.
+         * @param ranges Requested ranges. Their counts are ignored.
+         */
+        range_collector(const fastfield::numeric_column &column, std::vector<range_bucket> ranges);
+
+        void collect(DocId doc, Score) override { counts_[interval(column_->get_raw(doc))]++; }
+
+        /**
+         * @brief Counts a block of matching documents.
+         */
+        void collect_block(const DocId *docs, size_t count) {
+            for (size_t i = 0; i < count; i++) {
+                counts_[interval(column_->get_raw(docs[i]))]++;
+            }
+        }
+
+        /**
+         * @brief Adds the counts of another segment, collected with the same ranges.
+         */
+        void merge(const range_collector &other);
+
+        /**
+         * @brief The ranges and their counts, in the requested order.
+         */
+        [[nodiscard]] std::vector<range_bucket> buckets() const;
+
+      private:
+        /// @brief Number of boundaries lower or equal to a value.
+        [[nodiscard]] size_t interval(uint64_t raw) const {
+            size_t index = 0;
+            for (size_t step = (boundaries_.size() + 1) / 2; step > 0; step /= 2) {
+                index += static_cast<size_t>(boundaries_[index + step - 1] <= raw) * step;
+            }
+            return std::min(index, counts_.size() - 1); // only the largest value goes past the padding
+        }
+
+        const fastfield::numeric_column *column_;
+        std::vector<range_bucket> ranges_;
+        std::vector<uint64_t> boundaries_;             // sorted, padded with the largest value
+        std::vector<std::pair<size_t, size_t>> spans_; // elementary intervals [first, last) of each range
+        std::vector<uint64_t> counts_;                 // by elementary interval
+    };
+
+    /**
+     * @brief A named filter of a filters aggregation.
+     */
+    struct named_filter {
+        std::string name;
+        std::unique_ptr<postings::doc_set> docs; //!< Documents of the segment matching the filter.
+    };
+
+    /**
+     * @brief A bucket of a filters aggregation.
+     */
+    struct filter_bucket {
+        std::string name;
+        uint64_t doc_count = 0;
+
+        bool operator==(const filter_bucket &other) const = default;
+    };
+
+    /**
+     * @brief Counts the matching documents of a segment in named filters, e.g. "in stock" and "on sale".
+     *
+     * @details Hits arrive by increasing doc id, so every filter is a cursor only ever moved forward: all the
+     * filters are evaluated together in a single pass over the hits, each one seeking to the current hit.
+     */
+    class filters_collector : public collector::collector {
+      public:
+        /**
+         * @brief Construct a new collector.
+         *
+         * @param filters Named filters.
+         * @param other_bucket Name of the bucket of the hits matching no filter, if wanted.
+         */
+        explicit filters_collector(std::vector<named_filter> filters,
+                                   std::optional<std::string> other_bucket = std::nullopt);
+
+        void collect(DocId doc, Score score) override;
+
+        /**
+         * @brief The filters and their counts, then the other bucket if any.
+         */
+        [[nodiscard]] std::vector<filter_bucket> buckets() const;
+
+      private:
+        std::vector<named_filter> filters_;
+        std::vector<uint64_t> counts_;
+        std::optional<std::string> other_bucket_;
+        uint64_t other_count_ = 0;
+    };
+
+    /**
+     * @brief Adds the buckets of a segment to the buckets of the previous segments.
+     *
+     * @param into Buckets of the previous segments, in the order of the aggregation.
+     * @param other Buckets of a segment, in the same order.
+     */
+    void merge_buckets(std::vector<filter_bucket> &into, const std::vector<filter_bucket> &other);
+
+} // namespace bridge::aggregation
+
+#endif // BRIDGE_BUCKET_HPP_
@@ -0,0 +1,131 @@
+// Copyright (c) 2021 Bridge Project (Marcos Pontes)
+
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to
+//  deal in the Software without restriction, including without limitation the
+//  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+//  sell copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+//  IN THE SOFTWARE.
+
+//! \brief Composite aggregation: buckets of several fast-field keys, paged in key order.
+
+#ifndef BRIDGE_COMPOSITE_HPP_
+#define BRIDGE_COMPOSITE_HPP_
+
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+#include "bridge/collector/collector.hpp"
+#include "bridge/collector/top_docs.hpp"
+#include "bridge/fastfield/numeric_column.hpp"
+
+namespace bridge::aggregation {
+
+    /// @brief Key of a composite bucket: the value of each source, as stored in its column.
+    using composite_key = std::vector<uint64_t>;
+
+    /**
+     * @brief A value source of a composite aggregation, e.g. the tenant, the day or the status of a document.
+     */
+    struct composite_source {
+        const fastfield::numeric_column *column; //!< Fast field, or ordinals of a keyword field.
+        collector::sort_order order = collector::sort_order::Ascending;
+    };
+
+    /**
+     * @brief A bucket of a composite aggregation.
+     */
+    struct composite_bucket {
+        composite_key key;
+        uint64_t doc_count;
+
+        bool operator==(const composite_bucket &other) const = default;
+    };
+
+    /**
+     * @brief Groups the matching documents of a segment by a tuple of fast-field values.
+     *
+     * @details Buckets come in the order of their keys, source by source, and a page holds the `size` first
+     * buckets after an optional after key, the last key of the previous page. The whole set of buckets is
+     * never materialized: the collector keeps the `size` smallest keys in a max-heap whose root is the
+     * largest kept key, and a hash map from a key to its slot.
+     * - a key at or before the after key is skipped;
+     * - a kept key counts the document;
+     * - a new key takes a free slot, or evicts the root if it sorts before it.
+     *
+     * The root only decreases, so an evicted key never comes back and the counts of kept keys are exact.
+     * Segments are paged independently and merged with merge_composite_pages().
+     */
+    class composite_collector : public collector::collector {
+      public:
+        /**
+         * @brief Construct a new collector.
+         *
+         * @param sources Value sources. Their columns must outlive the collector.
+         * @param size Number of buckets of a page.
+         * @param after Last key of the previous page, if any.
+         */
+        composite_collector(std::vector<composite_source> sources, size_t size,
+                            std::optional<composite_key> after = std::nullopt);
+
+        void collect(DocId doc, Score score) override;
+
+        /**
+         * @brief The buckets of the page, in key order.
+         */
+        [[nodiscard]] std::vector<composite_bucket> buckets() const;
+
+      private:
+        struct key_hash {
+            size_t operator()(const composite_key &key) const;
+        };
+
+        [[nodiscard]] bool key_before(const composite_key &a, const composite_key &b) const;
+
+        std::vector<composite_source> sources_;
+        size_t size_;
+        std::optional<composite_key> after_;
+        composite_key scratch_;
+        std::vector<composite_bucket> slots_;
+        std::vector<size_t> heap_; // slots, as a max-heap on their keys
+        std::unordered_map<composite_key, size_t, key_hash> slot_of_key_;
+    };
+
+    /**
+     * @brief Merges the pages of every segment into the page of the index.
+     *
+     * @details A key of the global page has fewer than `size` smaller keys in any segment, so it is in the page
+     * of every segment holding it, and summing the segment pages gives its exact count.
+     *
+     * @param pages Page of each segment, computed with the same sources, size and after key.
+     * @param sources Value sources, for their order.
+     * @param size Number of buckets of a page.
+     * @return The page of the index, in key order.
+     */
+    std::vector<composite_bucket> merge_composite_pages(const std::vector<std::vector<composite_bucket>> &pages,
+                                                        const std::vector<composite_source> &sources, size_t size);
+
+    /**
+     * @brief After key for the next page.
+     *
+     * @param page A page of buckets.
+     * @param size Number of buckets of a page.
+     * @return The last key of the page, or nothing if this was the last page.
+     */
+    std::optional<composite_key> next_after_key(const std::vector<composite_bucket> &page, size_t size);
+
+} // namespace bridge::aggregation
+
+#endif // BRIDGE_COMPOSITE_HPP_
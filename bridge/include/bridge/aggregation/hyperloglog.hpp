@@ -0,0 +1,107 @@
+// Copyright (c) 2021 Bridge Project (Marcos Pontes)
+
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to
+//  deal in the Software without restriction, including without limitation the
+//  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+//  sell copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+//  IN THE SOFTWARE.
+
+//! \brief HyperLogLog sketch counting distinct values in bounded memory.
+
+#ifndef BRIDGE_HYPERLOGLOG_HPP_
+#define BRIDGE_HYPERLOGLOG_HPP_
+
+#include <bit>
+#include <cstdint>
+#include <vector>
+
+#include "bridge/global.hpp"
+
+namespace bridge::aggregation {
+
+    /// @brief Default precision of a HyperLogLog sketch: 2^14 registers, about 0.8% of standard error.
+    static constexpr uint8_t default_hll_precision = 14;
+
+    /**
+     * @brief Mergeable estimator of the number of distinct values.
+     *
+     * @details Follows HyperLogLog++ (Heule et al., 2013): values are hashed to 64 bits, so there is no large
+     * range correction, and small cardinalities are estimated with linear counting. The first p bits of a hash
+     * pick one of 2^p registers, which keeps the largest rank, i.e. position of the first set bit, of the
+     * remaining bits. The sketch takes 2^p bytes whatever the number of values. Two sketches of the same
+     * precision merge by taking the maximum of each register, so segments are counted independently and
+     * merged exactly as if their values had been counted together.
+     */
+    class hyperloglog {
+      public:
+        /**
+         * @brief Construct an empty sketch.
+         *
+         * @param precision Number of bits picking a register, between 4 and 18.
+         */
+        explicit hyperloglog(uint8_t precision = default_hll_precision);
+
+        /**
+         * @brief Counts a value.
+         */
+        void add(uint64_t value) { add_hash(mix(value)); }
+
+        /**
+         * @brief Counts a value already hashed to 64 well-mixed bits.
+         */
+        void add_hash(uint64_t hash) {
+            size_t index = hash >> (64 - precision_);
+            uint64_t rest = hash << precision_;
+            auto rank = static_cast<uint8_t>(rest == 0 ? 64 - precision_ + 1 : std::countl_zero(rest) + 1);
+            if (rank > registers_[index]) {
+                registers_[index] = rank;
+            }
+        }
+
+        /**
+         * @brief Adds the values counted by another sketch.
+         */
+        void merge(const hyperloglog &other);
+
+        /**
+         * @brief Estimated number of distinct values.
+         */
+        [[nodiscard]] uint64_t estimate() const;
+
+        /**
+         * @brief Precision of the sketch.
+         */
+        [[nodiscard]] uint8_t precision() const { return precision_; }
+
+        /**
+         * @brief 64 bits finalizer of MurmurHash3, spreading the bits of a value over the whole hash.
+         */
+        static constexpr uint64_t mix(uint64_t value) {
+            value ^= value >> 33;
+            value *= 0xFF51AFD7ED558CCDULL;
+            value ^= value >> 33;
+            value *= 0xC4CEB9FE1A85EC53ULL;
+            value ^= value >> 33;
+            return value;
+        }
+
+      private:
+        uint8_t precision_;
+        std::vector<uint8_t> registers_;
+    };
+
+} // namespace bridge::aggregation
+
+#endif // BRIDGE_HYPERLOGLOG_HPP_
@@ -0,0 +1,120 @@
+// Copyright (c) 2021 Bridge Project (Marcos Pontes)
+
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to
+//  deal in the Software without restriction, including without limitation the
+//  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+//  sell copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+//  IN THE SOFTWARE.
+
+//! \brief Cardinality and percentiles aggregations over fast fields, computed per segment and merged.
+
+#ifndef BRIDGE_METRICS_HPP_
+#define BRIDGE_METRICS_HPP_
+
+#include <future>
+#include <vector>
+
+#include "bridge/aggregation/hyperloglog.hpp"
+#include "bridge/aggregation/tdigest.hpp"
+#include "bridge/collector/collector.hpp"
+#include "bridge/error.hpp"
+#include "bridge/fastfield/numeric_column.hpp"
+
+namespace bridge::aggregation {
+
+    /**
+     * @brief Counts the distinct values of a fast field over the matching documents of a segment.
+     */
+    class cardinality_collector : public collector::collector {
+      public:
+        /**
+         * @brief Construct a new collector.
+         *
+         * @param column Fast field of the segment. It must outlive the collector.
+         * @param precision Precision of the sketch.
+         */
+        explicit cardinality_collector(const fastfield::numeric_column &column,
+                                       uint8_t precision = default_hll_precision)
+            : column_(&column), sketch_(precision) {}
+
+        void collect(DocId doc, Score) override { sketch_.add(column_->get_raw(doc)); }
+
+        /**
+         * @brief The sketch of the collected values.
+         */
+        [[nodiscard]] const hyperloglog &sketch() const { return sketch_; }
+
+      private:
+        const fastfield::numeric_column *column_;
+        hyperloglog sketch_;
+    };
+
+    /**
+     * @brief Estimates the percentiles of a fast field over the matching documents of a segment.
+     */
+    class percentiles_collector : public collector::collector {
+      public:
+        /**
+         * @brief Construct a new collector.
+         *
+         * @param column Fast field of the segment. It must outlive the collector.
+         * @param compression Compression of the digest.
+         */
+        explicit percentiles_collector(const fastfield::numeric_column &column,
+                                       double compression = default_tdigest_compression)
+            : column_(&column), sketch_(compression) {}
+
+        void collect(DocId doc, Score) override { sketch_.add(column_->get(doc)); }
+
+        /**
+         * @brief The digest of the collected values.
+         */
+        [[nodiscard]] const tdigest &sketch() const { return sketch_; }
+
+      private:
+        const fastfield::numeric_column *column_;
+        tdigest sketch_;
+    };
+
+    /**
+     * @brief Computes a sketch per segment in parallel and merges them.
+     *
+     * @details Each segment is aggregated on its own thread into its own sketch, so there is no shared state,
+     * and the memory is one bounded sketch per segment whatever the number of hits.
+     *
+     * @tparam Sketch hyperloglog or tdigest.
+     * @param num_segments Number of segments.
+     * @param per_segment Returns the sketch of a segment, given its index.
+     * @return The merged sketch.
+     */
+    template <typename Sketch, typename F> Sketch aggregate_segments(size_t num_segments, F &&per_segment) {
+        if (num_segments == 0) {
+            throw bridge_error("Nothing to aggregate");
+        }
+        std::vector<std::future<Sketch>> futures;
+        futures.reserve(num_segments);
+        for (size_t segment = 0; segment < num_segments; segment++) {
+            futures.push_back(std::async(std::launch::async, per_segment, segment));
+        }
+        Sketch merged = futures.front().get();
+        for (size_t segment = 1; segment < num_segments; segment++) {
+            merged.merge(futures[segment].get());
+        }
+        return merged;
+    }
+
+} // namespace bridge::aggregation
+
+#endif // BRIDGE_METRICS_HPP_
@@ -0,0 +1,124 @@
+// Copyright (c) 2021 Bridge Project (Marcos Pontes)
+
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to
+//  deal in the Software without restriction, including without limitation the
+//  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+//  sell copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+//  IN THE SOFTWARE.
+
+//! \brief t-digest sketch estimating quantiles in bounded memory.
+
+#ifndef BRIDGE_TDIGEST_HPP_
+#define BRIDGE_TDIGEST_HPP_
+
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include "bridge/global.hpp"
+
+namespace bridge::aggregation {
+
+    /// @brief Default compression of a t-digest: at most about 100 centroids, errors well below 1% at the tails.
+    static constexpr double default_tdigest_compression = 100.0;
+
+    /**
+     * @brief A cluster of values of a t-digest.
+     */
+    struct centroid {
+        double mean;
+        double weight;
+
+        bool operator==(const centroid &other) const = default;
+    };
+
+    /**
+     * @brief Mergeable estimator of quantiles.
+     *
+     * @details Implements the merging t-digest (Dunning, 2019). Values are buffered, then sorted and merged
+     * with the centroids in a single pass, each centroid growing as long as it spans less than one unit of the
+     * k1 scale function k(q) = compression / (2 pi) * asin(2q - 1). The scale is flat in the middle and steep
+     * at the tails, so centroids are small, and quantiles accurate, near 0 and 1. The number of centroids is
+     * bounded by the compression, whatever the number of values, and two digests merge by merging their
+     * centroids the same way.
+     *
+     * Queries compress the pending values first, so a digest is not thread safe, even for reading.
+     */
+    class tdigest {
+      public:
+        /**
+         * @brief Construct an empty digest.
+         *
+         * @param compression Accuracy of the digest, which also bounds its number of centroids.
+         */
+        explicit tdigest(double compression = default_tdigest_compression);
+
+        /**
+         * @brief Adds a value.
+         *
+         * @param value Value. NaN is ignored.
+         * @param weight Number of occurrences of the value.
+         */
+        void add(double value, double weight = 1.0);
+
+        /**
+         * @brief Adds the values of another digest.
+         */
+        void merge(const tdigest &other);
+
+        /**
+         * @brief Estimated quantile.
+         *
+         * @param q Quantile, between 0 and 1.
+         * @return The estimated value, NaN for an empty digest.
+         */
+        [[nodiscard]] double quantile(double q) const;
+
+        /**
+         * @brief Number of values.
+         */
+        [[nodiscard]] double count() const { return total_weight_ + buffered_weight_; }
+
+        /**
+         * @brief Smallest value.
+         */
+        [[nodiscard]] double min() const { return min_; }
+
+        /**
+         * @brief Largest value.
+         */
+        [[nodiscard]] double max() const { return max_; }
+
+        /**
+         * @brief The centroids, by increasing mean.
+         */
+        [[nodiscard]] const std::vector<centroid> &centroids() const;
+
+      private:
+        void compress() const;
+
+        double compression_;
+        size_t buffer_limit_;
+        double min_ = std::numeric_limits<double>::infinity();
+        double max_ = -std::numeric_limits<double>::infinity();
+        mutable std::vector<centroid> centroids_;
+        mutable std::vector<centroid> buffer_;
+        mutable double total_weight_ = 0.0;
+        mutable double buffered_weight_ = 0.0;
+    };
+
+} // namespace bridge::aggregation
+
+#endif // BRIDGE_TDIGEST_HPP_
@@ -21,9 +21,18 @@
 #ifndef BRIDGE_HPP_
 #define BRIDGE_HPP_
 
+#include "bridge/aggregation.hpp"
 #include "bridge/analyzer/analyzer.hpp"
 #include "bridge/schema.hpp"
+#include "bridge/collector.hpp"
 #include "bridge/directory.hpp"
+#include "bridge/fastfield.hpp"
+#include "bridge/index.hpp"
+#include "bridge/ltr.hpp"
+#include "bridge/postings.hpp"
+#include "bridge/query.hpp"
+#include "bridge/scoring.hpp"
+#include "bridge/suggest.hpp"
 #include "bridge/global.hpp"
 
 #endif // BRIDGE_HPP_
\ No newline at end of file
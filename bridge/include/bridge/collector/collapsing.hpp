@@ -0,0 +1,93 @@
+// Copyright (c) 2021 Bridge Project (Marcos Pontes)
+
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to
+//  deal in the Software without restriction, including without limitation the
+//  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+//  sell copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+//  IN THE SOFTWARE.
+
+//! \brief Collector keeping the best hit of each group, e.g. of each product.
+
+#ifndef BRIDGE_COLLAPSING_HPP_
+#define BRIDGE_COLLAPSING_HPP_
+
+#include <unordered_map>
+#include <vector>
+
+#include "bridge/collector/collector.hpp"
+#include "bridge/fastfield/numeric_column.hpp"
+
+namespace bridge::collector {
+
+    /**
+     * @brief The best hit of a group.
+     */
+    struct group_hit {
+        DocId doc;
+        Score score;
+        uint64_t group; //!< Value of the collapsing field, as stored in its column.
+
+        bool operator==(const group_hit &other) const = default;
+    };
+
+    /**
+     * @brief Keeps the k best groups, a group being ranked by its best hit.
+     *
+     * @details Collapsing happens while collecting, so a page always holds k distinct groups without fetching
+     * more hits than needed. The collector keeps a min-heap of group slots, whose root is the worst kept group,
+     * and a hash map from a group to its slot:
+     * - a hit of a kept group replaces the best hit of its slot if it ranks before it, and the slot moves down
+     *   the heap;
+     * - a hit of a new group takes a free slot, or evicts the root if it ranks before it.
+     *
+     * An evicted group ranked below k other groups, so its later hits are treated as a new group safely.
+     */
+    class collapsing_collector : public collector {
+      public:
+        /**
+         * @brief Construct a new collector.
+         *
+         * @param k Number of groups to keep.
+         * @param groups Collapsing field. It must outlive the collector.
+         */
+        collapsing_collector(size_t k, const fastfield::numeric_column &groups);
+
+        void collect(DocId doc, Score score) override;
+
+        /**
+         * @brief The best hit of each kept group, best first.
+         */
+        [[nodiscard]] std::vector<group_hit> hits() const;
+
+      private:
+        [[nodiscard]] bool slot_before(size_t a, size_t b) const;
+
+        void swap_heap(size_t i, size_t j);
+
+        void sift_down(size_t i);
+
+        void sift_up(size_t i);
+
+        size_t k_;
+        const fastfield::numeric_column *groups_;
+        std::vector<group_hit> slots_;
+        std::vector<size_t> heap_;       // slots, as a min-heap
+        std::vector<size_t> heap_index_; // position of each slot in the heap
+        std::unordered_map<uint64_t, size_t> slot_of_group_;
+    };
+
+} // namespace bridge::collector
+
+#endif // BRIDGE_COLLAPSING_HPP_
@@ -0,0 +1,78 @@
+// Copyright (c) 2021 Bridge Project (Marcos Pontes)
+
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to
+//  deal in the Software without restriction, including without limitation the
+//  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+//  sell copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+//  IN THE SOFTWARE.
+
+//! \brief Collectors receive the matching documents of a query and keep what the caller needs.
+
+#ifndef BRIDGE_COLLECTOR_HPP_
+#define BRIDGE_COLLECTOR_HPP_
+
+#include "bridge/global.hpp"
+#include "bridge/query/scorer.hpp"
+
+namespace bridge::collector {
+
+    /**
+     * @brief A matching document and its score.
+     */
+    struct hit {
+        DocId doc;
+        Score score;
+
+        bool operator==(const hit &other) const = default;
+    };
+
+    /**
+     * @brief Order of the hits in a result page: by decreasing score, ties broken by doc id.
+     */
+    constexpr bool ranks_before(const hit &a, const hit &b) {
+        return a.score != b.score ? a.score > b.score : a.doc < b.doc;
+    }
+
+    /**
+     * @brief Receives the matching documents of a query, by increasing doc id.
+     */
+    class collector {
+      public:
+        /**
+         * @brief Virtual destructor for collector.
+         */
+        virtual ~collector() = default;
+
+        /**
+         * @brief Collects a matching document.
+         *
+         * @param doc Document.
+         * @param score Score of the document.
+         */
+        virtual void collect(DocId doc, Score score) = 0;
+    };
+
+    /**
+     * @brief Feeds every document of a scorer to a collector.
+     */
+    inline void collect_all(query::scorer &scorer, collector &collector) {
+        for (DocId doc = scorer.doc(); doc != postings::TERMINATED; doc = scorer.advance()) {
+            collector.collect(doc, scorer.score());
+        }
+    }
+
+} // namespace bridge::collector
+
+#endif // BRIDGE_COLLECTOR_HPP_
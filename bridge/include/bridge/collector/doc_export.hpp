@@ -0,0 +1,84 @@
+// Copyright (c) 2021 Bridge Project (Marcos Pontes)
+
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to
+//  deal in the Software without restriction, including without limitation the
+//  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+//  sell copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+//  IN THE SOFTWARE.
+
+//! \brief Streaming export of every matching document, in doc id order.
+
+#ifndef BRIDGE_DOC_EXPORT_HPP_
+#define BRIDGE_DOC_EXPORT_HPP_
+
+#include <functional>
+#include <ostream>
+#include <span>
+#include <vector>
+
+#include "bridge/fastfield/numeric_column.hpp"
+#include "bridge/global.hpp"
+#include "bridge/postings/doc_set.hpp"
+
+namespace bridge::collector {
+
+    /**
+     * @brief A block of exported documents and their fast field values.
+     * @details values[c][i] is the sortable value of docs[i] in the c-th column. The spans are only valid
+     * during the callback.
+     */
+    struct export_block {
+        std::span<const DocId> docs;
+        std::vector<std::span<const uint64_t>> values;
+    };
+
+    /// @brief Receives the exported documents, block by block.
+    using export_callback = std::function<void(const export_block &)>;
+
+    /// @brief Default number of documents of an export block.
+    static constexpr size_t default_export_block_size = 4096;
+
+    /**
+     * @brief Streams every document of a doc set with its fast field values.
+     *
+     * @details Documents are read in doc id order, without scoring nor ranking, so an export is a single
+     * forward pass over the postings and the columns. The columns are advised for sequential access during
+     * the pass and restored to normal access afterwards.
+     *
+     * @param docs Matching documents. The doc set is consumed.
+     * @param columns Columns to export.
+     * @param callback Receives the blocks.
+     * @param block_size Number of documents of a block.
+     * @return Number of exported documents.
+     */
+    uint64_t export_docs(postings::doc_set &docs, const std::vector<const fastfield::numeric_column *> &columns,
+                         const export_callback &callback, size_t block_size = default_export_block_size);
+
+    /**
+     * @brief Writes every document of a doc set as tab separated values.
+     *
+     * @details Each line is a doc id followed by the decoded value of every column.
+     *
+     * @param docs Matching documents. The doc set is consumed.
+     * @param columns Columns to export.
+     * @param os Output stream.
+     * @return Number of exported documents.
+     */
+    uint64_t export_tsv(postings::doc_set &docs, const std::vector<const fastfield::numeric_column *> &columns,
+                        std::ostream &os);
+
+} // namespace bridge::collector
+
+#endif // BRIDGE_DOC_EXPORT_HPP_
@@ -0,0 +1,119 @@
+// Copyright (c) 2021 Bridge Project (Marcos Pontes)
+
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to
+//  deal in the Software without restriction, including without limitation the
+//  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+//  sell copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+//  IN THE SOFTWARE.
+
+//! \brief Collectors of the best documents, by score or by the value of a fast field.
+
+#ifndef BRIDGE_TOP_DOCS_HPP_
+#define BRIDGE_TOP_DOCS_HPP_
+
+#include <optional>
+#include <vector>
+
+#include "bridge/collector/collector.hpp"
+#include "bridge/fastfield/numeric_column.hpp"
+
+namespace bridge::collector {
+
+    /**
+     * @brief Keeps the k best hits in a min-heap whose root is the worst kept hit.
+     *
+     * @details For deep paging, the last hit of the previous page can be passed as a search-after key: every
+     * hit ranking before it or equal to it is skipped, so each page costs the same as the first one.
+     */
+    class top_docs_collector : public collector {
+      public:
+        /**
+         * @brief Construct a new collector.
+         *
+         * @param k Number of hits to keep.
+         * @param after Last hit of the previous page, if any.
+         */
+        explicit top_docs_collector(size_t k, std::optional<hit> after = std::nullopt);
+
+        void collect(DocId doc, Score score) override;
+
+        /**
+         * @brief The kept hits, best first.
+         */
+        [[nodiscard]] std::vector<hit> hits() const;
+
+      private:
+        size_t k_;
+        std::optional<hit> after_;
+        std::vector<hit> heap_;
+    };
+
+    /**
+     * @brief Direction of a sort.
+     */
+    enum class sort_order : uint8_t { Ascending, Descending };
+
+    /**
+     * @brief A hit and its sort value.
+     */
+    struct field_hit {
+        DocId doc;
+        uint64_t value; //!< Value of the sort field, as stored in its column.
+
+        bool operator==(const field_hit &other) const = default;
+    };
+
+    /**
+     * @brief Keeps the k first hits sorted by a fast field, ties broken by doc id.
+     * @details Supports a search-after key like top_docs_collector.
+     */
+    class top_field_collector : public collector {
+      public:
+        /**
+         * @brief Construct a new collector.
+         *
+         * @param k Number of hits to keep.
+         * @param field Sort field. It must outlive the collector.
+         * @param order Direction of the sort.
+         * @param after Last hit of the previous page, if any.
+         */
+        top_field_collector(size_t k, const fastfield::numeric_column &field, sort_order order,
+                            std::optional<field_hit> after = std::nullopt);
+
+        void collect(DocId doc, Score score) override;
+
+        /**
+         * @brief The kept hits, in sort order.
+         */
+        [[nodiscard]] std::vector<field_hit> hits() const;
+
+      private:
+        [[nodiscard]] bool sorts_before(const field_hit &a, const field_hit &b) const {
+            if (a.value != b.value) {
+                return (order_ == sort_order::Ascending) == (a.value < b.value);
+            }
+            return a.doc < b.doc;
+        }
+
+        size_t k_;
+        const fastfield::numeric_column *field_;
+        sort_order order_;
+        std::optional<field_hit> after_;
+        std::vector<field_hit> heap_;
+    };
+
+} // namespace bridge::collector
+
+#endif // BRIDGE_TOP_DOCS_HPP_
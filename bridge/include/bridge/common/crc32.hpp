@@ -0,0 +1,69 @@
+// Copyright (c) 2021 Bridge Project (Marcos Pontes)
+
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to
+//  deal in the Software without restriction, including without limitation the
+//  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+//  sell copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+//  IN THE SOFTWARE.
+
+//! \brief CRC-32 checksums used to detect torn or corrupted records.
+
+#ifndef BRIDGE_CRC32_HPP_
+#define BRIDGE_CRC32_HPP_
+
+#include <array>
+#include <cstdint>
+
+#include "bridge/global.hpp"
+
+namespace bridge::common {
+
+    namespace detail {
+
+        constexpr std::array<uint32_t, 256> make_crc32_table() {
+            std::array<uint32_t, 256> table{};
+            for (uint32_t i = 0; i < 256; i++) {
+                uint32_t c = i;
+                for (int k = 0; k < 8; k++) {
+                    c = (c & 1) != 0 ? 0xEDB88320U ^ (c >> 1) : c >> 1;
+                }
+                table[i] = c;
+            }
+            return table;
+        }
+
+        inline constexpr std::array<uint32_t, 256> crc32_table = make_crc32_table();
+
+    } // namespace detail
+
+    /**
+     * @brief CRC-32 (IEEE 802.3) of a byte range.
+     *
+     * @param data Bytes to checksum.
+     * @param size Number of bytes.
+     * @param crc Checksum of the preceding bytes, to checksum a range in several calls.
+     * @return The checksum.
+     */
+    inline uint32_t crc32(const bridge::byte_t *data, size_t size, uint32_t crc = 0) {
+        crc = ~crc;
+        for (size_t i = 0; i < size; i++) {
+            crc = detail::crc32_table[(crc ^ static_cast<uint8_t>(data[i])) & 0xFF] ^ (crc >> 8);
+        }
+        return ~crc;
+    }
+
+} // namespace bridge::common
+
+#endif // BRIDGE_CRC32_HPP_
@@ -0,0 +1,134 @@
+// Copyright (c) 2021 Bridge Project (Marcos Pontes)
+
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to
+//  deal in the Software without restriction, including without limitation the
+//  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+//  sell copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+//  IN THE SOFTWARE.
+
+//! \brief Variable-length integer encoding used by the on-disk formats.
+
+#ifndef BRIDGE_VINT_HPP_
+#define BRIDGE_VINT_HPP_
+
+#include <concepts>
+#include <cstdint>
+#include <ostream>
+#include <vector>
+
+#include "bridge/error.hpp"
+#include "bridge/global.hpp"
+
+namespace bridge::common {
+
+    /**
+     * @brief Appends an unsigned integer using LEB128 encoding (7 bits per byte, high bit as continuation).
+     *
+     * @param out Output byte buffer.
+     * @param value Value to be encoded.
+     * @return Number of bytes written.
+     */
+    inline size_t write_vint(std::vector<bridge::byte_t> &out, uint64_t value) {
+        size_t written = 0;
+        while (value >= 0x80) {
+            out.push_back(static_cast<bridge::byte_t>((value & 0x7F) | 0x80));
+            value >>= 7;
+            written++;
+        }
+        out.push_back(static_cast<bridge::byte_t>(value));
+        return written + 1;
+    }
+
+    /**
+     * @brief Writes an unsigned integer using LEB128 encoding to an output stream.
+     *
+     * @param os Output stream.
+     * @param value Value to be encoded.
+     * @return Number of bytes written.
+     */
+    inline size_t write_vint(std::ostream &os, uint64_t value) {
+        std::vector<bridge::byte_t> buffer;
+        size_t written = write_vint(buffer, value);
+        os.write(buffer.data(), static_cast<std::streamsize>(written));
+        return written;
+    }
+
+    /**
+     * @brief Reads a LEB128 encoded unsigned integer.
+     *
+     * @param data Pointer to the encoded bytes. It is advanced past the value.
+     * @param end End of the readable region.
+     * @return The decoded value.
+     */
+    inline uint64_t read_vint(const bridge::byte_t *&data, const bridge::byte_t *end) {
+        uint64_t value = 0;
+        unsigned shift = 0;
+        while (data < end) {
+            auto byte = static_cast<uint8_t>(*data++);
+            value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+            if ((byte & 0x80) == 0) {
+                return value;
+            }
+            shift += 7;
+            if (shift >= 64) {
+                break;
+            }
+        }
+        throw bridge_error("Corrupted variable-length integer");
+    }
+
+    /**
+     * @brief Writes a fixed-size little endian integer.
+     *
+     * @param os Output stream.
+     * @param value Value to be written.
+     */
+    template <std::unsigned_integral T> void write_fixed(std::ostream &os, T value) {
+        bridge::byte_t buffer[sizeof(T)];
+        for (size_t i = 0; i < sizeof(T); i++) {
+            buffer[i] = static_cast<bridge::byte_t>(value >> (8 * i));
+        }
+        os.write(buffer, sizeof(T));
+    }
+
+    /**
+     * @brief Appends a fixed-size little endian integer.
+     *
+     * @param out Output byte buffer.
+     * @param value Value to be written.
+     */
+    template <std::unsigned_integral T> void write_fixed(std::vector<bridge::byte_t> &out, T value) {
+        for (size_t i = 0; i < sizeof(T); i++) {
+            out.push_back(static_cast<bridge::byte_t>(value >> (8 * i)));
+        }
+    }
+
+    /**
+     * @brief Reads a fixed-size little endian integer.
+     *
+     * @param data Pointer to the first byte of the integer.
+     * @return The decoded value.
+     */
+    template <std::unsigned_integral T> T read_fixed(const bridge::byte_t *data) {
+        T value = 0;
+        for (size_t i = 0; i < sizeof(T); i++) {
+            value |= static_cast<T>(static_cast<uint8_t>(data[i])) << (8 * i);
+        }
+        return value;
+    }
+
+} // namespace bridge::common
+
+#endif // BRIDGE_VINT_HPP_
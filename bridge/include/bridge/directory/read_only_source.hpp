@@ -30,8 +30,18 @@
 
 #include <mio/shared_mmap.hpp>
 
+#ifndef _WIN32
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
 namespace bridge::directory {
 
+    /**
+     * @brief Expected access pattern of a source, used to tune the read-ahead of the OS.
+     */
+    enum class access_pattern : uint8_t { Normal, Sequential, Random };
+
     /**
      * @brief Read object that represents files in bridge
      * @details These objects are only in charge to deliver the data
@@ -67,6 +77,11 @@ namespace bridge::directory {
          * @brief Creates a read_only_source that is just a view over a slice of the data.
          */
         [[nodiscard]] virtual std::unique_ptr<read_only_source> slice(size_t from_offset, size_t to_offset) const = 0;
+
+        /**
+         * @brief Hints how the source is about to be read. It is only a hint and may be ignored.
+         */
+        virtual void advise(access_pattern) const {}
     };
 
     class mmap_source : public read_only_source {
@@ -134,6 +149,28 @@ namespace bridge::directory {
             return std::make_unique<mmap_source>(path_, from_offset, to_offset);
         }
 
+        /**
+         * @brief Hints how the source is about to be read, with madvise().
+         */
+        void advise(access_pattern pattern) const override {
+#ifndef _WIN32
+            if (mmap_->size() == 0) {
+                return;
+            }
+            // madvise works on whole pages
+            auto page_size = static_cast<uintptr_t>(sysconf(_SC_PAGESIZE));
+            auto begin = reinterpret_cast<uintptr_t>(mmap_->data());
+            uintptr_t aligned = begin & ~(page_size - 1);
+            int advice = pattern == access_pattern::Sequential ? MADV_SEQUENTIAL
+                         : pattern == access_pattern::Random   ? MADV_RANDOM
+                                                               : MADV_NORMAL;
+            // NOLINTNEXTLINE(performance-no-int-to-ptr)
+            madvise(reinterpret_cast<void *>(aligned), mmap_->size() + (begin - aligned), advice);
+#else
+            (void)pattern;
+#endif
+        }
+
       private:
         std::unique_ptr<mio::shared_mmap_source> mmap_;
         std::string path_;
@@ -21,6 +21,9 @@
 #ifndef BRIDGE_ERROR_HPP_
 #define BRIDGE_ERROR_HPP_
 
+#include <stdexcept>
+#include <string>
+
 namespace bridge {
 
     /**
@@ -0,0 +1,201 @@
+// Copyright (c) 2021 Bridge Project (Marcos Pontes)
+
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to
+//  deal in the Software without restriction, including without limitation the
+//  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+//  sell copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+//  IN THE SOFTWARE.
+
+//! \brief Columnar storage of numeric fast fields.
+
+#ifndef BRIDGE_NUMERIC_COLUMN_HPP_
+#define BRIDGE_NUMERIC_COLUMN_HPP_
+
+#include <bit>
+#include <memory>
+#include <ostream>
+#include <vector>
+
+#include "bridge/common/vint.hpp"
+#include "bridge/directory/directory.hpp"
+#include "bridge/global.hpp"
+
+namespace bridge::fastfield {
+
+    /**
+     * @brief Type of the values of a numeric column.
+     */
+    enum class numeric_kind : uint8_t { U64 = 0, I64 = 1, F64 = 2 };
+
+    /// @brief Maps a signed integer to an unsigned one with the same order.
+    constexpr uint64_t to_sortable(int64_t value) { return static_cast<uint64_t>(value) ^ (1ULL << 63); }
+
+    /// @brief Maps a double to an unsigned integer with the same order.
+    constexpr uint64_t to_sortable(double value) {
+        auto bits = std::bit_cast<uint64_t>(value);
+        return (bits >> 63) != 0 ? ~bits : bits ^ (1ULL << 63);
+    }
+
+    /// @brief Inverse of to_sortable(int64_t).
+    constexpr int64_t i64_from_sortable(uint64_t value) { return static_cast<int64_t>(value ^ (1ULL << 63)); }
+
+    /// @brief Inverse of to_sortable(double).
+    constexpr double f64_from_sortable(uint64_t value) {
+        return std::bit_cast<double>((value >> 63) != 0 ? value ^ (1ULL << 63) : ~value);
+    }
+
+    /**
+     * @brief Dense column holding one numeric value per document.
+     *
+     * @details Values are mapped to order-preserving unsigned integers, shifted by the minimum of the column and
+     * bit packed with the smallest width that fits the maximum. Random access is a couple of shifts, and the
+     * minimum and maximum of the column come for free.
+     *
+     * The serialized format is the kind (1 byte), the number of documents (u32), the minimum and maximum (u64),
+     * the bit width (1 byte) and the packed 64 bits words, all little-endian. A column opened from a source
+     * reads its words in place, so a memory-mapped column is never copied.
+     */
+    class numeric_column {
+      public:
+        /**
+         * @brief Construct an empty column.
+         */
+        numeric_column() = default;
+
+        static numeric_column build(const std::vector<uint64_t> &values);
+
+        static numeric_column build(const std::vector<int64_t> &values);
+
+        static numeric_column build(const std::vector<double> &values);
+
+        /**
+         * @brief Get the sortable representation of the value of a document.
+         */
+        [[nodiscard]] uint64_t get_raw(DocId doc) const {
+            if (num_bits_ == 0) {
+                return min_;
+            }
+            uint64_t bit = static_cast<uint64_t>(doc) * num_bits_;
+            uint64_t word = bit >> 6;
+            uint64_t shift = bit & 63;
+            uint64_t value = read_word(word) >> shift;
+            if (shift + num_bits_ > 64) {
+                value |= read_word(word + 1) << (64 - shift);
+            }
+            return min_ + (value & mask_);
+        }
+
+        /**
+         * @brief Get the value of a document, converted to a double.
+         */
+        [[nodiscard]] double get(DocId doc) const { return decode(get_raw(doc)); }
+
+        /**
+         * @brief Get the values of several documents, converted to doubles.
+         *
+         * @param docs Documents.
+         * @param count Number of documents.
+         * @param out Values of the documents.
+         */
+        void get_many(const DocId *docs, size_t count, double *out) const;
+
+        [[nodiscard]] numeric_kind kind() const { return kind_; }
+
+        [[nodiscard]] uint32_t num_docs() const { return num_docs_; }
+
+        [[nodiscard]] uint8_t num_bits() const { return num_bits_; }
+
+        /**
+         * @brief Smallest value of the column, as a sortable integer.
+         */
+        [[nodiscard]] uint64_t min_raw() const { return min_; }
+
+        /**
+         * @brief Largest value of the column, as a sortable integer.
+         */
+        [[nodiscard]] uint64_t max_raw() const { return max_; }
+
+        /**
+         * @brief Converts a sortable integer of the column to a double.
+         */
+        [[nodiscard]] double decode(uint64_t raw) const {
+            switch (kind_) {
+            case numeric_kind::I64:
+                return static_cast<double>(i64_from_sortable(raw));
+            case numeric_kind::F64:
+                return f64_from_sortable(raw);
+            default:
+                return static_cast<double>(raw);
+            }
+        }
+
+        /**
+         * @brief Writes the column.
+         *
+         * @param os Output stream.
+         * @return Number of bytes written.
+         */
+        uint64_t serialize(std::ostream &os) const;
+
+        /**
+         * @brief Reads a column.
+         *
+         * @param data Pointer to the serialized column. It is advanced past the column.
+         * @param end End of the readable region.
+         * @return The column.
+         */
+        static numeric_column deserialize(const bridge::byte_t *&data, const bridge::byte_t *end);
+
+        /**
+         * @brief Opens a column in place, without copying its values.
+         *
+         * @param source Source holding a serialized column. It is kept alive by the column.
+         * @return The column.
+         */
+        static numeric_column open(std::shared_ptr<directory::read_only_source> source);
+
+        /**
+         * @brief Hints how the column is about to be read, if it is backed by a source.
+         */
+        void advise(directory::access_pattern pattern) const {
+            if (source_) {
+                source_->advise(pattern);
+            }
+        }
+
+      private:
+        static numeric_column pack(numeric_kind kind, const std::vector<uint64_t> &sortable);
+
+        /// @brief Parses the header, returning the size of the packed words.
+        size_t read_header(const bridge::byte_t *&data, const bridge::byte_t *end);
+
+        [[nodiscard]] uint64_t read_word(uint64_t word) const {
+            return common::read_fixed<uint64_t>(packed_ + word * sizeof(uint64_t));
+        }
+
+        numeric_kind kind_ = numeric_kind::U64;
+        uint32_t num_docs_ = 0;
+        uint64_t min_ = 0;
+        uint64_t max_ = 0;
+        uint8_t num_bits_ = 0;
+        uint64_t mask_ = 0;
+        const bridge::byte_t *packed_ = nullptr;
+        std::shared_ptr<const std::vector<bridge::byte_t>> owned_; // packed words of a column built in memory
+        std::shared_ptr<directory::read_only_source> source_;     // source of a column opened in place
+    };
+
+} // namespace bridge::fastfield
+
+#endif // BRIDGE_NUMERIC_COLUMN_HPP_
@@ -36,6 +36,9 @@ namespace bridge {
     // At most, a segment can contain 2^31 documents.
     using DocId = uint32_t;
 
+    //! \brief Relevance score of a document.
+    using Score = float;
+
 }; // namespace bridge
 
 #endif // GLOBAL_HPP_
\ No newline at end of file
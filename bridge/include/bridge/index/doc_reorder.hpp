@@ -0,0 +1,82 @@
+// Copyright (c) 2021 Bridge Project (Marcos Pontes)
+
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to
+//  deal in the Software without restriction, including without limitation the
+//  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+//  sell copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+//  IN THE SOFTWARE.
+
+//! \brief Doc id reordering by recursive graph bisection.
+
+#ifndef BRIDGE_DOC_REORDER_HPP_
+#define BRIDGE_DOC_REORDER_HPP_
+
+#include <vector>
+
+#include "bridge/global.hpp"
+
+namespace bridge::index {
+
+    /// @brief Forward index of a segment: the sorted term ordinals of each document.
+    using forward_index = std::vector<std::vector<uint32_t>>;
+
+    /**
+     * @brief Tuning of the recursive graph bisection.
+     */
+    struct bisection_options {
+        uint32_t iterations = 20;         //!< Maximum swap rounds per bisection.
+        uint32_t max_depth = 0;           //!< Maximum recursion depth, 0 means until min_partition_size.
+        uint32_t min_partition_size = 16; //!< Partitions smaller than this are left untouched.
+    };
+
+    /**
+     * @brief Reorders the documents of a segment so that similar documents get nearby ids.
+     *
+     * @details Implements the recursive graph bisection of Dhulipala et al. (KDD 2016): documents are split in
+     * two halves, then pairs of documents are swapped between the halves while it reduces the estimated
+     * log-gap cost of the postings, and both halves are bisected recursively. Shorter gaps mean smaller
+     * postings and faster decoding.
+     *
+     * It is meant for offline use on static segments, before their postings are written.
+     *
+     * @param docs Forward index of the segment.
+     * @param num_terms Number of distinct terms, i.e. one plus the largest term ordinal.
+     * @param options Tuning of the bisection.
+     * @return The new order: the i-th element is the old doc id of the document that gets the id i.
+     */
+    std::vector<DocId> recursive_graph_bisection(const forward_index &docs, uint32_t num_terms,
+                                                 const bisection_options &options = {});
+
+    /**
+     * @brief Inverts an order returned by recursive_graph_bisection.
+     *
+     * @param order New order of the documents.
+     * @return The mapping from old doc ids to new doc ids.
+     */
+    std::vector<DocId> to_new_doc_ids(const std::vector<DocId> &order);
+
+    /**
+     * @brief Estimates the size of the postings of a segment under a given order.
+     *
+     * @param docs Forward index of the segment.
+     * @param num_terms Number of distinct terms.
+     * @param order Order of the documents.
+     * @return The sum over every posting of log2(doc id gap + 1), in bits.
+     */
+    double log_gap_cost(const forward_index &docs, uint32_t num_terms, const std::vector<DocId> &order);
+
+} // namespace bridge::index
+
+#endif // BRIDGE_DOC_REORDER_HPP_
@@ -0,0 +1,153 @@
+// Copyright (c) 2021 Bridge Project (Marcos Pontes)
+
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to
+//  deal in the Software without restriction, including without limitation the
+//  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+//  sell copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+//  IN THE SOFTWARE.
+
+//! \brief Near-duplicate detection with SimHash signatures and banded locality sensitive hashing.
+
+#ifndef BRIDGE_NEAR_DUPLICATES_HPP_
+#define BRIDGE_NEAR_DUPLICATES_HPP_
+
+#include <bit>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "bridge/fastfield/numeric_column.hpp"
+#include "bridge/global.hpp"
+
+namespace bridge::index {
+
+    /// @brief Default number of tokens of a shingle.
+    static constexpr size_t default_shingle_size = 2;
+
+    /**
+     * @brief SimHash of a sequence of tokens.
+     *
+     * @details Every shingle, i.e. run of shingle_size consecutive tokens, is hashed to 64 bits. Bit i of the
+     * signature is set when more shingles have bit i set than unset. Documents sharing most of their shingles
+     * get signatures at a small Hamming distance.
+     *
+     * @param tokens Tokens of the document.
+     * @param shingle_size Number of tokens of a shingle.
+     * @return The signature, 0 for an empty document.
+     */
+    uint64_t simhash(const std::vector<std::string> &tokens, size_t shingle_size = default_shingle_size);
+
+    /**
+     * @brief SimHash of a text, split into lowercase alphanumeric tokens.
+     */
+    uint64_t simhash_text(const std::string &text, size_t shingle_size = default_shingle_size);
+
+    /**
+     * @brief Number of differing bits of two signatures.
+     */
+    inline uint32_t hamming_distance(uint64_t a, uint64_t b) { return static_cast<uint32_t>(std::popcount(a ^ b)); }
+
+    /**
+     * @brief Index-time near-duplicate detector.
+     *
+     * @details Signatures are split in num_bands bands of 64 / num_bands bits, and each band is a key of its own
+     * hash table. Two signatures at a distance smaller than num_bands differ in fewer bands than there are, so
+     * they share at least one band: probing the num_bands tables finds every near duplicate, and only the few
+     * candidates sharing a band are compared bit by bit. The tables hold each distinct signature once, with
+     * the documents having it, so that exact duplicates, e.g. the 0 signature of every empty text, cost a
+     * single comparison however many of them there are.
+     *
+     * Each document gets a cluster, the doc id of the first document it is a near duplicate of, or its own doc
+     * id. The signature and cluster columns are stored as fast fields: collapsing hits on the cluster column
+     * with a collapsing_collector shows a single document per near-duplicate cluster.
+     */
+    class near_duplicate_detector {
+      public:
+        /**
+         * @brief Construct a new detector.
+         *
+         * @param max_distance Largest Hamming distance of near duplicates.
+         * @param num_bands Number of bands, a divisor of 64 larger than max_distance.
+         */
+        explicit near_duplicate_detector(uint32_t max_distance = 3, uint32_t num_bands = 4);
+
+        /**
+         * @brief Finds the first indexed near duplicate of a signature.
+         * @details At ingest, a document with a near duplicate may be dropped rather than added.
+         */
+        [[nodiscard]] std::optional<DocId> find(uint64_t signature) const;
+
+        /**
+         * @brief Every indexed near duplicate of a signature.
+         *
+         * @return The doc ids, increasing.
+         */
+        [[nodiscard]] std::vector<DocId> near_duplicates(uint64_t signature) const;
+
+        /**
+         * @brief Adds the next document.
+         *
+         * @param signature SimHash of the document.
+         * @return The cluster of the document.
+         */
+        DocId add(uint64_t signature);
+
+        /**
+         * @brief Number of documents.
+         */
+        [[nodiscard]] size_t num_docs() const { return signatures_.size(); }
+
+        /**
+         * @brief Number of distinct signatures.
+         */
+        [[nodiscard]] size_t num_distinct_signatures() const { return distinct_docs_.size(); }
+
+        /**
+         * @brief Cluster of a document.
+         */
+        [[nodiscard]] DocId cluster(DocId doc) const { return clusters_.at(doc); }
+
+        /**
+         * @brief Fast field of the signatures, by doc id.
+         */
+        [[nodiscard]] fastfield::numeric_column signature_column() const;
+
+        /**
+         * @brief Fast field of the clusters, by doc id.
+         */
+        [[nodiscard]] fastfield::numeric_column cluster_column() const;
+
+      private:
+        [[nodiscard]] uint64_t band(uint64_t signature, uint32_t b) const {
+            return band_bits_ == 64 ? signature : (signature >> (b * band_bits_)) & ((1ULL << band_bits_) - 1);
+        }
+
+        template <typename F> void for_each_candidate(uint64_t signature, F &&f) const;
+
+        uint32_t max_distance_;
+        uint32_t num_bands_;
+        uint32_t band_bits_;
+        std::vector<std::unordered_map<uint64_t, std::vector<uint32_t>>> tables_; // band to distinct signatures
+        std::unordered_map<uint64_t, uint32_t> distinct_;                         // signature to distinct index
+        std::vector<uint64_t> distinct_signatures_;
+        std::vector<std::vector<DocId>> distinct_docs_; // documents of each distinct signature, increasing
+        std::vector<uint64_t> signatures_;
+        std::vector<uint64_t> clusters_;
+    };
+
+} // namespace bridge::index
+
+#endif // BRIDGE_NEAR_DUPLICATES_HPP_
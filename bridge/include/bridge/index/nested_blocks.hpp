@@ -0,0 +1,78 @@
+// Copyright (c) 2021 Bridge Project (Marcos Pontes)
+
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to
+//  deal in the Software without restriction, including without limitation the
+//  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+//  sell copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+//  IN THE SOFTWARE.
+
+//! \brief Nested documents indexed as contiguous blocks of children followed by their parent.
+
+#ifndef BRIDGE_NESTED_BLOCKS_HPP_
+#define BRIDGE_NESTED_BLOCKS_HPP_
+
+#include <vector>
+
+#include "bridge/global.hpp"
+#include "bridge/postings/bit_set.hpp"
+#include "bridge/schema/document.hpp"
+
+namespace bridge::index {
+
+    /**
+     * @brief Lays out nested documents in doc id order for a segment.
+     *
+     * @details Each block is written as its children followed by their parent, so the children of a parent
+     * are exactly the documents between the previous parent and itself. The parent bit set marks the last
+     * document of every block; with it, block joins go from a child to its parent, or from a parent to its
+     * children, without storing any per-document link. Attributes of the variants of a product are thus
+     * indexed once each instead of being copied into the product.
+     *
+     * The layout is part of the doc ids: a segment holding blocks must not be reordered.
+     */
+    class nested_block_writer {
+      public:
+        /**
+         * @brief Appends a block.
+         *
+         * @param children Nested documents, e.g. the variants of a product.
+         * @param parent The enclosing document.
+         * @return The doc id of the parent.
+         */
+        DocId add_block(const std::vector<schema::document> &children, const schema::document &parent);
+
+        /**
+         * @brief Documents in doc id order.
+         */
+        [[nodiscard]] const std::vector<schema::document> &documents() const { return documents_; }
+
+        /**
+         * @brief Number of documents, children included.
+         */
+        [[nodiscard]] DocId num_docs() const { return static_cast<DocId>(documents_.size()); }
+
+        /**
+         * @brief Builds the parent bit set of the segment.
+         */
+        [[nodiscard]] postings::bit_set parents() const;
+
+      private:
+        std::vector<schema::document> documents_;
+        std::vector<DocId> parents_;
+    };
+
+} // namespace bridge::index
+
+#endif // BRIDGE_NESTED_BLOCKS_HPP_
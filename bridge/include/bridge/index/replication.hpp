@@ -0,0 +1,138 @@
+// Copyright (c) 2021 Bridge Project (Marcos Pontes)
+
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to
+//  deal in the Software without restriction, including without limitation the
+//  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+//  sell copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+//  IN THE SOFTWARE.
+
+//! \brief Replication of committed segment files to follower index directories.
+
+#ifndef BRIDGE_REPLICATION_HPP_
+#define BRIDGE_REPLICATION_HPP_
+
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "bridge/common/serialization.hpp"
+#include "bridge/global.hpp"
+
+namespace bridge::index {
+
+    /// @brief Name of the manifest file of an index directory.
+    static constexpr const char *manifest_file_name = "manifest.json";
+
+    /// @brief Name of the file listing the follower files awaiting deletion, in the manifest format.
+    static constexpr const char *retired_file_name = "retired.json";
+
+    /**
+     * @brief An immutable file of a commit.
+     */
+    struct segment_file {
+        std::string name;
+        uint64_t size;
+
+        bool operator==(const segment_file &other) const = default;
+    };
+
+    /**
+     * @brief The files making up a commit of an index.
+     *
+     * @details Segment files are immutable: a commit only adds new files and drops files of merged segments.
+     * The manifest is the single mutable file of a directory and it is always replaced atomically, by a
+     * rename, so a reader opening the manifest sees either the previous commit or the new one, never a mix.
+     */
+    struct segment_manifest {
+        uint64_t generation = 0;         //!< Increases with every commit.
+        std::vector<segment_file> files; //!< Files of the commit, sorted by name.
+
+        bool operator==(const segment_manifest &other) const = default;
+
+        [[nodiscard]] serialization::json_t to_json() const;
+
+        static segment_manifest from_json(const serialization::json_t &json);
+
+        /**
+         * @brief Builds the manifest of files already written to a directory.
+         *
+         * @param directory Index directory.
+         * @param names Names of the files of the commit.
+         * @param generation Generation of the commit.
+         */
+        static segment_manifest of_files(const std::filesystem::path &directory, std::vector<std::string> names,
+                                         uint64_t generation);
+
+        /**
+         * @brief Reads the manifest of a directory, if it has one.
+         */
+        static std::optional<segment_manifest> load(const std::filesystem::path &directory);
+
+        /**
+         * @brief Durably and atomically replaces the manifest of a directory.
+         * @details The manifest is written to a temporary file, synced, renamed over the previous one, and the
+         * directory is synced.
+         */
+        void publish(const std::filesystem::path &directory) const;
+    };
+
+    /**
+     * @brief How the files are transferred to a follower.
+     */
+    enum class copy_method : uint8_t {
+        Auto,     //!< Hard link when possible, then reflink, then byte copy.
+        HardLink, //!< Hard link only, the directories must be on the same file system.
+        Reflink,  //!< Copy-on-write clone only, on file systems supporting it.
+        Copy      //!< Byte copy.
+    };
+
+    /**
+     * @brief What a replication did.
+     */
+    struct replication_result {
+        uint64_t generation = 0;    //!< Generation of the follower after the replication.
+        uint64_t files_copied = 0;  //!< Files transferred.
+        uint64_t bytes_copied = 0;  //!< Bytes of the transferred files.
+        uint64_t files_reused = 0;  //!< Files the follower already had.
+        uint64_t files_removed = 0; //!< Files retired by the previous replication, removed from the follower.
+    };
+
+    /**
+     * @brief Brings a follower directory to the last commit of a leader directory.
+     *
+     * @details Only the files the follower does not have yet are transferred: segment files being
+     * immutable, a file of the same name and size is the same file, and a file of the same name but another
+     * size is refused rather than replaced. Every file is transferred under a temporary name and renamed once
+     * complete. The manifest is published last, so a reader of the follower switches to the new commit
+     * atomically. The follower never re-indexes anything.
+     *
+     * Files dropped by the new commit are not removed at once: they are listed in retired.json and removed by
+     * the next replication. A reader that loaded a manifest may therefore open its files until the follower
+     * has moved two commits ahead; it must open them, and keep them open, before then.
+     *
+     * There must be a single replicator per follower directory.
+     *
+     * @param leader Leader index directory.
+     * @param follower Follower index directory, created if needed.
+     * @param method How the files are transferred.
+     * @return What the replication did.
+     */
+    replication_result replicate(const std::filesystem::path &leader, const std::filesystem::path &follower,
+                                 copy_method method = copy_method::Auto);
+
+} // namespace bridge::index
+
+#endif // BRIDGE_REPLICATION_HPP_
@@ -0,0 +1,110 @@
+// Copyright (c) 2021 Bridge Project (Marcos Pontes)
+
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to
+//  deal in the Software without restriction, including without limitation the
+//  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+//  sell copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+//  IN THE SOFTWARE.
+
+//! \brief Metadata of a segment, with the value range of its fast fields.
+
+#ifndef BRIDGE_SEGMENT_META_HPP_
+#define BRIDGE_SEGMENT_META_HPP_
+
+#include <algorithm>
+#include <map>
+#include <optional>
+#include <string>
+
+#include "bridge/common/serialization.hpp"
+#include "bridge/fastfield/numeric_column.hpp"
+#include "bridge/global.hpp"
+
+namespace bridge::index {
+
+    /**
+     * @brief Closed range of values of a fast field, as sortable integers.
+     */
+    struct value_range {
+        uint64_t min_raw;
+        uint64_t max_raw;
+
+        bool operator==(const value_range &other) const = default;
+
+        /// @brief Range of signed integers, e.g. timestamps.
+        static value_range of(int64_t min, int64_t max) {
+            return {fastfield::to_sortable(min), fastfield::to_sortable(max)};
+        }
+
+        /// @brief Range of doubles.
+        static value_range of(double min, double max) {
+            return {fastfield::to_sortable(min), fastfield::to_sortable(max)};
+        }
+
+        /// @brief Range of unsigned integers.
+        static value_range of(uint64_t min, uint64_t max) { return {min, max}; }
+
+        /**
+         * @brief Checks whether the two ranges share a value.
+         */
+        [[nodiscard]] bool intersects(const value_range &other) const {
+            return min_raw <= other.max_raw && other.min_raw <= max_raw;
+        }
+
+        /**
+         * @brief Smallest range holding both ranges.
+         */
+        [[nodiscard]] value_range span(const value_range &other) const {
+            return {std::min(min_raw, other.min_raw), std::max(max_raw, other.max_raw)};
+        }
+    };
+
+    /**
+     * @brief Metadata of a segment, stored along with its files.
+     *
+     * @details The minimum and maximum of every fast field let a query skip a whole segment when its filter
+     * range cannot match any of its documents, without opening the segment.
+     */
+    struct segment_meta {
+        std::string name;                                //!< Name of the segment.
+        uint32_t num_docs = 0;                           //!< Number of documents.
+        std::map<std::string, value_range> field_ranges; //!< Range of each fast field, absent if empty.
+
+        bool operator==(const segment_meta &other) const = default;
+
+        /**
+         * @brief Records the range of a fast field of the segment.
+         */
+        void add_field(const std::string &field, const fastfield::numeric_column &column);
+
+        /**
+         * @brief Range of a fast field, if the segment has values for it.
+         */
+        [[nodiscard]] std::optional<value_range> range(const std::string &field) const;
+
+        /**
+         * @brief Checks whether some document may have a value of a field in a range.
+         * @details A segment without values for the field cannot match.
+         */
+        [[nodiscard]] bool may_match(const std::string &field, const value_range &filter) const;
+
+        [[nodiscard]] serialization::json_t to_json() const;
+
+        static segment_meta from_json(const serialization::json_t &json);
+    };
+
+} // namespace bridge::index
+
+#endif // BRIDGE_SEGMENT_META_HPP_
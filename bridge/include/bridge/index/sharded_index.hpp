@@ -0,0 +1,209 @@
+// Copyright (c) 2021 Bridge Project (Marcos Pontes)
+
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to
+//  deal in the Software without restriction, including without limitation the
+//  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+//  sell copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+//  IN THE SOFTWARE.
+
+//! \brief Local index hash-partitioned over independent shards, searched with scatter-gather.
+
+#ifndef BRIDGE_SHARDED_INDEX_HPP_
+#define BRIDGE_SHARDED_INDEX_HPP_
+
+#include <filesystem>
+#include <memory>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "bridge/collector/collector.hpp"
+#include "bridge/global.hpp"
+#include "bridge/index/wal.hpp"
+#include "bridge/schema/document.hpp"
+
+namespace bridge::index {
+
+    /**
+     * @brief Statistics of a query over a field, summed over shards to score every shard alike.
+     */
+    struct search_statistics {
+        uint64_t num_docs = 0;           //!< Number of documents.
+        uint64_t total_tokens = 0;       //!< Number of tokens of the field over every document.
+        std::vector<uint64_t> doc_freqs; //!< Number of documents holding each query term in the field.
+
+        /**
+         * @brief Adds the statistics of another shard.
+         */
+        void merge(const search_statistics &other);
+    };
+
+    /**
+     * @brief A hit of a sharded search.
+     */
+    struct shard_hit {
+        uint32_t shard; //!< Shard of the document.
+        DocId doc;      //!< Doc id of the document in its shard.
+        Score score;
+
+        bool operator==(const shard_hit &other) const = default;
+    };
+
+    /**
+     * @brief An independent index living in its own directory.
+     *
+     * @details Text fields are split into alphanumeric tokens and indexed in memory, with their term
+     * frequencies and field norms. Every accepted batch goes first to the write-ahead log of the directory,
+     * which is replayed when the shard is opened again.
+     *
+     * A shard has its own writer lock, so shards are written concurrently. It is thread safe.
+     */
+    class index_shard {
+      public:
+        /**
+         * @brief Opens a shard, creating its directory if needed.
+         *
+         * @param directory Directory of the shard.
+         * @param options Tuning of the write-ahead log.
+         */
+        explicit index_shard(const std::filesystem::path &directory, wal_options options = {});
+
+        /**
+         * @brief Logs and indexes a batch of documents.
+         *
+         * @return The sequence number of the batch in the log, to be passed to sync().
+         */
+        uint64_t add_documents(const std::vector<schema::document> &documents);
+
+        /**
+         * @brief Waits until a batch is durable.
+         */
+        void sync(uint64_t sequence) { wal_.sync(sequence); }
+
+        /**
+         * @brief Number of documents of the shard.
+         */
+        [[nodiscard]] uint64_t num_docs() const;
+
+        /**
+         * @brief Get a document.
+         */
+        [[nodiscard]] schema::document document(DocId doc) const;
+
+        /**
+         * @brief Local statistics of a query.
+         *
+         * @param field Searched field.
+         * @param terms Query terms.
+         */
+        [[nodiscard]] search_statistics statistics(schema::id_t field, const std::vector<std::string> &terms) const;
+
+        /**
+         * @brief BM25 top-k of a query.
+         *
+         * @param field Searched field.
+         * @param terms Query terms.
+         * @param stats Statistics the scores are computed with, usually those of every shard.
+         * @param k Number of hits.
+         * @return The best hits, best first.
+         */
+        [[nodiscard]] std::vector<collector::hit> search(schema::id_t field, const std::vector<std::string> &terms,
+                                                         const search_statistics &stats, size_t k) const;
+
+      private:
+        struct field_index {
+            std::unordered_map<std::string, std::vector<std::pair<DocId, uint32_t>>> postings;
+            std::vector<uint32_t> field_norms;
+            uint64_t total_tokens = 0;
+        };
+
+        void index(const schema::document &document);
+
+        mutable std::shared_mutex mutex_;
+        write_ahead_log wal_;
+        std::vector<schema::document> documents_;
+        std::unordered_map<schema::id_t, field_index> fields_;
+    };
+
+    /**
+     * @brief Index partitioned over N shards by the hash of a routing field.
+     *
+     * @details Shard i lives in the directory shard_i of the root directory, and the number of shards is
+     * recorded in shards.json so that an index cannot be reopened with another one. Writes to different
+     * shards proceed in parallel, each with its own log and its own, smaller, data.
+     *
+     * A search fans out to every shard in parallel twice: once to gather the statistics of the query, which
+     * are summed so that idf and average field length are those of the whole index, and once to compute the
+     * top-k of each shard with these global statistics. The per-shard top-k are then merged. Since every
+     * shard scores with the same statistics, a document gets the same score as in a single index.
+     */
+    class sharded_index {
+      public:
+        /**
+         * @brief Opens a sharded index, creating it if needed.
+         *
+         * @param root Root directory.
+         * @param num_shards Number of shards. It must match the number the index was created with.
+         * @param routing_field Field whose first value picks the shard of a document, e.g. its id.
+         * @param options Tuning of the write-ahead logs.
+         */
+        sharded_index(const std::filesystem::path &root, uint32_t num_shards, schema::id_t routing_field,
+                      wal_options options = {});
+
+        /**
+         * @brief Number of shards.
+         */
+        [[nodiscard]] uint32_t num_shards() const { return static_cast<uint32_t>(shards_.size()); }
+
+        /**
+         * @brief Get a shard.
+         */
+        [[nodiscard]] const index_shard &shard(uint32_t shard) const { return *shards_.at(shard); }
+
+        /**
+         * @brief Shard of a document.
+         */
+        [[nodiscard]] uint32_t shard_of(const schema::document &document) const;
+
+        /**
+         * @brief Adds documents and waits until they are durable.
+         */
+        void add_documents(const std::vector<schema::document> &documents);
+
+        /**
+         * @brief Global statistics of a query.
+         */
+        [[nodiscard]] search_statistics statistics(schema::id_t field, const std::vector<std::string> &terms) const;
+
+        /**
+         * @brief BM25 top-k of a query over every shard.
+         *
+         * @param field Searched field.
+         * @param terms Query terms.
+         * @param k Number of hits.
+         * @return The best hits, by decreasing score, ties broken by shard and doc id.
+         */
+        [[nodiscard]] std::vector<shard_hit> search(schema::id_t field, const std::vector<std::string> &terms,
+                                                    size_t k) const;
+
+      private:
+        std::vector<std::unique_ptr<index_shard>> shards_;
+        schema::id_t routing_field_;
+    };
+
+} // namespace bridge::index
+
+#endif // BRIDGE_SHARDED_INDEX_HPP_
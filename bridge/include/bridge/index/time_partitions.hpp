@@ -0,0 +1,125 @@
+// Copyright (c) 2021 Bridge Project (Marcos Pontes)
+
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to
+//  deal in the Software without restriction, including without limitation the
+//  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+//  sell copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+//  IN THE SOFTWARE.
+
+//! \brief Rolling time-partitioned indexes, pruned by the time range of their segments.
+
+#ifndef BRIDGE_TIME_PARTITIONS_HPP_
+#define BRIDGE_TIME_PARTITIONS_HPP_
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "bridge/common/serialization.hpp"
+#include "bridge/global.hpp"
+#include "bridge/index/segment_meta.hpp"
+
+namespace bridge::index {
+
+    /**
+     * @brief The index of a time window.
+     */
+    struct time_partition {
+        int64_t start;                      //!< First timestamp of the window.
+        int64_t end;                        //!< Timestamp following the window.
+        std::vector<segment_meta> segments; //!< Segments of the window.
+
+        bool operator==(const time_partition &other) const = default;
+    };
+
+    /**
+     * @brief Segments selected by a time filter.
+     */
+    struct partition_selection {
+        std::vector<const segment_meta *> segments; //!< Segments that may match, by partition.
+        uint64_t partitions_visited = 0;            //!< Partitions overlapping the filter.
+        uint64_t segments_skipped = 0;              //!< Segments of visited partitions pruned by their range.
+    };
+
+    /**
+     * @brief Manager of indexes partitioned by time windows of a fixed width.
+     *
+     * @details Each window gets its own index, i.e. its own set of segments, created when the first segment of
+     * the window arrives. A segment must fall within a single window, according to the range of its time fast
+     * field recorded in its meta.
+     *
+     * A time filter first selects the windows it overlaps, a range lookup in the ordered windows that never
+     * touches the others, then skips the segments of these windows whose time range is disjoint from the
+     * filter. A query on the last hour of 30 days of data visits one or two windows, not every segment.
+     * Old windows are dropped as a whole by expire().
+     */
+    class time_partitioned_index {
+      public:
+        /**
+         * @brief Construct a new manager.
+         *
+         * @param time_field Name of the I64 fast field holding the timestamp of the documents.
+         * @param window Width of a window, in the unit of the timestamps.
+         */
+        time_partitioned_index(std::string time_field, int64_t window);
+
+        /**
+         * @brief First timestamp of the window holding a timestamp.
+         */
+        [[nodiscard]] int64_t window_start(int64_t timestamp) const;
+
+        /**
+         * @brief Adds a segment to the partition of its window, creating the partition if needed.
+         *
+         * @param segment Meta of the segment. It must have a time range within a single window.
+         * @return The partition of the segment.
+         */
+        const time_partition &add_segment(segment_meta segment);
+
+        /**
+         * @brief Drops the partitions whose window ends before a timestamp.
+         *
+         * @param before Oldest timestamp to retain.
+         * @return The dropped partitions, to delete their files.
+         */
+        std::vector<time_partition> expire(int64_t before);
+
+        /**
+         * @brief Selects the segments that may hold documents within a time range.
+         *
+         * @param from First timestamp of the filter.
+         * @param to Last timestamp of the filter, included.
+         * @return The selected segments. They are valid until the partitions change.
+         */
+        [[nodiscard]] partition_selection select(int64_t from, int64_t to) const;
+
+        /**
+         * @brief Partitions by increasing window.
+         */
+        [[nodiscard]] const std::map<int64_t, time_partition> &partitions() const { return partitions_; }
+
+        [[nodiscard]] serialization::json_t to_json() const;
+
+        static time_partitioned_index from_json(const serialization::json_t &json);
+
+      private:
+        std::string time_field_;
+        int64_t window_;
+        std::map<int64_t, time_partition> partitions_; // by window start
+    };
+
+} // namespace bridge::index
+
+#endif // BRIDGE_TIME_PARTITIONS_HPP_
@@ -0,0 +1,187 @@
+// Copyright (c) 2021 Bridge Project (Marcos Pontes)
+
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to
+//  deal in the Software without restriction, including without limitation the
+//  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+//  sell copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+//  IN THE SOFTWARE.
+
+//! \brief Write-ahead log of the accepted documents and deletes, with group commit.
+
+#ifndef BRIDGE_WAL_HPP_
+#define BRIDGE_WAL_HPP_
+
+#include <chrono>
+#include <condition_variable>
+#include <filesystem>
+#include <functional>
+#include <mutex>
+#include <vector>
+
+#include "bridge/global.hpp"
+#include "bridge/schema/document.hpp"
+#include "bridge/schema/term.hpp"
+
+namespace bridge::index {
+
+    /**
+     * @brief Kind of a logged operation.
+     */
+    enum class wal_op : uint8_t { AddDocuments = 1, DeleteTerms = 2 };
+
+    /**
+     * @brief A logged batch of documents or deletes.
+     */
+    struct wal_record {
+        uint64_t sequence = 0;
+        wal_op op = wal_op::AddDocuments;
+        std::vector<schema::document> documents; //!< Documents of an AddDocuments batch.
+        std::vector<schema::term> terms;         //!< Deleted terms of a DeleteTerms batch.
+    };
+
+    /**
+     * @brief Tuning of the write-ahead log.
+     */
+    struct wal_options {
+        /// @brief Time a flushing writer waits for other writers to join its group, 0 to flush at once.
+        std::chrono::microseconds group_delay{0};
+    };
+
+    /**
+     * @brief Append-only log making accepted writes durable between segment commits.
+     *
+     * @details Every batch gets an increasing sequence number and is appended as a record: the payload length
+     * (u32), its CRC-32 (u32) and the payload, i.e. the sequence number (u64), the operation (1 byte), the
+     * number of items and the items, documents being encoded field by field with vints. The file starts with
+     * a magic number and the sequence number of its first record.
+     *
+     * Appending only buffers the record. sync() makes it durable with group commit: the first waiting writer
+     * writes every buffered record with a single write and fdatasync, while the writers that arrive meanwhile
+     * wait for the next group. Under load, many acknowledged batches share one fdatasync.
+     *
+     * A crash may leave a torn record at the end of the file. It is detected by its checksum, ignored on
+     * replay and cut off when the log is reopened. If a write or fdatasync fails, the log is cut back to its
+     * last durable record and fails every later call: the batches of the failed group are never reported
+     * durable, and it must be reopened. Once batches are in a committed segment, reset() drops them.
+     *
+     * The log is thread safe.
+     */
+    class write_ahead_log {
+      public:
+        /// @brief Receives the replayed records, by increasing sequence number.
+        using replay_callback = std::function<void(const wal_record &)>;
+
+        /**
+         * @brief Opens a log, creating it if needed.
+         *
+         * @param path Path of the log file.
+         * @param options Tuning of the log.
+         */
+        explicit write_ahead_log(std::filesystem::path path, wal_options options = {});
+
+        /**
+         * @brief Flushes the buffered records and closes the log.
+         */
+        ~write_ahead_log();
+
+        write_ahead_log(const write_ahead_log &) = delete;
+        write_ahead_log &operator=(const write_ahead_log &) = delete;
+
+        /**
+         * @brief Buffers a batch of documents.
+         *
+         * @return The sequence number of the batch.
+         */
+        uint64_t add_documents(const std::vector<schema::document> &documents);
+
+        /**
+         * @brief Buffers a batch of deletes.
+         *
+         * @return The sequence number of the batch.
+         */
+        uint64_t delete_terms(const std::vector<schema::term> &terms);
+
+        /**
+         * @brief Waits until a batch is durable.
+         *
+         * @param sequence Sequence number returned by add_documents or delete_terms.
+         * @throws bridge_error if no batch with this sequence number was written yet.
+         */
+        void sync(uint64_t sequence);
+
+        /**
+         * @brief Waits until every buffered batch is durable.
+         */
+        void sync() { sync(last_sequence()); }
+
+        /**
+         * @brief Sequence number of the last buffered batch, 0 if none.
+         */
+        [[nodiscard]] uint64_t last_sequence() const;
+
+        /**
+         * @brief Sequence number of the last durable batch, 0 if none.
+         */
+        [[nodiscard]] uint64_t durable_sequence() const;
+
+        /**
+         * @brief Number of fdatasync calls since the log was opened.
+         */
+        [[nodiscard]] uint64_t num_syncs() const;
+
+        /**
+         * @brief Drops the batches that are in a committed segment.
+         *
+         * @details Batches appended after the commit captured its state are kept, buffered or durable. The
+         * new log is written to a temporary file, synced and renamed over the previous one, so a crash leaves
+         * either log. Sequence numbers keep increasing after a reset.
+         *
+         * @param committed Sequence number of the last batch in the committed segment.
+         */
+        void reset(uint64_t committed);
+
+        /**
+         * @brief Reads the records of a log.
+         *
+         * @param path Path of the log file. A missing file has no records.
+         * @param callback Receives the records.
+         * @param after Only records with a larger sequence number are replayed, e.g. the last committed one.
+         * @return The sequence number of the last record, or of the last reset if the log is empty.
+         */
+        static uint64_t replay(const std::filesystem::path &path, const replay_callback &callback,
+                               uint64_t after = 0);
+
+      private:
+        uint64_t append(std::vector<bridge::byte_t> &&payload);
+        void check_not_failed() const;
+
+        std::filesystem::path path_;
+        wal_options options_;
+        int fd_ = -1;
+
+        mutable std::mutex mutex_;
+        std::condition_variable flushed_;
+        std::vector<bridge::byte_t> pending_; // records buffered but not written yet
+        uint64_t last_sequence_ = 0;
+        uint64_t durable_sequence_ = 0;
+        size_t durable_size_ = 0; // size of the file up to the last durable record
+        uint64_t num_syncs_ = 0;
+        bool flushing_ = false;
+        bool failed_ = false; // a flush failed, nothing can be appended anymore
+    };
+
+} // namespace bridge::index
+
+#endif // BRIDGE_WAL_HPP_
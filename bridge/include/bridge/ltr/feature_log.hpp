@@ -0,0 +1,157 @@
+// Copyright (c) 2021 Bridge Project (Marcos Pontes)
+
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to
+//  deal in the Software without restriction, including without limitation the
+//  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+//  sell copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+//  IN THE SOFTWARE.
+
+//! \brief Feature logging of judgment lists, to build the training data of ranking models.
+
+#ifndef BRIDGE_FEATURE_LOG_HPP_
+#define BRIDGE_FEATURE_LOG_HPP_
+
+#include <functional>
+#include <memory>
+#include <ostream>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include "bridge/directory/directory.hpp"
+#include "bridge/global.hpp"
+#include "bridge/ltr/quick_scorer.hpp"
+#include "bridge/postings/term_vector.hpp"
+
+namespace bridge::ltr {
+
+    /**
+     * @brief A judged (query, document) pair.
+     */
+    struct judgment {
+        uint32_t query_id;
+        DocId doc;
+        float relevance;
+
+        bool operator==(const judgment &other) const = default;
+    };
+
+    /**
+     * @brief Fills the features of the judged documents of a query.
+     * @details Called with the query id, its documents and a batch with one row per document. It is called
+     * concurrently from several threads, so it must be thread safe.
+     */
+    using feature_extractor = std::function<void(uint32_t, std::span<const DocId>, feature_batch &)>;
+
+    /**
+     * @brief Query terms searched in a field, with the statistics needed to score them.
+     */
+    struct field_query {
+        const postings::term_vector_reader *vectors;      //!< Term vectors of the field.
+        std::vector<std::pair<uint32_t, uint64_t>> terms; //!< Term ordinals and their doc frequency.
+        uint64_t num_docs;                                //!< Number of documents of the collection.
+        Score average_field_norm;                         //!< Average number of tokens of the field.
+    };
+
+    /// @brief Number of features written by extract_field_features.
+    static constexpr uint32_t features_per_field = 3;
+
+    /**
+     * @brief Extracts the features of a field from its term vectors, without tokenizing the documents again.
+     *
+     * @details Writes, from first_feature on, the BM25 score of the query, the sum of the frequencies of its
+     * terms and the length of the field.
+     *
+     * @param query Query terms of the field.
+     * @param docs Documents to extract the features of.
+     * @param batch Batch with one row per document.
+     * @param first_feature Column of the first feature.
+     */
+    void extract_field_features(const field_query &query, std::span<const DocId> docs, feature_batch &batch,
+                                uint32_t first_feature);
+
+    /**
+     * @brief Logs the features of every pair of a judgment list into a columnar file.
+     *
+     * @details Queries are spread over worker threads, and the features of each query are extracted in a single
+     * batch. Rows are grouped by query id, in increasing order, keeping the order of the judgment list within a
+     * query, so the output does not depend on the scheduling.
+     *
+     * The file holds the query ids (u32), the doc ids (u32), the relevances (f32) and then every feature column
+     * (f32), followed by the number of rows (u64) and the number of features (u32), all little-endian.
+     */
+    class feature_logger {
+      public:
+        /**
+         * @brief Construct a new logger.
+         *
+         * @param num_features Number of features of a row.
+         * @param num_threads Number of worker threads, 0 for one per hardware thread.
+         */
+        explicit feature_logger(uint32_t num_features, size_t num_threads = 0);
+
+        /**
+         * @brief Extracts and writes the features of a judgment list.
+         *
+         * @param judgments Judgment list.
+         * @param extractor Feature extractor.
+         * @param os Output stream.
+         * @return Number of rows written.
+         */
+        uint64_t log(const std::vector<judgment> &judgments, const feature_extractor &extractor,
+                     std::ostream &os) const;
+
+      private:
+        uint32_t num_features_;
+        size_t num_threads_;
+    };
+
+    /**
+     * @brief Reads a file written by a feature_logger.
+     */
+    class feature_log_reader {
+      public:
+        /**
+         * @brief Construct a new reader.
+         *
+         * @param source Source of the file.
+         */
+        explicit feature_log_reader(std::shared_ptr<directory::read_only_source> source);
+
+        [[nodiscard]] uint64_t num_rows() const { return num_rows_; }
+
+        [[nodiscard]] uint32_t num_features() const { return num_features_; }
+
+        /**
+         * @brief Get the judgment of a row.
+         */
+        [[nodiscard]] judgment row(uint64_t row) const;
+
+        /**
+         * @brief Get a feature column.
+         */
+        [[nodiscard]] std::vector<float> column(uint32_t feature) const;
+
+      private:
+        [[nodiscard]] uint32_t read_cell(uint64_t column, uint64_t row) const;
+
+        std::shared_ptr<directory::read_only_source> source_;
+        uint64_t num_rows_ = 0;
+        uint32_t num_features_ = 0;
+    };
+
+} // namespace bridge::ltr
+
+#endif // BRIDGE_FEATURE_LOG_HPP_
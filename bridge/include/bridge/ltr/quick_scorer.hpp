@@ -0,0 +1,148 @@
+// Copyright (c) 2021 Bridge Project (Marcos Pontes)
+
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to
+//  deal in the Software without restriction, including without limitation the
+//  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+//  sell copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+//  IN THE SOFTWARE.
+
+//! \brief QuickScorer evaluation of tree ensembles and the re-ranking stage built on it.
+
+#ifndef BRIDGE_QUICK_SCORER_HPP_
+#define BRIDGE_QUICK_SCORER_HPP_
+
+#include <vector>
+
+#include "bridge/global.hpp"
+#include "bridge/ltr/tree_ensemble.hpp"
+
+namespace bridge::ltr {
+
+    /**
+     * @brief Features of a batch of documents, stored column by column.
+     * @details Each feature is extracted for every candidate at once (BM25 of a field, a fast field value...),
+     * and the evaluation reads a feature for consecutive documents, so both sides stay cache friendly.
+     */
+    class feature_batch {
+      public:
+        /**
+         * @brief Construct a batch filled with zeros.
+         *
+         * @param num_features Number of features.
+         * @param num_docs Number of documents.
+         */
+        feature_batch(uint32_t num_features, size_t num_docs);
+
+        /**
+         * @brief Values of a feature for every document of the batch.
+         */
+        [[nodiscard]] float *column(uint32_t feature) { return values_.data() + feature * num_docs_; }
+
+        [[nodiscard]] const float *column(uint32_t feature) const { return values_.data() + feature * num_docs_; }
+
+        void set(size_t doc, uint32_t feature, float value) { column(feature)[doc] = value; }
+
+        [[nodiscard]] float get(size_t doc, uint32_t feature) const { return column(feature)[doc]; }
+
+        /**
+         * @brief Copy the features of a document into a row vector.
+         */
+        [[nodiscard]] std::vector<float> row(size_t doc) const;
+
+        [[nodiscard]] uint32_t num_features() const { return num_features_; }
+
+        [[nodiscard]] size_t num_docs() const { return num_docs_; }
+
+      private:
+        uint32_t num_features_;
+        size_t num_docs_;
+        std::vector<float> values_;
+    };
+
+    /**
+     * @brief Tree ensemble compiled for the QuickScorer algorithm (Lucchese et al., SIGIR 2015).
+     *
+     * @details Instead of walking the trees node by node, every node of the ensemble is grouped by feature
+     * and sorted by threshold. The leaves of a tree are numbered from left to right in a bit vector, and a node
+     * whose test fails clears the leaves of its left subtree. Once every failing node is applied, the exit leaf
+     * of a tree is its lowest remaining bit. Scoring a document is then a scan over sorted thresholds with no
+     * data dependent branch, which is what makes it fast on large ensembles.
+     *
+     * Documents are processed in blocks so that each threshold is tested against several documents in a row,
+     * a loop the compiler vectorizes. Trees are limited to 64 leaves.
+     */
+    class quick_scorer {
+      public:
+        /// @brief Number of documents evaluated together.
+        static constexpr size_t block_size = 16;
+
+        /**
+         * @brief Compiles an ensemble.
+         */
+        explicit quick_scorer(const tree_ensemble &ensemble);
+
+        /**
+         * @brief Score every document of a batch.
+         *
+         * @param batch Features of the documents.
+         * @return The score of each document.
+         */
+        [[nodiscard]] std::vector<Score> score(const feature_batch &batch) const;
+
+        [[nodiscard]] uint32_t num_features() const { return num_features_; }
+
+      private:
+        struct condition {
+            float threshold;
+            uint32_t tree;
+            uint64_t mask;
+            bool missing_right; // a missing feature fails the test
+        };
+
+        void score_block(const feature_batch &batch, size_t first, size_t count, uint64_t *leaves, Score *out) const;
+
+        uint32_t num_features_;
+        uint32_t num_trees_;
+        Score base_score_;
+        std::vector<condition> conditions_;   // grouped by feature, by increasing threshold
+        std::vector<size_t> feature_offsets_; // num_features + 1 offsets into conditions
+        std::vector<Score> leaves_;           // leaf values, tree by tree
+        std::vector<size_t> leaf_offsets_;    // first leaf of each tree
+    };
+
+    /**
+     * @brief A document and its score.
+     */
+    struct ranked_doc {
+        DocId doc;
+        Score score;
+
+        bool operator==(const ranked_doc &other) const = default;
+    };
+
+    /**
+     * @brief Re-ranks the top candidates of a first-stage retrieval.
+     *
+     * @param candidates Candidates, the i-th one matching the i-th document of the batch.
+     * @param features Features of the candidates.
+     * @param model Compiled ranking model.
+     * @return The candidates with the score of the model, by decreasing score, ties broken by doc id.
+     */
+    std::vector<ranked_doc> rerank(const std::vector<ranked_doc> &candidates, const feature_batch &features,
+                                   const quick_scorer &model);
+
+} // namespace bridge::ltr
+
+#endif // BRIDGE_QUICK_SCORER_HPP_
@@ -0,0 +1,118 @@
+// Copyright (c) 2021 Bridge Project (Marcos Pontes)
+
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to
+//  deal in the Software without restriction, including without limitation the
+//  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+//  sell copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+//  IN THE SOFTWARE.
+
+//! \brief Gradient-boosted regression trees used to re-rank documents.
+
+#ifndef BRIDGE_TREE_ENSEMBLE_HPP_
+#define BRIDGE_TREE_ENSEMBLE_HPP_
+
+#include <vector>
+
+#include "bridge/common/serialization.hpp"
+#include "bridge/global.hpp"
+
+namespace bridge::ltr {
+
+    /**
+     * @brief A node of a regression tree.
+     * @details An internal node sends a document to its left child when its feature is lower than the
+     * threshold, and to its right child otherwise. Missing (NaN) features follow the default direction
+     * learnt for the node, left unless stated otherwise.
+     */
+    struct tree_node {
+        uint32_t feature = 0;
+        float threshold = 0.0F;
+        int32_t left = -1;         //!< Index of the left child, -1 for a leaf.
+        int32_t right = -1;        //!< Index of the right child, -1 for a leaf.
+        Score value = 0.0F;        //!< Output of a leaf.
+        bool missing_left = true;  //!< Whether a missing feature goes to the left child.
+
+        [[nodiscard]] bool is_leaf() const { return left < 0; }
+    };
+
+    /**
+     * @brief A regression tree, stored as an array of nodes whose root is the first one.
+     */
+    struct regression_tree {
+        std::vector<tree_node> nodes;
+
+        /**
+         * @brief Output of the tree for a document.
+         *
+         * @param features Feature vector of the document.
+         */
+        [[nodiscard]] Score score(const float *features) const;
+
+        /**
+         * @brief Number of leaves of the tree.
+         */
+        [[nodiscard]] size_t num_leaves() const;
+    };
+
+    /**
+     * @brief An additive ensemble of regression trees.
+     */
+    class tree_ensemble {
+      public:
+        /**
+         * @brief Construct a new ensemble.
+         *
+         * @param trees Trees of the ensemble.
+         * @param num_features Size of the feature vectors.
+         * @param base_score Score added to the output of the trees.
+         */
+        tree_ensemble(std::vector<regression_tree> &&trees, uint32_t num_features, Score base_score = 0.0F);
+
+        /**
+         * @brief Loads an ensemble from its JSON export.
+         *
+         * @details Accepts the JSON dump of XGBoost, i.e. an array of trees whose nodes are objects holding
+         * either a "leaf" value or a "split" feature ("f3" or 3), a "split_condition", the "yes" and "no"
+         * node ids, the optional "missing" node id taken by missing features and the nested "children". The
+         * array may also be wrapped in an object with the "trees", and optionally the "base_score" and
+         * "num_features" keys.
+         *
+         * @param json JSON export of the model.
+         * @return The ensemble.
+         */
+        static tree_ensemble from_json(const serialization::json_t &json);
+
+        /**
+         * @brief Score a document by walking every tree.
+         *
+         * @param features Feature vector of the document.
+         */
+        [[nodiscard]] Score score(const float *features) const;
+
+        [[nodiscard]] const std::vector<regression_tree> &trees() const { return trees_; }
+
+        [[nodiscard]] uint32_t num_features() const { return num_features_; }
+
+        [[nodiscard]] Score base_score() const { return base_score_; }
+
+      private:
+        std::vector<regression_tree> trees_;
+        uint32_t num_features_;
+        Score base_score_;
+    };
+
+} // namespace bridge::ltr
+
+#endif // BRIDGE_TREE_ENSEMBLE_HPP_
@@ -21,6 +21,12 @@
 #ifndef POSTINGS_HPP_
 #define POSTINGS_HPP_
 
-namespace bridge {}; // namespace bridge
+#include "bridge/postings/bit_set.hpp"
+#include "bridge/postings/doc_set.hpp"
+#include "bridge/postings/elias_fano.hpp"
+#include "bridge/postings/impact_postings.hpp"
+#include "bridge/postings/term_dictionary.hpp"
+#include "bridge/postings/term_vector.hpp"
+#include "bridge/postings/vec_postings.hpp"
 
 #endif // POSTINGS_HPP_
\ No newline at end of file
@@ -0,0 +1,133 @@
+// Copyright (c) 2021 Bridge Project (Marcos Pontes)
+
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to
+//  deal in the Software without restriction, including without limitation the
+//  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+//  sell copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+//  IN THE SOFTWARE.
+
+//! \brief Fixed-size set of doc ids stored as a bitmap.
+
+#ifndef BRIDGE_BIT_SET_HPP_
+#define BRIDGE_BIT_SET_HPP_
+
+#include <ostream>
+#include <vector>
+
+#include "bridge/global.hpp"
+#include "bridge/postings/doc_set.hpp"
+
+namespace bridge::postings {
+
+    /**
+     * @brief Set of doc ids in [0, num_bits), one bit per document.
+     *
+     * @details Besides membership, the set finds the next or previous member of a document with a scan of
+     * whole words, which is what block joins need to go from a child to its parent. The serialized format is
+     * the number of bits as a vint followed by the little-endian words.
+     */
+    class bit_set {
+      public:
+        /**
+         * @brief Construct an empty set.
+         *
+         * @param num_bits Number of documents the set can hold.
+         */
+        explicit bit_set(DocId num_bits = 0);
+
+        /**
+         * @brief Adds a document to the set.
+         */
+        void insert(DocId doc);
+
+        /**
+         * @brief Whether the document is in the set.
+         */
+        [[nodiscard]] bool contains(DocId doc) const {
+            return doc < num_bits_ && ((words_[doc / 64] >> (doc % 64)) & 1U) != 0;
+        }
+
+        /**
+         * @brief First document of the set greater or equal to doc.
+         * @return The document, or TERMINATED if there is none.
+         */
+        [[nodiscard]] DocId next_set_bit(DocId doc) const;
+
+        /**
+         * @brief Last document of the set lower or equal to doc.
+         * @return The document, or TERMINATED if there is none.
+         */
+        [[nodiscard]] DocId prev_set_bit(DocId doc) const;
+
+        /**
+         * @brief Number of documents the set can hold.
+         */
+        [[nodiscard]] DocId num_bits() const { return num_bits_; }
+
+        /**
+         * @brief Number of documents in the set.
+         */
+        [[nodiscard]] uint32_t count() const;
+
+        /**
+         * @brief Writes the set.
+         *
+         * @param os Output stream.
+         * @return Number of bytes written.
+         */
+        uint64_t serialize(std::ostream &os) const;
+
+        /**
+         * @brief Reads a set.
+         *
+         * @param data Pointer to the serialized set. It is advanced past the set.
+         * @param end End of the readable region.
+         * @return The set.
+         */
+        static bit_set deserialize(const bridge::byte_t *&data, const bridge::byte_t *end);
+
+      private:
+        DocId num_bits_;
+        std::vector<uint64_t> words_;
+    };
+
+    /**
+     * @brief Cursor over the documents of a bit_set.
+     */
+    class bit_set_cursor : public doc_set {
+      public:
+        /**
+         * @brief Construct a new cursor.
+         *
+         * @param set Documents. The set must outlive the cursor.
+         */
+        explicit bit_set_cursor(const bit_set &set) : set_(&set), doc_(set.next_set_bit(0)) {}
+
+        DocId advance() override { return doc_ = doc_ == TERMINATED ? TERMINATED : set_->next_set_bit(doc_ + 1); }
+
+        [[nodiscard]] DocId doc() const override { return doc_; }
+
+        DocId seek(DocId target) override { return doc_ = target <= doc_ ? doc_ : set_->next_set_bit(target); }
+
+        [[nodiscard]] uint32_t size_hint() const override { return set_->count(); }
+
+      private:
+        const bit_set *set_;
+        DocId doc_;
+    };
+
+} // namespace bridge::postings
+
+#endif // BRIDGE_BIT_SET_HPP_
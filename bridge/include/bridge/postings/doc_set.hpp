@@ -0,0 +1,144 @@
+// Copyright (c) 2021 Bridge Project (Marcos Pontes)
+
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to
+//  deal in the Software without restriction, including without limitation the
+//  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+//  sell copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+//  IN THE SOFTWARE.
+
+//! \brief Cursor over a sorted set of documents.
+
+#ifndef BRIDGE_DOC_SET_HPP_
+#define BRIDGE_DOC_SET_HPP_
+
+#include <limits>
+
+#include "bridge/global.hpp"
+
+namespace bridge::postings {
+
+    /// @brief Doc id returned by a doc_set once it is exhausted.
+    static constexpr DocId TERMINATED = std::numeric_limits<DocId>::max();
+
+    class doc_set;
+
+    /**
+     * @brief Two-phase view of an expensive doc_set: a cheap approximation and a confirmation step.
+     *
+     * @details The approximation iterates a superset of the documents, e.g. the documents holding every term of
+     * a phrase, and `matches()` tells whether its current document really matches, e.g. by reading positions.
+     * Consumers such as conjunctions move the approximations first and only confirm the documents every
+     * clause agrees on, so expensive checks are never run on documents a cheap clause rejects.
+     *
+     * The doc_set exposing the view is positioned on the same document as the approximation: moving the
+     * approximation moves the doc_set.
+     */
+    class two_phase_iterator {
+      public:
+        /**
+         * @brief Virtual destructor for two_phase_iterator.
+         */
+        virtual ~two_phase_iterator() = default;
+
+        /**
+         * @brief The cheap superset of the matching documents.
+         */
+        [[nodiscard]] virtual doc_set &approximation() = 0;
+
+        /**
+         * @brief Whether the current document of the approximation matches.
+         * @details A doc_set confirms its first document when it is built, and a consumer may ask again: calling
+         * it twice on the same document must be cheap.
+         */
+        [[nodiscard]] virtual bool matches() = 0;
+
+        /**
+         * @brief Estimated cost of a call to matches(), in the number of operations it takes.
+         */
+        [[nodiscard]] virtual float match_cost() const = 0;
+
+        /**
+         * @brief Moves the approximation to its first matching document, starting from its current one.
+         * @return The matching document, or TERMINATED.
+         */
+        DocId next_match();
+    };
+
+    /**
+     * @brief Cursor over a set of documents, by increasing doc id.
+     * @details A doc_set is positioned on its first document right after its construction,
+     * so `doc()` is valid before any call to `advance()`.
+     */
+    class doc_set {
+      public:
+        /**
+         * @brief Virtual destructor for doc_set.
+         */
+        virtual ~doc_set() = default;
+
+        /**
+         * @brief Moves to the next document.
+         * @return The new current document, or TERMINATED.
+         */
+        virtual DocId advance() = 0;
+
+        /**
+         * @brief Returns the current document, or TERMINATED.
+         */
+        [[nodiscard]] virtual DocId doc() const = 0;
+
+        /**
+         * @brief Moves to the first document greater or equal to target.
+         * @details The cursor never moves backward: if target is lower than the current document,
+         * the cursor stays where it is.
+         *
+         * @param target Target doc id.
+         * @return The new current document, or TERMINATED.
+         */
+        virtual DocId seek(DocId target) {
+            DocId current = doc();
+            while (current < target) {
+                current = advance();
+            }
+            return current;
+        }
+
+        /**
+         * @brief Returns an estimation of the number of documents of the set.
+         */
+        [[nodiscard]] virtual uint32_t size_hint() const = 0;
+
+        /**
+         * @brief Two-phase view of the doc_set, or nullptr when its documents are cheap to check.
+         * @details The view is owned by the doc_set.
+         */
+        [[nodiscard]] virtual two_phase_iterator *two_phase() { return nullptr; }
+    };
+
+    /**
+     * @brief Moves the approximation to its first matching document, starting from its current one.
+     */
+    inline DocId two_phase_iterator::next_match() {
+        doc_set &docs = approximation();
+        DocId doc = docs.doc();
+        while (doc != TERMINATED && !matches()) {
+            doc = docs.advance();
+        }
+        return doc;
+    }
+
+} // namespace bridge::postings
+
+#endif // BRIDGE_DOC_SET_HPP_
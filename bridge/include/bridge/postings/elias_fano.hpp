@@ -0,0 +1,148 @@
+// Copyright (c) 2021 Bridge Project (Marcos Pontes)
+
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to
+//  deal in the Software without restriction, including without limitation the
+//  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+//  sell copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+//  IN THE SOFTWARE.
+
+//! \brief Partitioned Elias-Fano postings codec.
+
+#ifndef BRIDGE_ELIAS_FANO_HPP_
+#define BRIDGE_ELIAS_FANO_HPP_
+
+#include <ostream>
+#include <vector>
+
+#include "bridge/global.hpp"
+#include "bridge/postings/doc_set.hpp"
+
+namespace bridge::postings {
+
+    class elias_fano_cursor;
+
+    /**
+     * @brief Doc ids encoded with partitioned Elias-Fano.
+     *
+     * @details The sequence is split in partitions of `partition_size` documents. Each partition is encoded
+     * relatively to the last document of the previous one, either with Elias-Fano (low bits packed, high bits
+     * in unary) or, when it is cheaper, as a plain bitmap over its universe. Dense lists therefore cost about
+     * one bit per document, and sparse ones about 2 + log(universe / size) bits.
+     *
+     * Seeking first jumps to the partition holding the target, then selects the target bucket in the high
+     * bits. Partitions are small, so this is a constant number of word operations.
+     */
+    class elias_fano_postings {
+      public:
+        /// @brief Number of documents per partition.
+        static constexpr uint32_t partition_size = 128;
+
+        /**
+         * @brief Construct an empty postings list.
+         */
+        elias_fano_postings() = default;
+
+        /**
+         * @brief Encodes a postings list.
+         *
+         * @param docs Strictly increasing doc ids.
+         * @return The encoded postings list.
+         */
+        static elias_fano_postings build(const std::vector<DocId> &docs);
+
+        /**
+         * @brief Returns the number of documents.
+         */
+        [[nodiscard]] size_t len() const { return len_; }
+
+        /**
+         * @brief Returns the size of the encoded doc ids, in bytes.
+         */
+        [[nodiscard]] size_t num_bytes() const;
+
+        /**
+         * @brief Returns a cursor positioned on the first document.
+         */
+        [[nodiscard]] elias_fano_cursor cursor() const;
+
+        /**
+         * @brief Writes the postings list.
+         *
+         * @param os Output stream.
+         * @return Number of bytes written.
+         */
+        uint64_t serialize(std::ostream &os) const;
+
+        /**
+         * @brief Reads a postings list.
+         *
+         * @param data Pointer to the serialized postings. It is advanced past the postings.
+         * @param end End of the readable region.
+         * @return The postings list.
+         */
+        static elias_fano_postings deserialize(const bridge::byte_t *&data, const bridge::byte_t *end);
+
+      private:
+        friend class elias_fano_cursor;
+
+        struct partition {
+            DocId base;        //!< Smallest doc id the partition may hold.
+            uint32_t size;     //!< Number of documents.
+            bool dense;        //!< Bitmap encoded.
+            uint8_t low_bits;  //!< Width of the Elias-Fano low part.
+            std::vector<uint64_t> lows;
+            std::vector<uint64_t> highs; //!< Unary high part, or the bitmap.
+        };
+
+        static partition encode(const DocId *docs, uint32_t size, DocId base);
+
+        std::vector<partition> partitions_;
+        std::vector<DocId> lasts_; //!< Last doc id of each partition, to locate a target.
+        size_t len_ = 0;
+    };
+
+    /**
+     * @brief Cursor over an elias_fano_postings.
+     * @warning The postings list must outlive the cursor.
+     */
+    class elias_fano_cursor : public doc_set {
+      public:
+        /**
+         * @brief Construct a cursor positioned on the first document.
+         */
+        explicit elias_fano_cursor(const elias_fano_postings &postings);
+
+        DocId advance() override;
+
+        [[nodiscard]] DocId doc() const override { return doc_; }
+
+        DocId seek(DocId target) override;
+
+        [[nodiscard]] uint32_t size_hint() const override { return static_cast<uint32_t>(postings_->len()); }
+
+      private:
+        /// @brief Positions the cursor on the first document of the partition at or after bit `from`.
+        DocId position(size_t partition, size_t from_bit, uint32_t index);
+
+        const elias_fano_postings *postings_;
+        size_t partition_ = 0;
+        size_t bit_ = 0;    //!< Position in the high part (or bitmap) of the current document.
+        uint32_t index_ = 0; //!< Index of the current document in its partition.
+        DocId doc_ = TERMINATED;
+    };
+
+} // namespace bridge::postings
+
+#endif // BRIDGE_ELIAS_FANO_HPP_
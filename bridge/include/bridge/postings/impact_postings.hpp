@@ -0,0 +1,136 @@
+// Copyright (c) 2021 Bridge Project (Marcos Pontes)
+
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to
+//  deal in the Software without restriction, including without limitation the
+//  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+//  sell copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+//  IN THE SOFTWARE.
+
+//! \brief Impact-ordered postings, where documents are grouped by their quantized score.
+
+#ifndef BRIDGE_IMPACT_POSTINGS_HPP_
+#define BRIDGE_IMPACT_POSTINGS_HPP_
+
+#include <ostream>
+#include <utility>
+#include <vector>
+
+#include "bridge/global.hpp"
+
+namespace bridge::postings {
+
+    /**
+     * @brief Linear quantization of scores into small integer impacts.
+     * @details Impacts are in [1, 2^bits - 1]: a posting always contributes to the score of its document.
+     */
+    class impact_quantizer {
+      public:
+        /**
+         * @brief Construct a new impact quantizer.
+         *
+         * @param max_score Largest score of the collection. Scores above it are clamped.
+         * @param bits Number of bits of an impact, between 1 and 8.
+         */
+        explicit impact_quantizer(Score max_score, uint8_t bits = 8);
+
+        /**
+         * @brief Quantize a score.
+         */
+        [[nodiscard]] uint8_t quantize(Score score) const;
+
+        /**
+         * @brief Approximate score of an impact.
+         */
+        [[nodiscard]] Score dequantize(uint8_t impact) const;
+
+      private:
+        Score max_score_;
+        uint8_t max_impact_;
+    };
+
+    /**
+     * @brief Documents of a term sharing the same impact, sorted by doc id.
+     */
+    struct impact_segment {
+        uint8_t impact;
+        std::vector<DocId> docs;
+
+        bool operator==(const impact_segment &other) const = default;
+    };
+
+    /**
+     * @brief Postings of a term grouped in impact segments, by decreasing impact.
+     *
+     * @details The serialized format is the number of segments followed by, for each segment,
+     * its impact (1 byte), its length and its doc ids delta-encoded, every integer being a vint.
+     */
+    class impact_postings {
+      public:
+        /**
+         * @brief Construct an empty postings list.
+         */
+        impact_postings() = default;
+
+        /**
+         * @brief Construct a postings list from its segments.
+         *
+         * @param segments Impact segments, by decreasing impact.
+         */
+        explicit impact_postings(std::vector<impact_segment> &&segments);
+
+        /**
+         * @brief Builds the impact-ordered postings of a term.
+         *
+         * @param scored Documents containing the term and their score (BM25 for instance).
+         * @param quantizer Quantizer shared by every term of the index.
+         * @return The impact-ordered postings.
+         */
+        static impact_postings build(const std::vector<std::pair<DocId, Score>> &scored,
+                                     const impact_quantizer &quantizer);
+
+        /**
+         * @brief Get the impact segments, by decreasing impact.
+         */
+        [[nodiscard]] const std::vector<impact_segment> &segments() const { return segments_; }
+
+        /**
+         * @brief Returns the number of documents in the postings list.
+         */
+        [[nodiscard]] size_t len() const;
+
+        /**
+         * @brief Writes the postings list.
+         *
+         * @param os Output stream.
+         * @return Number of bytes written.
+         */
+        uint64_t serialize(std::ostream &os) const;
+
+        /**
+         * @brief Reads a postings list.
+         *
+         * @param data Pointer to the serialized postings. It is advanced past the postings.
+         * @param end End of the readable region.
+         * @return The postings list.
+         */
+        static impact_postings deserialize(const bridge::byte_t *&data, const bridge::byte_t *end);
+
+      private:
+        std::vector<impact_segment> segments_;
+    };
+
+} // namespace bridge::postings
+
+#endif // BRIDGE_IMPACT_POSTINGS_HPP_
@@ -0,0 +1,124 @@
+// Copyright (c) 2021 Bridge Project (Marcos Pontes)
+
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to
+//  deal in the Software without restriction, including without limitation the
+//  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+//  sell copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+//  IN THE SOFTWARE.
+
+//! \brief Sorted dictionary of the terms of a field.
+
+#ifndef BRIDGE_TERM_DICTIONARY_HPP_
+#define BRIDGE_TERM_DICTIONARY_HPP_
+
+#include <optional>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "bridge/global.hpp"
+
+namespace bridge::postings {
+
+    /**
+     * @brief Terms of a field sorted by byte order, with their document frequency.
+     *
+     * @details The ordinal of a term is its rank in the dictionary, which is how term vectors and forward
+     * indexes refer to it. Terms are stored back to back in a single buffer, addressed by an offsets array.
+     *
+     * The serialized format is the number of terms, then each term as its length, its bytes and its
+     * document frequency, every integer being a vint.
+     */
+    class term_dictionary {
+      public:
+        /**
+         * @brief Construct an empty dictionary.
+         */
+        term_dictionary() = default;
+
+        /**
+         * @brief Builds a dictionary.
+         *
+         * @param terms Terms and their document frequency, in any order. Terms must be unique.
+         * @return The dictionary.
+         */
+        static term_dictionary build(std::vector<std::pair<std::string, uint64_t>> terms);
+
+        /**
+         * @brief Number of terms.
+         */
+        [[nodiscard]] uint32_t size() const { return static_cast<uint32_t>(doc_freqs_.size()); }
+
+        /**
+         * @brief Get the term of an ordinal.
+         */
+        [[nodiscard]] std::string_view term(uint32_t ordinal) const {
+            return {bytes_.data() + offsets_[ordinal], offsets_[ordinal + 1] - offsets_[ordinal]};
+        }
+
+        /**
+         * @brief Get the document frequency of an ordinal.
+         */
+        [[nodiscard]] uint64_t doc_freq(uint32_t ordinal) const { return doc_freqs_[ordinal]; }
+
+        /**
+         * @brief Ordinal of the first term greater or equal to a key, or size() if there is none.
+         */
+        [[nodiscard]] uint32_t lower_bound(std::string_view key) const;
+
+        /**
+         * @brief Ordinal of the first term greater or equal to a key, searching from an ordinal onward.
+         * @details Gallops from `from` before a binary search, so looking up sorted keys one after the other
+         * costs the log of the distance between their ordinals rather than the log of the dictionary size.
+         *
+         * @param key Key to look up.
+         * @param from Ordinal to start from. Every term before it must be lower than the key.
+         * @return The ordinal, or size() if there is none.
+         */
+        [[nodiscard]] uint32_t lower_bound(std::string_view key, uint32_t from) const;
+
+        /**
+         * @brief Ordinal of a term, if the dictionary holds it.
+         */
+        [[nodiscard]] std::optional<uint32_t> ordinal(std::string_view term) const;
+
+        /**
+         * @brief Writes the dictionary.
+         *
+         * @param os Output stream.
+         * @return Number of bytes written.
+         */
+        uint64_t serialize(std::ostream &os) const;
+
+        /**
+         * @brief Reads a dictionary.
+         *
+         * @param data Pointer to the serialized dictionary. It is advanced past it.
+         * @param end End of the readable region.
+         * @return The dictionary.
+         */
+        static term_dictionary deserialize(const bridge::byte_t *&data, const bridge::byte_t *end);
+
+      private:
+        std::string bytes_;
+        std::vector<uint32_t> offsets_{0};
+        std::vector<uint64_t> doc_freqs_;
+    };
+
+} // namespace bridge::postings
+
+#endif // BRIDGE_TERM_DICTIONARY_HPP_
@@ -0,0 +1,169 @@
+// Copyright (c) 2021 Bridge Project (Marcos Pontes)
+
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to
+//  deal in the Software without restriction, including without limitation the
+//  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+//  sell copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+//  IN THE SOFTWARE.
+
+//! \brief Per-document term vectors, used by highlighting and more-like-this.
+
+#ifndef BRIDGE_TERM_VECTOR_HPP_
+#define BRIDGE_TERM_VECTOR_HPP_
+
+#include <memory>
+#include <ostream>
+#include <vector>
+
+#include "bridge/directory/directory.hpp"
+#include "bridge/global.hpp"
+#include "bridge/schema/options.hpp"
+
+namespace bridge::postings {
+
+    /**
+     * @brief Character offsets of one occurrence of a term: [from, to).
+     */
+    struct term_offset {
+        uint32_t from;
+        uint32_t to;
+
+        bool operator==(const term_offset &other) const = default;
+    };
+
+    /**
+     * @brief One term of a document term vector.
+     * @details Offsets are only filled when the field is indexed with offsets, in which case
+     * `offsets.size() == term_freq`.
+     */
+    struct term_vector_entry {
+        uint32_t term_ordinal;
+        uint32_t term_freq;
+        std::vector<term_offset> offsets;
+
+        bool operator==(const term_vector_entry &other) const = default;
+    };
+
+    /// @brief A document term vector is sorted by term ordinal.
+    using term_vector = std::vector<term_vector_entry>;
+
+    /**
+     * @brief Accumulates the tokens of a single document and builds its term vector.
+     */
+    class term_vector_builder {
+      public:
+        /**
+         * @brief Records one occurrence of a term.
+         *
+         * @param term_ordinal Ordinal of the term in the segment term dictionary.
+         * @param from Offset of the first character of the token.
+         * @param to Offset after the last character of the token.
+         */
+        void add_token(uint32_t term_ordinal, uint32_t from, uint32_t to);
+
+        /**
+         * @brief Builds the term vector and resets the builder.
+         *
+         * @return term_vector sorted by term ordinal.
+         */
+        term_vector build();
+
+      private:
+        std::vector<std::pair<uint32_t, term_offset>> tokens_;
+    };
+
+    /**
+     * @brief Serializes the term vectors of a segment.
+     *
+     * @details The file layout is:
+     * - the compressed term vector of each document, back to back;
+     * - the start address of each document (u64 little endian), plus the end address;
+     * - the number of documents (u32) and a flags byte telling whether offsets are stored.
+     *
+     * Inside a document, term ordinals are delta-encoded and every integer is a vint.
+     * Offsets are encoded as (from - previous to, to - from) pairs.
+     */
+    class term_vector_writer {
+      public:
+        /**
+         * @brief Construct a new term vector writer.
+         *
+         * @param option Indexing option of the field. It must enable term vectors.
+         */
+        explicit term_vector_writer(schema::text_indexing_option option);
+
+        /**
+         * @brief Adds the term vector of the next document.
+         * @details Documents must be added by increasing doc id. Skipped ids get an empty vector.
+         *
+         * @param doc Document id.
+         * @param vector Term vector of the document, sorted by term ordinal.
+         */
+        void add_document(DocId doc, const term_vector &vector);
+
+        /**
+         * @brief Writes the term vector file.
+         *
+         * @param os Output stream, usually opened by a Directory.
+         * @return Number of bytes written.
+         */
+        uint64_t serialize(std::ostream &os) const;
+
+      private:
+        bool with_offsets_;
+        std::vector<bridge::byte_t> data_;
+        std::vector<uint64_t> doc_addresses_;
+    };
+
+    /**
+     * @brief Random access reader over a term vector file.
+     */
+    class term_vector_reader {
+      public:
+        /**
+         * @brief Opens a term vector file.
+         *
+         * @param source Read only source holding the file written by term_vector_writer.
+         */
+        explicit term_vector_reader(std::shared_ptr<directory::read_only_source> source);
+
+        /**
+         * @brief Returns the number of documents in the file.
+         */
+        [[nodiscard]] uint32_t num_docs() const { return num_docs_; }
+
+        /**
+         * @brief Check if the file stores offsets.
+         */
+        [[nodiscard]] bool has_offsets() const { return with_offsets_; }
+
+        /**
+         * @brief Decodes the term vector of a document.
+         *
+         * @param doc Document id.
+         * @return term_vector The document term vector.
+         */
+        [[nodiscard]] term_vector get(DocId doc) const;
+
+      private:
+        std::shared_ptr<directory::read_only_source> source_;
+        const bridge::byte_t *addresses_;
+        uint32_t num_docs_;
+        bool with_offsets_;
+    };
+
+} // namespace bridge::postings
+
+#endif // BRIDGE_TERM_VECTOR_HPP_
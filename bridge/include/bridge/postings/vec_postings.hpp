@@ -0,0 +1,94 @@
+// Copyright (c) 2021 Bridge Project (Marcos Pontes)
+
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to
+//  deal in the Software without restriction, including without limitation the
+//  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+//  sell copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+//  IN THE SOFTWARE.
+
+//! \brief Postings cursors exposing term frequencies, and an in-memory implementation.
+
+#ifndef BRIDGE_VEC_POSTINGS_HPP_
+#define BRIDGE_VEC_POSTINGS_HPP_
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+#include "bridge/error.hpp"
+#include "bridge/global.hpp"
+#include "bridge/postings/doc_set.hpp"
+
+namespace bridge::postings {
+
+    /**
+     * @brief Cursor over the postings of a term, giving the frequency of the term in the current document.
+     */
+    class postings_cursor : public doc_set {
+      public:
+        /**
+         * @brief Returns the frequency of the term in the current document.
+         */
+        [[nodiscard]] virtual uint32_t term_freq() const = 0;
+    };
+
+    /**
+     * @brief Postings held in memory, as sorted (doc id, term frequency) pairs.
+     */
+    class vec_postings : public postings_cursor {
+      public:
+        /**
+         * @brief Construct a new cursor.
+         *
+         * @param postings Documents and term frequencies, by strictly increasing doc id.
+         */
+        explicit vec_postings(std::vector<std::pair<DocId, uint32_t>> postings) : postings_(std::move(postings)) {
+            for (size_t i = 1; i < postings_.size(); i++) {
+                if (postings_[i - 1].first >= postings_[i].first) {
+                    throw bridge_error("Postings must be sorted by strictly increasing doc id");
+                }
+            }
+        }
+
+        DocId advance() override {
+            if (cursor_ < postings_.size()) {
+                cursor_++;
+            }
+            return doc();
+        }
+
+        [[nodiscard]] DocId doc() const override {
+            return cursor_ < postings_.size() ? postings_[cursor_].first : TERMINATED;
+        }
+
+        DocId seek(DocId target) override {
+            auto it = std::lower_bound(postings_.begin() + static_cast<long>(cursor_), postings_.end(), target,
+                                       [](const std::pair<DocId, uint32_t> &p, DocId t) { return p.first < t; });
+            cursor_ = it - postings_.begin();
+            return doc();
+        }
+
+        [[nodiscard]] uint32_t size_hint() const override { return static_cast<uint32_t>(postings_.size()); }
+
+        [[nodiscard]] uint32_t term_freq() const override { return postings_[cursor_].second; }
+
+      private:
+        std::vector<std::pair<DocId, uint32_t>> postings_;
+        size_t cursor_ = 0;
+    };
+
+} // namespace bridge::postings
+
+#endif // BRIDGE_VEC_POSTINGS_HPP_
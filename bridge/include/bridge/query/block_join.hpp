@@ -0,0 +1,123 @@
+// Copyright (c) 2021 Bridge Project (Marcos Pontes)
+
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to
+//  deal in the Software without restriction, including without limitation the
+//  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+//  sell copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+//  IN THE SOFTWARE.
+
+//! \brief Block joins between nested documents and their parents.
+
+#ifndef BRIDGE_BLOCK_JOIN_HPP_
+#define BRIDGE_BLOCK_JOIN_HPP_
+
+#include <memory>
+
+#include "bridge/global.hpp"
+#include "bridge/postings/bit_set.hpp"
+#include "bridge/query/scorer.hpp"
+
+namespace bridge::query {
+
+    /**
+     * @brief How the scores of the matching children of a parent make its score.
+     */
+    enum class block_join_score_mode : uint8_t { None, Avg, Max, Min, Total };
+
+    /**
+     * @brief Matches the parents having at least one child matching a query.
+     *
+     * @details Blocks are laid out as children followed by their parent (see index::nested_block_writer). The
+     * parent of a matching child is the next document of the parent bit set; every matching child up to it
+     * is consumed to compute the score of the parent. Seeking to a parent seeks the child scorer to the first
+     * document after the previous parent, so blocks that cannot match are skipped with the child postings.
+     */
+    class to_parent_scorer : public scorer {
+      public:
+        /**
+         * @brief Construct a new scorer.
+         *
+         * @param children Scorer of the child query. It must only match children.
+         * @param parents Parent bit set of the segment. It must outlive the scorer.
+         * @param mode Aggregation of the child scores.
+         */
+        to_parent_scorer(std::unique_ptr<scorer> children, const postings::bit_set &parents,
+                         block_join_score_mode mode = block_join_score_mode::Avg);
+
+        DocId advance() override;
+
+        [[nodiscard]] DocId doc() const override { return doc_; }
+
+        DocId seek(DocId target) override;
+
+        [[nodiscard]] uint32_t size_hint() const override { return children_->size_hint(); }
+
+        [[nodiscard]] Score score() const override { return score_; }
+
+        /**
+         * @brief Number of matching children of the current parent.
+         */
+        [[nodiscard]] uint32_t num_children() const { return num_children_; }
+
+      private:
+        /// @brief Consumes the block of the current child and moves to its parent.
+        DocId next_parent();
+
+        std::unique_ptr<scorer> children_;
+        const postings::bit_set *parents_;
+        block_join_score_mode mode_;
+        DocId doc_ = postings::TERMINATED;
+        Score score_ = 0.0F;
+        uint32_t num_children_ = 0;
+    };
+
+    /**
+     * @brief Matches the children of the parents matching a query.
+     * @details Children get the score of their parent. The parent documents themselves are not matched.
+     */
+    class to_child_scorer : public scorer {
+      public:
+        /**
+         * @brief Construct a new scorer.
+         *
+         * @param parents_query Scorer of the parent query. It must only match parents.
+         * @param parents Parent bit set of the segment. It must outlive the scorer.
+         */
+        to_child_scorer(std::unique_ptr<scorer> parents_query, const postings::bit_set &parents);
+
+        DocId advance() override;
+
+        [[nodiscard]] DocId doc() const override { return doc_; }
+
+        DocId seek(DocId target) override;
+
+        [[nodiscard]] uint32_t size_hint() const override { return parents_query_->size_hint(); }
+
+        [[nodiscard]] Score score() const override { return score_; }
+
+      private:
+        /// @brief Moves to the first child, not below min_doc, of the current parent or of the next ones.
+        DocId first_child(DocId min_doc);
+
+        std::unique_ptr<scorer> parents_query_;
+        const postings::bit_set *parents_;
+        DocId doc_ = postings::TERMINATED;
+        DocId parent_ = postings::TERMINATED;
+        Score score_ = 0.0F;
+    };
+
+} // namespace bridge::query
+
+#endif // BRIDGE_BLOCK_JOIN_HPP_
@@ -0,0 +1,111 @@
+// Copyright (c) 2021 Bridge Project (Marcos Pontes)
+
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to
+//  deal in the Software without restriction, including without limitation the
+//  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+//  sell copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+//  IN THE SOFTWARE.
+
+//! \brief BM25F scoring of a query over several fields.
+
+#ifndef BRIDGE_BM25F_SCORER_HPP_
+#define BRIDGE_BM25F_SCORER_HPP_
+
+#include <memory>
+#include <vector>
+
+#include "bridge/global.hpp"
+#include "bridge/postings/vec_postings.hpp"
+#include "bridge/query/scorer.hpp"
+#include "bridge/scoring/bm25.hpp"
+
+namespace bridge::query {
+
+    /**
+     * @brief A field searched by a BM25F query.
+     */
+    struct bm25f_field {
+        Score weight;                             //!< Boost of the field, e.g. 3 for the title.
+        const std::vector<uint32_t> *field_norms; //!< Number of tokens of the field, by doc id.
+        Score average_field_norm;                 //!< Average number of tokens of the field.
+        Score b = scoring::default_b;             //!< Length normalization of the field.
+    };
+
+    /**
+     * @brief A query term and its postings in every field.
+     */
+    struct bm25f_term {
+        Score idf; //!< Idf of the term, over the documents holding it in any field.
+        std::vector<std::unique_ptr<postings::postings_cursor>> postings; //!< By field, null if absent.
+    };
+
+    /**
+     * @brief Disjunctive BM25F scorer.
+     *
+     * @details The frequencies of a term in every field are normalized by the length of their field, weighted
+     * and summed into a single pseudo frequency, which is then saturated once:
+     *
+     *     tf(t, d) = sum_f weight_f * tf_f(t, d) / (1 - b_f + b_f * len_f(d) / avg_len_f)
+     *     score(d) = sum_t idf(t) * (k1 + 1) * tf(t, d) / (k1 + tf(t, d))
+     *
+     * Unlike a disjunction of per-field BM25 queries, the cursors of every (term, field) pair are walked
+     * together, so each matching document is visited once and its length normalization is computed once
+     * per field.
+     */
+    class bm25f_scorer : public scorer {
+      public:
+        /**
+         * @brief Construct a new scorer, positioned on the first matching document.
+         *
+         * @param fields Searched fields.
+         * @param terms Query terms, each one with a postings cursor for each field.
+         * @param k1 Saturation parameter.
+         */
+        bm25f_scorer(std::vector<bm25f_field> fields, std::vector<bm25f_term> terms, Score k1 = scoring::default_k1);
+
+        DocId advance() override;
+
+        [[nodiscard]] DocId doc() const override { return doc_; }
+
+        DocId seek(DocId target) override;
+
+        [[nodiscard]] uint32_t size_hint() const override;
+
+        /**
+         * @brief Score of the current document.
+         */
+        [[nodiscard]] Score score() const override;
+
+      private:
+        struct cursor_entry {
+            uint32_t term;
+            uint32_t field;
+            postings::postings_cursor *cursor;
+        };
+
+        DocId next_doc() const;
+
+        std::vector<bm25f_field> fields_;
+        std::vector<bm25f_term> terms_;
+        std::vector<cursor_entry> cursors_;
+        mutable std::vector<Score> norms_;        // scratch: length normalization by field
+        mutable std::vector<Score> pseudo_freqs_; // scratch: pseudo frequency by term
+        Score k1_;
+        DocId doc_ = postings::TERMINATED;
+    };
+
+} // namespace bridge::query
+
+#endif // BRIDGE_BM25F_SCORER_HPP_
@@ -0,0 +1,108 @@
+// Copyright (c) 2021 Bridge Project (Marcos Pontes)
+
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to
+//  deal in the Software without restriction, including without limitation the
+//  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+//  sell copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+//  IN THE SOFTWARE.
+
+//! \brief Conjunction of scorers, driven by their cheap approximations.
+
+#ifndef BRIDGE_CONJUNCTION_HPP_
+#define BRIDGE_CONJUNCTION_HPP_
+
+#include <memory>
+#include <vector>
+
+#include "bridge/global.hpp"
+#include "bridge/query/scorer.hpp"
+
+namespace bridge::query {
+
+    /**
+     * @brief Documents of every one of several doc sets, found by leapfrogging.
+     * @details The first doc set leads: every other one is sought to its document, and the lead is sought to
+     * the first one that overshoots. The doc sets are not owned.
+     */
+    class doc_set_intersection : public postings::doc_set {
+      public:
+        /**
+         * @brief Construct a new intersection.
+         *
+         * @param sets Doc sets to intersect, the sparsest first. They must outlive the intersection.
+         */
+        explicit doc_set_intersection(std::vector<postings::doc_set *> sets);
+
+        DocId advance() override;
+
+        [[nodiscard]] DocId doc() const override { return doc_; }
+
+        DocId seek(DocId target) override;
+
+        [[nodiscard]] uint32_t size_hint() const override { return sets_.front()->size_hint(); }
+
+      private:
+        /// @brief Moves every doc set to the first document they all hold, from a document of the lead.
+        DocId align(DocId doc);
+
+        std::vector<postings::doc_set *> sets_;
+        DocId doc_ = postings::TERMINATED;
+    };
+
+    /**
+     * @brief Documents matching every one of several scorers, scored by the sum of their scores.
+     *
+     * @details The scorers are intersected through their approximations, the sparsest leading, and the
+     * two-phase confirmations run only on the documents all approximations agree on, cheapest first. Expensive
+     * checks such as reading positions or computing distances are thus skipped for documents a cheap clause
+     * rejects. The conjunction is two-phase itself when one of its scorers is, so nested conjunctions defer
+     * their confirmations as well.
+     */
+    class conjunction_scorer : public scorer, private postings::two_phase_iterator {
+      public:
+        /**
+         * @brief Construct a new scorer.
+         *
+         * @param scorers Clauses, at least one.
+         */
+        explicit conjunction_scorer(std::vector<std::unique_ptr<scorer>> scorers);
+
+        DocId advance() override;
+
+        [[nodiscard]] DocId doc() const override { return approximation_.doc(); }
+
+        DocId seek(DocId target) override;
+
+        [[nodiscard]] uint32_t size_hint() const override { return approximation_.size_hint(); }
+
+        [[nodiscard]] Score score() const override;
+
+        [[nodiscard]] postings::two_phase_iterator *two_phase() override { return phases_.empty() ? nullptr : this; }
+
+      private:
+        [[nodiscard]] postings::doc_set &approximation() override { return approximation_; }
+
+        [[nodiscard]] bool matches() override;
+
+        [[nodiscard]] float match_cost() const override;
+
+        std::vector<std::unique_ptr<scorer>> scorers_;
+        std::vector<postings::two_phase_iterator *> phases_;
+        doc_set_intersection approximation_;
+    };
+
+} // namespace bridge::query
+
+#endif // BRIDGE_CONJUNCTION_HPP_
@@ -0,0 +1,229 @@
+// Copyright (c) 2021 Bridge Project (Marcos Pontes)
+
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to
+//  deal in the Software without restriction, including without limitation the
+//  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+//  sell copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+//  IN THE SOFTWARE.
+
+//! \brief Function score: relevance mixed with functions of the fast fields of a document.
+
+#ifndef BRIDGE_FUNCTION_SCORE_HPP_
+#define BRIDGE_FUNCTION_SCORE_HPP_
+
+#include <array>
+#include <memory>
+#include <vector>
+
+#include "bridge/fastfield/numeric_column.hpp"
+#include "bridge/global.hpp"
+#include "bridge/query/scorer.hpp"
+
+namespace bridge::query {
+
+    /**
+     * @brief A function of the fast fields of a document.
+     * @details Functions are evaluated on a block of documents at once, so that the values are read from their
+     * columns in a first loop and the math runs in a second, tight loop the compiler vectorizes.
+     */
+    class score_function {
+      public:
+        /**
+         * @brief Virtual destructor for score_function.
+         */
+        virtual ~score_function() = default;
+
+        /**
+         * @brief Evaluates the function on a block of documents.
+         *
+         * @param docs Documents, at most block_size of them.
+         * @param count Number of documents.
+         * @param out Value of the function for each document.
+         */
+        virtual void evaluate(const DocId *docs, size_t count, Score *out) const = 0;
+
+        /// @brief Maximum number of documents evaluated at once.
+        static constexpr size_t block_size = 64;
+    };
+
+    /**
+     * @brief Shape of a decay function.
+     */
+    enum class decay_kind : uint8_t { Linear = 0, Exp = 1, Gauss = 2 };
+
+    /**
+     * @brief Decay of a score with the distance between a value and an origin.
+     *
+     * @details Distances under the offset are not penalized. Beyond it, the function is worth `decay` at
+     * `offset + scale`, falling linearly, exponentially or as a gaussian depending on its kind.
+     */
+    class decay_function : public score_function {
+      public:
+        /**
+         * @brief Construct a new decay function over a numeric column, e.g. a date.
+         *
+         * @param kind Shape of the decay.
+         * @param column Values of the documents. It must outlive the function.
+         * @param origin Value with no penalty.
+         * @param scale Distance from the offset where the function is worth decay.
+         * @param offset Distance under which documents are not penalized.
+         * @param decay Value of the function at offset + scale, in (0, 1).
+         */
+        decay_function(decay_kind kind, const fastfield::numeric_column &column, double origin, double scale,
+                       double offset = 0.0, double decay = 0.5);
+
+        void evaluate(const DocId *docs, size_t count, Score *out) const override;
+
+      protected:
+        decay_function(decay_kind kind, double scale, double offset, double decay);
+
+        /// @brief Turns a block of distances into function values.
+        void decay_distances(const double *distances, size_t count, Score *out) const;
+
+      private:
+        const fastfield::numeric_column *column_ = nullptr;
+        decay_kind kind_;
+        double origin_ = 0.0;
+        double offset_;
+        double factor_; // ln(decay) / scale, ln(decay) / scale^2 or (1 - decay) / scale
+    };
+
+    /**
+     * @brief Decay of a score with the distance between a location and an origin, in meters.
+     */
+    class geo_decay_function : public decay_function {
+      public:
+        /**
+         * @brief Construct a new geo decay function.
+         *
+         * @param kind Shape of the decay.
+         * @param latitudes Latitudes of the documents, in degrees.
+         * @param longitudes Longitudes of the documents, in degrees.
+         * @param origin_latitude Latitude of the origin, in degrees.
+         * @param origin_longitude Longitude of the origin, in degrees.
+         * @param scale Distance from the offset where the function is worth decay, in meters.
+         * @param offset Distance under which documents are not penalized, in meters.
+         * @param decay Value of the function at offset + scale, in (0, 1).
+         */
+        geo_decay_function(decay_kind kind, const fastfield::numeric_column &latitudes,
+                           const fastfield::numeric_column &longitudes, double origin_latitude,
+                           double origin_longitude, double scale, double offset = 0.0, double decay = 0.5);
+
+        void evaluate(const DocId *docs, size_t count, Score *out) const override;
+
+      private:
+        const fastfield::numeric_column *latitudes_;
+        const fastfield::numeric_column *longitudes_;
+        double origin_latitude_;
+        double origin_longitude_;
+    };
+
+    /**
+     * @brief Modifier applied to a field value.
+     */
+    enum class value_modifier : uint8_t { None, Log, Log1p, Log2p, Ln, Ln1p, Ln2p, Square, Sqrt, Reciprocal };
+
+    /**
+     * @brief A field value, e.g. a popularity, scaled by a factor and modified: modifier(factor * value).
+     */
+    class field_value_factor : public score_function {
+      public:
+        /**
+         * @brief Construct a new field value factor.
+         *
+         * @param column Values of the documents. It must outlive the function.
+         * @param factor Factor applied to the value.
+         * @param modifier Modifier applied to the scaled value.
+         */
+        explicit field_value_factor(const fastfield::numeric_column &column, double factor = 1.0,
+                                    value_modifier modifier = value_modifier::None);
+
+        void evaluate(const DocId *docs, size_t count, Score *out) const override;
+
+      private:
+        const fastfield::numeric_column *column_;
+        double factor_;
+        value_modifier modifier_;
+    };
+
+    /**
+     * @brief How the values of several functions are combined.
+     */
+    enum class score_mode : uint8_t { Multiply, Sum, Avg, Max, Min };
+
+    /**
+     * @brief How the combined function value and the query score are combined.
+     */
+    enum class boost_mode : uint8_t { Multiply, Sum, Replace, Avg, Max, Min };
+
+    /**
+     * @brief Wraps a scorer and mixes its score with functions of the fast fields.
+     *
+     * @details When iterated with advance, matching documents are pulled from the wrapped scorer a block at a
+     * time, every function is evaluated on the whole block, and the documents are then served from the block.
+     * A seek past the block only moves the wrapped scorer, and the functions are evaluated on that single
+     * document once its score is read, so that a conjunction skipping most documents does not pay for them.
+     */
+    class function_score_scorer : public scorer {
+      public:
+        /**
+         * @brief Construct a new function score scorer, positioned on the first matching document.
+         *
+         * @param inner Scorer of the wrapped query.
+         * @param functions Functions of the fast fields.
+         * @param functions_mode How the function values are combined.
+         * @param query_mode How the combined function value and the query score are combined.
+         */
+        function_score_scorer(std::unique_ptr<scorer> inner, std::vector<std::unique_ptr<score_function>> functions,
+                              score_mode functions_mode = score_mode::Multiply,
+                              boost_mode query_mode = boost_mode::Multiply);
+
+        DocId advance() override;
+
+        [[nodiscard]] DocId doc() const override {
+            return position_ < count_ ? docs_[position_] : postings::TERMINATED;
+        }
+
+        DocId seek(DocId target) override;
+
+        [[nodiscard]] uint32_t size_hint() const override { return inner_->size_hint(); }
+
+        [[nodiscard]] Score score() const override;
+
+      private:
+        void refill();
+
+        /// @brief Serves the current document of the wrapped scorer alone, scoring it on demand.
+        void hold_inner();
+
+        /// @brief Mixes the function values into the query scores of the first count buffered documents.
+        void apply_functions(size_t count) const;
+
+        std::unique_ptr<scorer> inner_;
+        std::vector<std::unique_ptr<score_function>> functions_;
+        score_mode functions_mode_;
+        boost_mode query_mode_;
+
+        std::array<DocId, score_function::block_size> docs_{};
+        mutable std::array<Score, score_function::block_size> scores_{};
+        size_t count_ = 0;
+        size_t position_ = 0;
+        bool holds_inner_ = false;      // the buffer is the current document of the wrapped scorer
+        mutable bool unscored_ = false; // its score is not computed yet
+    };
+
+} // namespace bridge::query
+
+#endif // BRIDGE_FUNCTION_SCORE_HPP_
@@ -0,0 +1,102 @@
+// Copyright (c) 2021 Bridge Project (Marcos Pontes)
+
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to
+//  deal in the Software without restriction, including without limitation the
+//  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+//  sell copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+//  IN THE SOFTWARE.
+
+//! \brief Disjunction requiring a minimum number of matching clauses.
+
+#ifndef BRIDGE_MIN_SHOULD_MATCH_HPP_
+#define BRIDGE_MIN_SHOULD_MATCH_HPP_
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "bridge/global.hpp"
+#include "bridge/query/scorer.hpp"
+
+namespace bridge::query {
+
+    /**
+     * @brief Documents matching at least `minimum_should_match` of several scorers, scored by the sum of the
+     * scores of the matching ones.
+     *
+     * @details Clauses that are not on the current document wait in a heap ordered by doc id. The m-th
+     * smallest doc id of the heap bounds the next match: fewer than m clauses can match any document before
+     * it, so the m - 1 clauses behind are sought straight to it instead of being advanced one document at a
+     * time. A document is a match once the m first clauses of the heap agree on it; every clause on it then
+     * contributes to its score.
+     *
+     * With m = 1, the scorer is a plain disjunction. Long queries that require, say, 70% of their terms only
+     * visit the documents where the rarest terms overlap, instead of scoring every document of the union.
+     */
+    class min_should_match_scorer : public scorer {
+      public:
+        /**
+         * @brief Construct a new scorer.
+         *
+         * @param scorers Should clauses.
+         * @param minimum_should_match Number of clauses a document must match, at least 1. Nothing matches
+         * when it is greater than the number of clauses.
+         */
+        min_should_match_scorer(std::vector<std::unique_ptr<scorer>> scorers, uint32_t minimum_should_match);
+
+        /**
+         * @brief Number of clauses required for a percentage of them, rounded down but at least 1.
+         *
+         * @param num_clauses Number of clauses.
+         * @param percentage Required share of the clauses, in [0, 100].
+         */
+        static uint32_t from_percentage(size_t num_clauses, double percentage);
+
+        DocId advance() override;
+
+        [[nodiscard]] DocId doc() const override { return doc_; }
+
+        DocId seek(DocId target) override;
+
+        [[nodiscard]] uint32_t size_hint() const override;
+
+        [[nodiscard]] Score score() const override;
+
+        /**
+         * @brief Number of clauses matching the current document.
+         */
+        [[nodiscard]] uint32_t num_matches() const { return static_cast<uint32_t>(lead_.size()); }
+
+      private:
+        /// @brief Adds a clause to the heap, unless it is exhausted.
+        void push(uint32_t clause);
+
+        /// @brief Removes the clause with the smallest doc id from the heap.
+        uint32_t pop();
+
+        /// @brief Moves to the next match from the clauses of the heap.
+        DocId next_match();
+
+        std::vector<std::unique_ptr<scorer>> scorers_;
+        uint32_t minimum_;
+        std::vector<std::pair<DocId, uint32_t>> heap_; // (doc id, clause), min-heap on the doc id
+        std::vector<uint32_t> lead_;                   // clauses on the current document
+        std::vector<uint32_t> tail_;                   // clauses popped while looking for a match
+        DocId doc_ = postings::TERMINATED;
+    };
+
+} // namespace bridge::query
+
+#endif // BRIDGE_MIN_SHOULD_MATCH_HPP_
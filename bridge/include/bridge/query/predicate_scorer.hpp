@@ -0,0 +1,84 @@
+// Copyright (c) 2021 Bridge Project (Marcos Pontes)
+
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to
+//  deal in the Software without restriction, including without limitation the
+//  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+//  sell copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+//  IN THE SOFTWARE.
+
+//! \brief Scorer filtered by an expensive per-document check.
+
+#ifndef BRIDGE_PREDICATE_SCORER_HPP_
+#define BRIDGE_PREDICATE_SCORER_HPP_
+
+#include <functional>
+#include <memory>
+
+#include "bridge/global.hpp"
+#include "bridge/query/scorer.hpp"
+
+namespace bridge::query {
+
+    /// @brief Per-document check, e.g. a script, a geo distance or a regex on a fast field.
+    using doc_predicate = std::function<bool(DocId)>;
+
+    /**
+     * @brief Documents of a scorer that pass a predicate, with the score of the scorer.
+     *
+     * @details The scorer is the approximation and the predicate the confirmation of a two-phase iterator, so
+     * in a conjunction the predicate only runs on documents every other clause matches. When the inner scorer
+     * is two-phase itself, its approximation is used and its confirmation runs before the predicate.
+     */
+    class predicate_scorer : public scorer, private postings::two_phase_iterator {
+      public:
+        /**
+         * @brief Construct a new scorer.
+         *
+         * @param inner Documents to filter, with their score.
+         * @param predicate The check.
+         * @param cost Estimated cost of the check, in the number of operations it takes.
+         */
+        predicate_scorer(std::unique_ptr<scorer> inner, doc_predicate predicate, float cost);
+
+        DocId advance() override;
+
+        [[nodiscard]] DocId doc() const override { return approximation_->doc(); }
+
+        DocId seek(DocId target) override;
+
+        [[nodiscard]] uint32_t size_hint() const override { return inner_->size_hint(); }
+
+        [[nodiscard]] Score score() const override { return inner_->score(); }
+
+        [[nodiscard]] postings::two_phase_iterator *two_phase() override { return this; }
+
+      private:
+        [[nodiscard]] postings::doc_set &approximation() override { return *approximation_; }
+
+        [[nodiscard]] bool matches() override;
+
+        [[nodiscard]] float match_cost() const override;
+
+        std::unique_ptr<scorer> inner_;
+        postings::two_phase_iterator *inner_phase_;
+        postings::doc_set *approximation_;
+        doc_predicate predicate_;
+        float cost_;
+        DocId confirmed_ = postings::TERMINATED;
+    };
+
+} // namespace bridge::query
+
+#endif // BRIDGE_PREDICATE_SCORER_HPP_
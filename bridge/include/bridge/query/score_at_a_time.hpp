@@ -0,0 +1,103 @@
+// Copyright (c) 2021 Bridge Project (Marcos Pontes)
+
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to
+//  deal in the Software without restriction, including without limitation the
+//  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+//  sell copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+//  IN THE SOFTWARE.
+
+//! \brief Score-at-a-time evaluation over impact-ordered postings.
+
+#ifndef BRIDGE_SCORE_AT_A_TIME_HPP_
+#define BRIDGE_SCORE_AT_A_TIME_HPP_
+
+#include <limits>
+#include <vector>
+
+#include "bridge/global.hpp"
+#include "bridge/postings/impact_postings.hpp"
+
+namespace bridge::query {
+
+    /**
+     * @brief A document and its accumulated impact.
+     */
+    struct impact_hit {
+        DocId doc;
+        uint32_t score;
+
+        bool operator==(const impact_hit &other) const = default;
+    };
+
+    /**
+     * @brief Anytime top-k evaluator for disjunctive queries.
+     *
+     * @details Impact segments of every query term are processed from the highest impact to the lowest,
+     * adding the impact of each posting to a per-document accumulator. Evaluation stops once the budget of
+     * postings is spent, so the top-k is exact with an unlimited budget and an approximation otherwise,
+     * built from the postings that matter the most.
+     *
+     * The evaluator keeps its accumulators between queries. It is not thread safe.
+     */
+    class score_at_a_time {
+      public:
+        /// @brief Budget that processes every posting.
+        static constexpr uint64_t unlimited = std::numeric_limits<uint64_t>::max();
+
+        /**
+         * @brief Construct a new evaluator.
+         *
+         * @param max_doc Number of documents of the segment.
+         */
+        explicit score_at_a_time(DocId max_doc);
+
+        /**
+         * @brief Adds a query term.
+         *
+         * @param postings Impact-ordered postings of the term. They must outlive the evaluation.
+         * @param query_weight Multiplier of the term impacts, e.g. its frequency in the query. Must be positive.
+         * @throws bridge_error if the weight is zero or a doc id is out of the segment range.
+         */
+        void add_term(const postings::impact_postings &postings, uint32_t query_weight = 1);
+
+        /**
+         * @brief Evaluates the query and clears the terms.
+         *
+         * @param k Number of hits to return.
+         * @param budget Maximum number of postings to process.
+         * @return The best hits by decreasing score, ties broken by doc id.
+         */
+        std::vector<impact_hit> top_k(size_t k, uint64_t budget = unlimited);
+
+        /**
+         * @brief Number of postings processed by the last evaluation.
+         */
+        [[nodiscard]] uint64_t processed() const { return processed_; }
+
+      private:
+        struct pending_segment {
+            uint32_t impact;
+            const postings::impact_segment *segment;
+        };
+
+        std::vector<uint32_t> accumulators_;
+        std::vector<DocId> touched_;
+        std::vector<pending_segment> pending_;
+        uint64_t processed_ = 0;
+    };
+
+} // namespace bridge::query
+
+#endif // BRIDGE_SCORE_AT_A_TIME_HPP_
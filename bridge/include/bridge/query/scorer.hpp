@@ -0,0 +1,44 @@
+// Copyright (c) 2021 Bridge Project (Marcos Pontes)
+
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to
+//  deal in the Software without restriction, including without limitation the
+//  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+//  sell copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+//  IN THE SOFTWARE.
+
+//! \brief Cursor over matching documents that scores them.
+
+#ifndef BRIDGE_SCORER_HPP_
+#define BRIDGE_SCORER_HPP_
+
+#include "bridge/global.hpp"
+#include "bridge/postings/doc_set.hpp"
+
+namespace bridge::query {
+
+    /**
+     * @brief A doc_set over the documents matching a query, giving the score of the current document.
+     */
+    class scorer : public postings::doc_set {
+      public:
+        /**
+         * @brief Score of the current document.
+         */
+        [[nodiscard]] virtual Score score() const = 0;
+    };
+
+} // namespace bridge::query
+
+#endif // BRIDGE_SCORER_HPP_
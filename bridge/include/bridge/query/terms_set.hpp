@@ -0,0 +1,122 @@
+// Copyright (c) 2021 Bridge Project (Marcos Pontes)
+
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to
+//  deal in the Software without restriction, including without limitation the
+//  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+//  sell copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+//  IN THE SOFTWARE.
+
+//! \brief Filter on a large set of exact terms, e.g. the ids a user is allowed to see.
+
+#ifndef BRIDGE_TERMS_SET_HPP_
+#define BRIDGE_TERMS_SET_HPP_
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "bridge/global.hpp"
+#include "bridge/postings/doc_set.hpp"
+#include "bridge/postings/term_dictionary.hpp"
+
+namespace bridge::query {
+
+    /// @brief Opens the postings of a term of the dictionary, by ordinal.
+    using postings_opener = std::function<std::unique_ptr<postings::doc_set>(uint32_t ordinal)>;
+
+    /**
+     * @brief Documents of any of several doc sets.
+     * @details The next document is the minimum over every cursor, found with a linear scan: it is meant for
+     * a handful of cursors.
+     */
+    class doc_set_union : public postings::doc_set {
+      public:
+        /**
+         * @brief Construct a new union.
+         *
+         * @param sets Doc sets to merge.
+         */
+        explicit doc_set_union(std::vector<std::unique_ptr<postings::doc_set>> sets);
+
+        DocId advance() override;
+
+        [[nodiscard]] DocId doc() const override { return doc_; }
+
+        DocId seek(DocId target) override;
+
+        [[nodiscard]] uint32_t size_hint() const override;
+
+      private:
+        /// @brief Moves to the smallest current document of the cursors.
+        DocId update();
+
+        std::vector<std::unique_ptr<postings::doc_set>> sets_;
+        DocId doc_ = postings::TERMINATED;
+    };
+
+    /**
+     * @brief Filter matching the documents holding any term of a set.
+     *
+     * @details The terms are sorted and deduplicated once, when the filter is built. On each segment, the
+     * dictionary is then walked once from the lowest term to the highest, galloping from the ordinal of the
+     * previous term, so looking up n terms costs far less than n independent searches.
+     *
+     * Up to `union_threshold` matching terms, the filter is a union of their postings cursors. Beyond, merging
+     * the cursors would cost more per document than the postings themselves, so every postings list is rather
+     * OR-ed into a bit set of the segment in a single pass, and the filter iterates the bits.
+     */
+    class terms_set {
+      public:
+        /// @brief Default number of matching terms above which postings are OR-ed into a bit set.
+        static constexpr size_t default_union_threshold = 16;
+
+        /**
+         * @brief Construct a new filter.
+         *
+         * @param terms Terms, in any order, duplicates allowed.
+         */
+        explicit terms_set(std::vector<std::string> terms);
+
+        /**
+         * @brief Number of distinct terms.
+         */
+        [[nodiscard]] size_t size() const { return terms_.size(); }
+
+        /**
+         * @brief Ordinals of the terms of the set found in a dictionary, in increasing order.
+         */
+        [[nodiscard]] std::vector<uint32_t> ordinals(const postings::term_dictionary &dictionary) const;
+
+        /**
+         * @brief Matching documents of a segment.
+         *
+         * @param dictionary Dictionary of the field in the segment.
+         * @param open Opens the postings of a term of the dictionary.
+         * @param max_doc Number of documents of the segment.
+         * @param union_threshold Number of matching terms above which a bit set is built.
+         * @return The matching documents.
+         */
+        [[nodiscard]] std::unique_ptr<postings::doc_set>
+        matching_docs(const postings::term_dictionary &dictionary, const postings_opener &open, DocId max_doc,
+                      size_t union_threshold = default_union_threshold) const;
+
+      private:
+        std::vector<std::string> terms_;
+    };
+
+} // namespace bridge::query
+
+#endif // BRIDGE_TERMS_SET_HPP_
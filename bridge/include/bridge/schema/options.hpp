@@ -49,6 +49,8 @@ namespace bridge::schema {
             TokenizedNoFreq = 2,
             TokenizedWithFreq = 3,
             TokenizedWithFreqAndPosition = 4,
+            TokenizedWithTermVector = 5,
+            TokenizedWithTermVectorAndOffsets = 6,
         };
 
         /**
@@ -114,7 +116,8 @@ namespace bridge::schema {
          * @return True if term frequencies are enabled, false otherwise.
          */
         [[nodiscard]] constexpr bool is_termfreq_enabled() const {
-            return _index_options == TokenizedWithFreq || _index_options == TokenizedWithFreqAndPosition;
+            return _index_options == TokenizedWithFreq || _index_options == TokenizedWithFreqAndPosition ||
+                   is_term_vector_enabled();
         }
 
         /**
@@ -124,7 +127,7 @@ namespace bridge::schema {
          */
         [[nodiscard]] constexpr bool is_tokenized() const {
             return _index_options == TokenizedNoFreq || _index_options == TokenizedWithFreq ||
-                   _index_options == TokenizedWithFreqAndPosition;
+                   _index_options == TokenizedWithFreqAndPosition || is_term_vector_enabled();
         }
 
         /**
@@ -133,7 +136,27 @@ namespace bridge::schema {
          * @return True if positions are enabled, false otherwise.
          */
         [[nodiscard]] constexpr bool is_position_enabled() const {
-            return _index_options == TokenizedWithFreqAndPosition;
+            return _index_options == TokenizedWithFreqAndPosition || is_term_vector_enabled();
+        }
+
+        /**
+         * @brief Check if the option stores a per-document term vector.
+         * @details Term vectors are opt-in: only fields that need highlighting or more-like-this should pay
+         * for the extra per-segment file.
+         *
+         * @return True if term vectors are enabled, false otherwise.
+         */
+        [[nodiscard]] constexpr bool is_term_vector_enabled() const {
+            return _index_options == TokenizedWithTermVector || _index_options == TokenizedWithTermVectorAndOffsets;
+        }
+
+        /**
+         * @brief Check if the term vector also stores the character offsets of each occurrence.
+         *
+         * @return True if offsets are enabled, false otherwise.
+         */
+        [[nodiscard]] constexpr bool is_offset_enabled() const {
+            return _index_options == TokenizedWithTermVectorAndOffsets;
         }
 
         /**
@@ -218,6 +241,32 @@ namespace bridge::schema {
         Value _index_options;
     };
 
+    /**
+     * @brief Codec used to encode the doc ids of the field postings.
+     * @details EliasFano suits very long and dense postings lists (stop-ish words, category terms):
+     * they compress better and seek faster than with the default codec.
+     */
+    enum class postings_codec : uint8_t {
+        Default = 0,
+        EliasFano = 1,
+    };
+
+    /**
+     * @brief Get the string representation of a postings codec.
+     *
+     * @param codec Postings codec.
+     * @return The string representation of the codec.
+     */
+    [[nodiscard]] std::string postings_codec_str(postings_codec codec);
+
+    /**
+     * @brief Constructs a postings codec from a string.
+     *
+     * @param str String representation of the codec.
+     * @return The postings codec.
+     */
+    [[nodiscard]] postings_codec postings_codec_from_str(const std::string &str);
+
     /**
      * @brief Options associated with a text field.
      *
@@ -325,6 +374,13 @@ namespace bridge::schema {
          */
         [[nodiscard]] constexpr bool is_stored() const { return stored; }
 
+        /**
+         * @brief Get the codec of the field postings.
+         *
+         * @return The postings codec.
+         */
+        [[nodiscard]] constexpr postings_codec get_postings_codec() const { return codec; }
+
         /**
          * @brief Set the indexing options.
          *
@@ -339,6 +395,13 @@ namespace bridge::schema {
          */
         [[maybe_unused]] void set_stored(bool is_stored);
 
+        /**
+         * @brief Set the codec of the field postings.
+         *
+         * @param postings_codec The new postings codec.
+         */
+        [[maybe_unused]] void set_postings_codec(postings_codec postings_codec);
+
         /**
          * @brief The | operator allows to combine two text_field.
          *
@@ -356,6 +419,9 @@ namespace bridge::schema {
         template <class Archive> void serialize(Archive &ar, [[maybe_unused]] const unsigned int version) {
             ar &indexing_options;
             ar &stored;
+            if (version > 0) {
+                ar &codec;
+            }
         }
 
         friend boost::serialization::access; //! Allow to access the private members of text_field.
@@ -385,6 +451,7 @@ namespace bridge::schema {
          */
         text_indexing_option indexing_options;
         bool stored; //! < True if the text_field is stored, false otherwise.
+        postings_codec codec = postings_codec::Default; //! < Codec of the field postings.
     };
 
     /**
@@ -548,4 +615,6 @@ namespace bridge::schema {
 
 } // namespace bridge::schema
 
+BRIDGE_SERIALIZE_VERSION(bridge::schema::text_field_option, 1)
+
 #endif
@@ -0,0 +1,98 @@
+// Copyright (c) 2021 Bridge Project (Marcos Pontes)
+
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to
+//  deal in the Software without restriction, including without limitation the
+//  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+//  sell copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+//  IN THE SOFTWARE.
+
+//! \brief Okapi BM25 similarity.
+
+#ifndef BRIDGE_BM25_HPP_
+#define BRIDGE_BM25_HPP_
+
+#include <cmath>
+#include <cstdint>
+
+#include "bridge/global.hpp"
+
+namespace bridge::scoring {
+
+    /// @brief Default BM25 saturation parameter.
+    static constexpr Score default_k1 = 1.2F;
+
+    /// @brief Default BM25 length normalization parameter.
+    static constexpr Score default_b = 0.75F;
+
+    /**
+     * @brief Inverse document frequency, as defined by BM25.
+     *
+     * @param doc_freq Number of documents containing the term.
+     * @param num_docs Number of documents in the collection.
+     * @return The idf of the term. It is always positive.
+     */
+    inline Score idf(uint64_t doc_freq, uint64_t num_docs) {
+        auto x = static_cast<double>(num_docs - doc_freq) + 0.5;
+        return static_cast<Score>(std::log(1.0 + x / (static_cast<double>(doc_freq) + 0.5)));
+    }
+
+    /**
+     * @brief Pre-computed BM25 weight of a term in a field.
+     * @details The weight holds everything that does not depend on the document, so scoring
+     * a (term_freq, field_norm) pair is a handful of floating point operations.
+     */
+    class bm25_weight {
+      public:
+        /**
+         * @brief Construct a new BM25 weight.
+         *
+         * @param doc_freq Number of documents containing the term.
+         * @param num_docs Number of documents in the collection.
+         * @param average_field_norm Average number of tokens of the field.
+         * @param k1 Saturation parameter.
+         * @param b Length normalization parameter.
+         */
+        explicit bm25_weight(uint64_t doc_freq, uint64_t num_docs, Score average_field_norm, Score k1 = default_k1,
+                             Score b = default_b)
+            : weight_(idf(doc_freq, num_docs) * (1.0F + k1)), average_field_norm_(average_field_norm), k1_(k1), b_(b) {}
+
+        /**
+         * @brief Score a document.
+         *
+         * @param term_freq Frequency of the term in the document.
+         * @param field_norm Number of tokens of the field in the document.
+         * @return BM25 score.
+         */
+        [[nodiscard]] Score score(uint32_t term_freq, uint32_t field_norm) const {
+            auto tf = static_cast<Score>(term_freq);
+            Score norm = k1_ * (1.0F - b_ + b_ * static_cast<Score>(field_norm) / average_field_norm_);
+            return weight_ * tf / (tf + norm);
+        }
+
+        /**
+         * @brief Upper bound of the score, reached for an infinite term frequency.
+         */
+        [[nodiscard]] Score max_score() const { return weight_; }
+
+      private:
+        Score weight_;
+        Score average_field_norm_;
+        Score k1_;
+        Score b_;
+    };
+
+} // namespace bridge::scoring
+
+#endif // BRIDGE_BM25_HPP_
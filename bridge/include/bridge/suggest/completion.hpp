@@ -0,0 +1,175 @@
+// Copyright (c) 2021 Bridge Project (Marcos Pontes)
+
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to
+//  deal in the Software without restriction, including without limitation the
+//  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+//  sell copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+//  IN THE SOFTWARE.
+
+//! \brief Completion suggester: best weighted completions of a prefix.
+
+#ifndef BRIDGE_COMPLETION_HPP_
+#define BRIDGE_COMPLETION_HPP_
+
+#include <functional>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "bridge/global.hpp"
+
+namespace bridge::suggest {
+
+    /// @brief Normalizes the inputs and the prefixes of a suggester.
+    using normalizer = std::function<std::string(std::string_view)>;
+
+    /**
+     * @brief Lower cases ASCII letters, the default normalizer.
+     */
+    std::string lowercase(std::string_view text);
+
+    /**
+     * @brief A completion and its weight.
+     */
+    struct suggestion {
+        std::string text;
+        uint64_t weight;
+
+        bool operator==(const suggestion &other) const = default;
+    };
+
+    class completion_suggester;
+
+    /**
+     * @brief Collects the entries of a completion suggester.
+     */
+    class completion_builder {
+      public:
+        /**
+         * @brief Construct a new builder.
+         *
+         * @param normalize Normalization of the inputs. Prefixes must be normalized the same way.
+         */
+        explicit completion_builder(normalizer normalize = lowercase);
+
+        /**
+         * @brief Adds a completion.
+         *
+         * @param input Text matched by the prefixes, normalized by the builder.
+         * @param output Text suggested when the input matches.
+         * @param weight Weight of the completion, the higher the better.
+         */
+        void add(std::string_view input, std::string output, uint64_t weight);
+
+        /**
+         * @brief Adds a completion suggesting its own input.
+         */
+        void add(std::string_view input, uint64_t weight) { add(input, std::string(input), weight); }
+
+        /**
+         * @brief Builds the suggester. The builder is left empty.
+         */
+        completion_suggester build();
+
+      private:
+        struct entry {
+            std::string key;
+            std::string output;
+            uint64_t weight;
+        };
+
+        normalizer normalize_;
+        std::vector<entry> entries_;
+    };
+
+    /**
+     * @brief Prefix tree of completions, searched best first.
+     *
+     * @details The tree is stored in flat arrays, in breadth-first order, so that the children of a node are
+     * contiguous and sorted by label. Each node holds the largest weight of its subtree.
+     *
+     * Looking for the top-k completions of a prefix walks down to the node of the prefix, then explores its
+     * subtree with a priority queue ordered by those maximum weights: a completion is returned as soon as no
+     * unexplored subtree can beat it. The cost depends on k and on the length of the completions, not on the
+     * number of completions sharing the prefix.
+     */
+    class completion_suggester {
+      public:
+        /**
+         * @brief Construct an empty suggester.
+         */
+        completion_suggester();
+
+        /**
+         * @brief Best completions of a prefix.
+         *
+         * @param prefix Prefix typed by the user. It is normalized like the inputs.
+         * @param k Maximum number of completions.
+         * @return The completions by decreasing weight.
+         */
+        [[nodiscard]] std::vector<suggestion> top_k(std::string_view prefix, size_t k) const;
+
+        /**
+         * @brief Number of completions.
+         */
+        [[nodiscard]] size_t size() const { return outputs_.size(); }
+
+        /**
+         * @brief Writes the suggester. The normalizer is not written.
+         *
+         * @param os Output stream.
+         * @return Number of bytes written.
+         */
+        uint64_t serialize(std::ostream &os) const;
+
+        /**
+         * @brief Reads a suggester.
+         *
+         * @param data Pointer to the serialized suggester. It is advanced past it.
+         * @param end End of the readable region.
+         * @param normalize Normalizer the suggester was built with.
+         * @return The suggester.
+         */
+        static completion_suggester deserialize(const bridge::byte_t *&data, const bridge::byte_t *end,
+                                                normalizer normalize = lowercase);
+
+      private:
+        friend class completion_builder;
+
+        struct node {
+            uint32_t first_child;
+            uint32_t num_children;
+            uint32_t first_output;
+            uint32_t num_outputs;
+            uint64_t max_weight;
+            char label;
+        };
+
+        struct output {
+            std::string text;
+            uint64_t weight;
+        };
+
+        void compute_max_weights();
+
+        normalizer normalize_;
+        std::vector<node> nodes_;
+        std::vector<output> outputs_; // grouped by node, by decreasing weight
+    };
+
+} // namespace bridge::suggest
+
+#endif // BRIDGE_COMPLETION_HPP_
@@ -0,0 +1,150 @@
+// Copyright (c) 2021 Bridge Project (Marcos Pontes)
+
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to
+//  deal in the Software without restriction, including without limitation the
+//  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+//  sell copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+//  IN THE SOFTWARE.
+
+//! \brief Spelling correction against the term dictionary.
+
+#ifndef BRIDGE_SPELLING_HPP_
+#define BRIDGE_SPELLING_HPP_
+
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "bridge/global.hpp"
+#include "bridge/postings/term_dictionary.hpp"
+
+namespace bridge::suggest {
+
+    /**
+     * @brief Automaton accepting the strings within a Levenshtein distance of a query.
+     *
+     * @details A state is the row of the edit distance matrix after reading some input, so the automaton is
+     * run lazily instead of being compiled to a DFA. States are vectors of query.size() + 1 distances,
+     * capped at max_distance + 1. Distances count bytes.
+     */
+    class levenshtein_automaton {
+      public:
+        using state = std::vector<uint8_t>;
+
+        /**
+         * @brief Construct a new automaton.
+         *
+         * @param query Query string.
+         * @param max_distance Maximum number of edits, at most 254.
+         */
+        levenshtein_automaton(std::string_view query, uint8_t max_distance);
+
+        /**
+         * @brief State before any input.
+         */
+        [[nodiscard]] state start() const;
+
+        /**
+         * @brief Consumes a byte.
+         *
+         * @param from State before the byte.
+         * @param c Input byte.
+         * @param to State after the byte.
+         */
+        void step(const state &from, char c, state &to) const;
+
+        /**
+         * @brief Whether some continuation of the input read so far can still be accepted.
+         */
+        [[nodiscard]] bool can_match(const state &s) const;
+
+        /**
+         * @brief Distance between the input read so far and the query, if it is accepted.
+         */
+        [[nodiscard]] std::optional<uint8_t> distance(const state &s) const;
+
+      private:
+        std::string query_;
+        uint8_t max_distance_;
+    };
+
+    /**
+     * @brief A term of the dictionary close to a misspelled term.
+     */
+    struct correction {
+        std::string term;
+        uint8_t distance;
+        uint64_t doc_freq;
+
+        bool operator==(const correction &other) const = default;
+    };
+
+    /**
+     * @brief Finds the terms of a dictionary within a Levenshtein distance of a term.
+     *
+     * @details The automaton is intersected with the sorted dictionary: the states of a common prefix are
+     * computed once, and as soon as a prefix cannot be accepted, every term starting with it is skipped
+     * with a single binary search.
+     *
+     * @param dictionary Term dictionary.
+     * @param term Possibly misspelled term.
+     * @param max_distance Maximum number of edits.
+     * @return The candidates by increasing distance, then decreasing document frequency.
+     */
+    std::vector<correction> fuzzy_terms(const postings::term_dictionary &dictionary, std::string_view term,
+                                        uint8_t max_distance);
+
+    /**
+     * @brief "Did you mean" suggestions from the term dictionary.
+     */
+    class spell_checker {
+      public:
+        /**
+         * @brief Construct a new spell checker.
+         *
+         * @param dictionary Term dictionary of the searched field. It must outlive the checker.
+         * @param max_distance Maximum number of edits, 1 or 2. Terms of 1 or 2 bytes are never corrected,
+         * and terms of 3 to 5 bytes are corrected with at most one edit.
+         */
+        explicit spell_checker(const postings::term_dictionary &dictionary, uint8_t max_distance = 2);
+
+        /**
+         * @brief Best corrections of a term, the term itself excluded.
+         *
+         * @param term Possibly misspelled term.
+         * @param max_candidates Maximum number of corrections.
+         * @return The corrections by increasing distance, then decreasing document frequency.
+         */
+        [[nodiscard]] std::vector<correction> candidates(std::string_view term, size_t max_candidates = 5) const;
+
+        /**
+         * @brief Rewrites a query by replacing each unknown term by its best correction.
+         *
+         * @param terms Analyzed terms of the query.
+         * @return The rewritten terms, or nothing if every term is known or has no correction.
+         */
+        [[nodiscard]] std::optional<std::vector<std::string>> did_you_mean(const std::vector<std::string> &terms) const;
+
+      private:
+        [[nodiscard]] uint8_t distance_for(std::string_view term) const;
+
+        const postings::term_dictionary *dictionary_;
+        uint8_t max_distance_;
+    };
+
+} // namespace bridge::suggest
+
+#endif // BRIDGE_SPELLING_HPP_
@@ -0,0 +1,180 @@
+// Copyright (c) 2021 Bridge Project (Marcos Pontes)
+
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to
+//  deal in the Software without restriction, including without limitation the
+//  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+//  sell copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+//  IN THE SOFTWARE.
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <limits>
+
+#include "bridge/aggregation/bucket.hpp"
+#include "bridge/error.hpp"
+
+namespace bridge::aggregation {
+
+    namespace {
+
+        /**
+         * @brief Smallest sortable value of a column kind that is greater or equal to a bound.
+         */
+        uint64_t lower_raw(fastfield::numeric_kind kind, double bound) {
+            if (std::isnan(bound)) {
+                throw bridge_error("A range bound cannot be NaN");
+            }
+            switch (kind) {
+            case fastfield::numeric_kind::F64:
+                return fastfield::to_sortable(bound);
+            case fastfield::numeric_kind::I64: {
+                double ceiled = std::ceil(bound);
+                if (ceiled <= static_cast<double>(std::numeric_limits<int64_t>::min())) {
+                    return fastfield::to_sortable(std::numeric_limits<int64_t>::min());
+                }
+                if (ceiled >= 0x1p63) {
+                    return std::numeric_limits<uint64_t>::max();
+                }
+                return fastfield::to_sortable(static_cast<int64_t>(ceiled));
+            }
+            default: {
+                double ceiled = std::ceil(bound);
+                if (ceiled <= 0.0) {
+                    return 0;
+                }
+                return ceiled >= 0x1p64 ? std::numeric_limits<uint64_t>::max() : static_cast<uint64_t>(ceiled);
+            }
+            }
+        }
+
+    } // namespace
+
+    /**
+     * @brief Construct a new collector.
+     */
+    range_collector::range_collector(const fastfield::numeric_column &column, std::vector<range_bucket> ranges)
+        : column_(&column), ranges_(std::move(ranges)) {
+        for (const auto &range : ranges_) {
+            if (range.from) {
+                boundaries_.push_back(lower_raw(column.kind(), *range.from));
+            }
+            if (range.to) {
+                boundaries_.push_back(lower_raw(column.kind(), *range.to));
+            }
+        }
+        std::sort(boundaries_.begin(), boundaries_.end());
+        boundaries_.erase(std::unique(boundaries_.begin(), boundaries_.end()), boundaries_.end());
+
+        // interval i holds the values with i boundaries lower or equal to them
+        for (const auto &range : ranges_) {
+            auto position = [this, &column](double bound) {
+                uint64_t raw = lower_raw(column.kind(), bound);
+                return static_cast<size_t>(std::lower_bound(boundaries_.begin(), boundaries_.end(), raw) -
+                                           boundaries_.begin()) +
+                       1;
+            };
+            size_t first = range.from ? position(*range.from) : 0;
+            size_t last = range.to ? position(*range.to) : boundaries_.size() + 1;
+            spans_.emplace_back(first, std::max(first, last));
+        }
+        counts_.resize(boundaries_.size() + 1, 0);
+
+        // the search walks a perfect binary tree: pad with values no document exceeds
+        size_t padded = std::bit_ceil(boundaries_.size() + 1) - 1;
+        boundaries_.resize(padded, std::numeric_limits<uint64_t>::max());
+    }
+
+    /**
+     * @brief Adds the counts of another segment, collected with the same ranges.
+     */
+    void range_collector::merge(const range_collector &other) {
+        if (other.ranges_.size() != ranges_.size() || other.counts_.size() != counts_.size()) {
+            throw bridge_error("Cannot merge range aggregations of different ranges");
+        }
+        for (size_t i = 0; i < counts_.size(); i++) {
+            counts_[i] += other.counts_[i];
+        }
+    }
+
+    /**
+     * @brief The ranges and their counts, in the requested order.
+     */
+    std::vector<range_bucket> range_collector::buckets() const {
+        std::vector<range_bucket> buckets = ranges_;
+        for (size_t r = 0; r < buckets.size(); r++) {
+            buckets[r].doc_count = 0;
+            for (size_t i = spans_[r].first; i < spans_[r].second; i++) {
+                buckets[r].doc_count += counts_[i];
+            }
+        }
+        return buckets;
+    }
+
+    /**
+     * @brief Construct a new collector.
+     */
+    filters_collector::filters_collector(std::vector<named_filter> filters, std::optional<std::string> other_bucket)
+        : filters_(std::move(filters)), counts_(filters_.size(), 0), other_bucket_(std::move(other_bucket)) {
+        for (const auto &filter : filters_) {
+            if (!filter.docs) {
+                throw bridge_error("A named filter needs its documents");
+            }
+        }
+    }
+
+    void filters_collector::collect(DocId doc, Score) {
+        bool matched = false;
+        for (size_t f = 0; f < filters_.size(); f++) {
+            postings::doc_set &docs = *filters_[f].docs;
+            DocId current = docs.doc() < doc ? docs.seek(doc) : docs.doc();
+            if (current == doc) {
+                counts_[f]++;
+                matched = true;
+            }
+        }
+        other_count_ += matched ? 0 : 1;
+    }
+
+    /**
+     * @brief The filters and their counts, then the other bucket if any.
+     */
+    std::vector<filter_bucket> filters_collector::buckets() const {
+        std::vector<filter_bucket> buckets;
+        for (size_t f = 0; f < filters_.size(); f++) {
+            buckets.push_back({filters_[f].name, counts_[f]});
+        }
+        if (other_bucket_) {
+            buckets.push_back({*other_bucket_, other_count_});
+        }
+        return buckets;
+    }
+
+    /**
+     * @brief Adds the buckets of a segment to the buckets of the previous segments.
+     */
+    void merge_buckets(std::vector<filter_bucket> &into, const std::vector<filter_bucket> &other) {
+        if (into.size() != other.size()) {
+            throw bridge_error("Cannot merge filters aggregations of different filters");
+        }
+        for (size_t b = 0; b < into.size(); b++) {
+            if (into[b].name != other[b].name) {
+                throw bridge_error("Cannot merge filters aggregations of different filters");
+            }
+            into[b].doc_count += other[b].doc_count;
+        }
+    }
+
+} // namespace bridge::aggregation
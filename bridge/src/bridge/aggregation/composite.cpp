@@ -0,0 +1,157 @@
+// Copyright (c) 2021 Bridge Project (Marcos Pontes)
+
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to
+//  deal in the Software without restriction, including without limitation the
+//  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+//  sell copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+//  IN THE SOFTWARE.
+
+#include <algorithm>
+#include <map>
+
+#include "bridge/aggregation/composite.hpp"
+#include "bridge/error.hpp"
+
+namespace bridge::aggregation {
+
+    namespace {
+
+        bool composite_before(const std::vector<composite_source> &sources, const composite_key &a,
+                              const composite_key &b) {
+            for (size_t s = 0; s < sources.size(); s++) {
+                if (a[s] != b[s]) {
+                    return sources[s].order == collector::sort_order::Ascending ? a[s] < b[s] : a[s] > b[s];
+                }
+            }
+            return false;
+        }
+
+    } // namespace
+
+    /**
+     * @brief Construct a new collector.
+     */
+    composite_collector::composite_collector(std::vector<composite_source> sources, size_t size,
+                                             std::optional<composite_key> after)
+        : sources_(std::move(sources)), size_(size), after_(std::move(after)), scratch_(sources_.size()) {
+        if (sources_.empty()) {
+            throw bridge_error("A composite aggregation needs at least one source");
+        }
+        for (const auto &source : sources_) {
+            if (source.column == nullptr) {
+                throw bridge_error("A composite source needs a column");
+            }
+        }
+        if (after_ && after_->size() != sources_.size()) {
+            throw bridge_error("The after key does not match the sources");
+        }
+        slots_.reserve(size);
+        heap_.reserve(size);
+    }
+
+    size_t composite_collector::key_hash::operator()(const composite_key &key) const {
+        uint64_t hash = 0x9E3779B97F4A7C15ULL;
+        for (uint64_t value : key) {
+            hash = (hash ^ value) * 0xFF51AFD7ED558CCDULL;
+            hash ^= hash >> 32;
+        }
+        return static_cast<size_t>(hash);
+    }
+
+    bool composite_collector::key_before(const composite_key &a, const composite_key &b) const {
+        return composite_before(sources_, a, b);
+    }
+
+    void composite_collector::collect(DocId doc, Score) {
+        if (size_ == 0) {
+            return;
+        }
+        for (size_t s = 0; s < sources_.size(); s++) {
+            scratch_[s] = sources_[s].column->get_raw(doc);
+        }
+        if (after_ && !key_before(*after_, scratch_)) {
+            return;
+        }
+        auto it = slot_of_key_.find(scratch_);
+        if (it != slot_of_key_.end()) {
+            slots_[it->second].doc_count++;
+            return;
+        }
+
+        auto heap_less = [this](size_t a, size_t b) { return key_before(slots_[a].key, slots_[b].key); };
+        size_t slot = 0;
+        if (slots_.size() < size_) {
+            slot = slots_.size();
+            slots_.push_back({scratch_, 1});
+        } else {
+            slot = heap_.front();
+            if (!key_before(scratch_, slots_[slot].key)) {
+                return;
+            }
+            std::pop_heap(heap_.begin(), heap_.end(), heap_less);
+            heap_.pop_back();
+            slot_of_key_.erase(slots_[slot].key);
+            slots_[slot] = {scratch_, 1};
+        }
+        slot_of_key_.emplace(scratch_, slot);
+        heap_.push_back(slot);
+        std::push_heap(heap_.begin(), heap_.end(), heap_less);
+    }
+
+    /**
+     * @brief The buckets of the page, in key order.
+     */
+    std::vector<composite_bucket> composite_collector::buckets() const {
+        std::vector<composite_bucket> buckets = slots_;
+        std::sort(buckets.begin(), buckets.end(),
+                  [this](const composite_bucket &a, const composite_bucket &b) { return key_before(a.key, b.key); });
+        return buckets;
+    }
+
+    /**
+     * @brief Merges the pages of every segment into the page of the index.
+     */
+    std::vector<composite_bucket> merge_composite_pages(const std::vector<std::vector<composite_bucket>> &pages,
+                                                        const std::vector<composite_source> &sources, size_t size) {
+        auto before = [&sources](const composite_key &a, const composite_key &b) {
+            return composite_before(sources, a, b);
+        };
+        std::map<composite_key, uint64_t, decltype(before)> counts(before);
+        for (const auto &page : pages) {
+            for (const auto &bucket : page) {
+                if (bucket.key.size() != sources.size()) {
+                    throw bridge_error("The bucket key does not match the sources");
+                }
+                counts[bucket.key] += bucket.doc_count;
+            }
+        }
+        std::vector<composite_bucket> merged;
+        for (auto it = counts.begin(); it != counts.end() && merged.size() < size; ++it) {
+            merged.push_back({it->first, it->second});
+        }
+        return merged;
+    }
+
+    /**
+     * @brief After key for the next page.
+     */
+    std::optional<composite_key> next_after_key(const std::vector<composite_bucket> &page, size_t size) {
+        if (page.empty() || page.size() < size) {
+            return std::nullopt;
+        }
+        return page.back().key;
+    }
+
+} // namespace bridge::aggregation
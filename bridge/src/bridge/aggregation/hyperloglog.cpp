@@ -0,0 +1,80 @@
+// Copyright (c) 2021 Bridge Project (Marcos Pontes)
+
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to
+//  deal in the Software without restriction, including without limitation the
+//  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+//  sell copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+//  IN THE SOFTWARE.
+
+#include <algorithm>
+#include <cmath>
+
+#include "bridge/aggregation/hyperloglog.hpp"
+#include "bridge/error.hpp"
+
+namespace bridge::aggregation {
+
+    /**
+     * @brief Construct an empty sketch.
+     */
+    hyperloglog::hyperloglog(uint8_t precision) : precision_(precision) {
+        if (precision < 4 || precision > 18) {
+            throw bridge_error("The HyperLogLog precision must be between 4 and 18");
+        }
+        registers_.resize(size_t{1} << precision, 0);
+    }
+
+    /**
+     * @brief Adds the values counted by another sketch.
+     */
+    void hyperloglog::merge(const hyperloglog &other) {
+        if (other.precision_ != precision_) {
+            throw bridge_error("Cannot merge HyperLogLog sketches of different precisions");
+        }
+        for (size_t i = 0; i < registers_.size(); i++) {
+            registers_[i] = std::max(registers_[i], other.registers_[i]);
+        }
+    }
+
+    /**
+     * @brief Estimated number of distinct values.
+     */
+    uint64_t hyperloglog::estimate() const {
+        auto m = static_cast<double>(registers_.size());
+        double sum = 0.0;
+        size_t zeros = 0;
+        for (uint8_t rank : registers_) {
+            sum += std::ldexp(1.0, -static_cast<int>(rank));
+            zeros += rank == 0 ? 1 : 0;
+        }
+
+        double alpha = 0.7213 / (1.0 + 1.079 / m);
+        if (registers_.size() == 16) {
+            alpha = 0.673;
+        } else if (registers_.size() == 32) {
+            alpha = 0.697;
+        } else if (registers_.size() == 64) {
+            alpha = 0.709;
+        }
+        double estimate = alpha * m * m / sum;
+
+        // the raw estimate is biased for small cardinalities, where linear counting is accurate
+        if (estimate <= 2.5 * m && zeros > 0) {
+            estimate = m * std::log(m / static_cast<double>(zeros));
+        }
+        return static_cast<uint64_t>(std::llround(estimate));
+    }
+
+} // namespace bridge::aggregation
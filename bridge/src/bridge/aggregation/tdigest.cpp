@@ -0,0 +1,145 @@
+// Copyright (c) 2021 Bridge Project (Marcos Pontes)
+
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to
+//  deal in the Software without restriction, including without limitation the
+//  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+//  sell copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+//  IN THE SOFTWARE.
+
+#include <algorithm>
+#include <cmath>
+#include <numbers>
+
+#include "bridge/aggregation/tdigest.hpp"
+#include "bridge/error.hpp"
+
+namespace bridge::aggregation {
+
+    /**
+     * @brief Construct an empty digest.
+     */
+    tdigest::tdigest(double compression) : compression_(compression) {
+        if (!(compression >= 10.0)) {
+            throw bridge_error("The t-digest compression must be at least 10");
+        }
+        buffer_limit_ = static_cast<size_t>(5 * compression);
+        buffer_.reserve(buffer_limit_);
+    }
+
+    /**
+     * @brief Adds a value.
+     */
+    void tdigest::add(double value, double weight) {
+        if (std::isnan(value) || !(weight > 0.0)) {
+            return;
+        }
+        min_ = std::min(min_, value);
+        max_ = std::max(max_, value);
+        buffer_.push_back({value, weight});
+        buffered_weight_ += weight;
+        if (buffer_.size() >= buffer_limit_) {
+            compress();
+        }
+    }
+
+    /**
+     * @brief Adds the values of another digest.
+     */
+    void tdigest::merge(const tdigest &other) {
+        for (const auto &c : other.centroids()) {
+            buffer_.push_back(c);
+            buffered_weight_ += c.weight;
+        }
+        min_ = std::min(min_, other.min_);
+        max_ = std::max(max_, other.max_);
+        compress();
+    }
+
+    void tdigest::compress() const {
+        if (buffer_.empty()) {
+            return;
+        }
+        buffer_.insert(buffer_.end(), centroids_.begin(), centroids_.end());
+        std::sort(buffer_.begin(), buffer_.end(), [](const centroid &a, const centroid &b) { return a.mean < b.mean; });
+        total_weight_ += buffered_weight_;
+        buffered_weight_ = 0.0;
+
+        auto scale = [this](double q) { return compression_ / (2.0 * std::numbers::pi) * std::asin(2.0 * q - 1.0); };
+        centroids_.clear();
+        centroid current = buffer_.front();
+        double merged_weight = 0.0; // weight of the centroids before the current one
+        double k_low = scale(0.0);
+        for (size_t i = 1; i < buffer_.size(); i++) {
+            const centroid &next = buffer_[i];
+            double q = (merged_weight + current.weight + next.weight) / total_weight_;
+            if (scale(std::min(q, 1.0)) - k_low <= 1.0) {
+                current.weight += next.weight;
+                current.mean += (next.mean - current.mean) * next.weight / current.weight;
+            } else {
+                merged_weight += current.weight;
+                k_low = scale(std::min(merged_weight / total_weight_, 1.0));
+                centroids_.push_back(current);
+                current = next;
+            }
+        }
+        centroids_.push_back(current);
+        buffer_.clear();
+    }
+
+    /**
+     * @brief The centroids, by increasing mean.
+     */
+    const std::vector<centroid> &tdigest::centroids() const {
+        compress();
+        return centroids_;
+    }
+
+    /**
+     * @brief Estimated quantile.
+     */
+    double tdigest::quantile(double q) const {
+        if (q < 0.0 || q > 1.0) {
+            throw bridge_error("A quantile must be between 0 and 1");
+        }
+        compress();
+        if (centroids_.empty()) {
+            return std::numeric_limits<double>::quiet_NaN();
+        }
+        if (centroids_.size() == 1) {
+            return centroids_.front().mean;
+        }
+
+        // the weight of a centroid is spread around its mean: interpolate between consecutive means, and between
+        // the extreme means and the minimum or maximum
+        double index = q * total_weight_;
+        const centroid &first = centroids_.front();
+        if (index < first.weight / 2.0) {
+            return min_ + (first.mean - min_) * index / (first.weight / 2.0);
+        }
+        double cumulative = first.weight / 2.0;
+        for (size_t i = 0; i + 1 < centroids_.size(); i++) {
+            double step = (centroids_[i].weight + centroids_[i + 1].weight) / 2.0;
+            if (cumulative + step > index) {
+                double t = (index - cumulative) / step;
+                return centroids_[i].mean + t * (centroids_[i + 1].mean - centroids_[i].mean);
+            }
+            cumulative += step;
+        }
+        const centroid &last = centroids_.back();
+        double t = std::min(1.0, (index - cumulative) / (last.weight / 2.0));
+        return last.mean + t * (max_ - last.mean);
+    }
+
+} // namespace bridge::aggregation
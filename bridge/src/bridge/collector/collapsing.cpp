@@ -0,0 +1,127 @@
+// Copyright (c) 2021 Bridge Project (Marcos Pontes)
+
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to
+//  deal in the Software without restriction, including without limitation the
+//  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+//  sell copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+//  IN THE SOFTWARE.
+
+#include <algorithm>
+
+#include "bridge/collector/collapsing.hpp"
+#include "bridge/error.hpp"
+
+namespace bridge::collector {
+
+    /**
+     * @brief Construct a new collector.
+     */
+    collapsing_collector::collapsing_collector(size_t k, const fastfield::numeric_column &groups)
+        : k_(k), groups_(&groups) {
+        slots_.reserve(k);
+        heap_.reserve(k);
+        heap_index_.reserve(k);
+        slot_of_group_.reserve(k);
+    }
+
+    bool collapsing_collector::slot_before(size_t a, size_t b) const {
+        return ranks_before({slots_[a].doc, slots_[a].score}, {slots_[b].doc, slots_[b].score});
+    }
+
+    void collapsing_collector::swap_heap(size_t i, size_t j) {
+        std::swap(heap_[i], heap_[j]);
+        heap_index_[heap_[i]] = i;
+        heap_index_[heap_[j]] = j;
+    }
+
+    void collapsing_collector::sift_down(size_t i) {
+        // the worst slot is the root: children must not rank after their parent
+        while (true) {
+            size_t worst = i;
+            for (size_t child : {2 * i + 1, 2 * i + 2}) {
+                if (child < heap_.size() && slot_before(heap_[worst], heap_[child])) {
+                    worst = child;
+                }
+            }
+            if (worst == i) {
+                return;
+            }
+            swap_heap(i, worst);
+            i = worst;
+        }
+    }
+
+    void collapsing_collector::sift_up(size_t i) {
+        while (i > 0) {
+            size_t parent = (i - 1) / 2;
+            if (!slot_before(heap_[parent], heap_[i])) {
+                return;
+            }
+            swap_heap(i, parent);
+            i = parent;
+        }
+    }
+
+    void collapsing_collector::collect(DocId doc, Score score) {
+        if (k_ == 0) {
+            return;
+        }
+        if (doc >= groups_->num_docs()) {
+            throw bridge_error("Doc id out of the collapsing field range");
+        }
+        uint64_t group = groups_->get_raw(doc);
+        group_hit candidate{doc, score, group};
+
+        auto found = slot_of_group_.find(group);
+        if (found != slot_of_group_.end()) {
+            group_hit &best = slots_[found->second];
+            if (ranks_before({doc, score}, {best.doc, best.score})) {
+                best = candidate;
+                sift_down(heap_index_[found->second]);
+            }
+            return;
+        }
+
+        if (slots_.size() < k_) {
+            size_t slot = slots_.size();
+            slots_.push_back(candidate);
+            heap_index_.push_back(heap_.size());
+            heap_.push_back(slot);
+            slot_of_group_.emplace(group, slot);
+            sift_up(heap_.size() - 1);
+            return;
+        }
+
+        size_t root = heap_.front();
+        if (ranks_before({doc, score}, {slots_[root].doc, slots_[root].score})) {
+            slot_of_group_.erase(slots_[root].group);
+            slots_[root] = candidate;
+            slot_of_group_.emplace(group, root);
+            sift_down(0);
+        }
+    }
+
+    /**
+     * @brief The best hit of each kept group, best first.
+     */
+    std::vector<group_hit> collapsing_collector::hits() const {
+        std::vector<group_hit> sorted = slots_;
+        std::sort(sorted.begin(), sorted.end(), [](const group_hit &a, const group_hit &b) {
+            return ranks_before({a.doc, a.score}, {b.doc, b.score});
+        });
+        return sorted;
+    }
+
+} // namespace bridge::collector
@@ -0,0 +1,146 @@
+// Copyright (c) 2021 Bridge Project (Marcos Pontes)
+
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to
+//  deal in the Software without restriction, including without limitation the
+//  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+//  sell copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+//  IN THE SOFTWARE.
+
+#include <charconv>
+#include <string>
+
+#include "bridge/collector/doc_export.hpp"
+#include "bridge/error.hpp"
+
+namespace bridge::collector {
+
+    namespace {
+
+        /**
+         * @brief Restores the normal access pattern of the columns, even if the callback throws.
+         */
+        class sequential_scope {
+          public:
+            explicit sequential_scope(const std::vector<const fastfield::numeric_column *> &columns)
+                : columns_(columns) {
+                for (const auto *column : columns_) {
+                    column->advise(directory::access_pattern::Sequential);
+                }
+            }
+
+            ~sequential_scope() {
+                for (const auto *column : columns_) {
+                    column->advise(directory::access_pattern::Normal);
+                }
+            }
+
+            sequential_scope(const sequential_scope &) = delete;
+            sequential_scope &operator=(const sequential_scope &) = delete;
+
+          private:
+            const std::vector<const fastfield::numeric_column *> &columns_;
+        };
+
+        void append_value(std::string &line, const fastfield::numeric_column &column, uint64_t raw) {
+            char buffer[32];
+            std::to_chars_result result{};
+            switch (column.kind()) {
+            case fastfield::numeric_kind::I64:
+                result = std::to_chars(buffer, buffer + sizeof(buffer), fastfield::i64_from_sortable(raw));
+                break;
+            case fastfield::numeric_kind::F64:
+                result = std::to_chars(buffer, buffer + sizeof(buffer), fastfield::f64_from_sortable(raw));
+                break;
+            default:
+                result = std::to_chars(buffer, buffer + sizeof(buffer), raw);
+                break;
+            }
+            line.append(buffer, result.ptr);
+        }
+
+    } // namespace
+
+    /**
+     * @brief Streams every document of a doc set with its fast field values.
+     */
+    uint64_t export_docs(postings::doc_set &docs, const std::vector<const fastfield::numeric_column *> &columns,
+                         const export_callback &callback, size_t block_size) {
+        if (block_size == 0) {
+            throw bridge_error("The export block size must be positive");
+        }
+        sequential_scope scope(columns);
+
+        std::vector<DocId> block;
+        block.reserve(block_size);
+        std::vector<std::vector<uint64_t>> values(columns.size());
+        for (auto &column_values : values) {
+            column_values.reserve(block_size);
+        }
+        export_block exported;
+        exported.values.resize(columns.size());
+
+        uint64_t total = 0;
+        auto flush = [&]() {
+            // one column at a time, so each column is read as a forward scan
+            for (size_t c = 0; c < columns.size(); c++) {
+                values[c].resize(block.size());
+                for (size_t i = 0; i < block.size(); i++) {
+                    if (block[i] >= columns[c]->num_docs()) {
+                        throw bridge_error("Doc id out of the column range");
+                    }
+                    values[c][i] = columns[c]->get_raw(block[i]);
+                }
+                exported.values[c] = values[c];
+            }
+            exported.docs = block;
+            callback(exported);
+            total += block.size();
+            block.clear();
+        };
+
+        for (DocId doc = docs.doc(); doc != postings::TERMINATED; doc = docs.advance()) {
+            block.push_back(doc);
+            if (block.size() == block_size) {
+                flush();
+            }
+        }
+        if (!block.empty()) {
+            flush();
+        }
+        return total;
+    }
+
+    /**
+     * @brief Writes every document of a doc set as tab separated values.
+     */
+    uint64_t export_tsv(postings::doc_set &docs, const std::vector<const fastfield::numeric_column *> &columns,
+                        std::ostream &os) {
+        std::string lines;
+        return export_docs(docs, columns, [&](const export_block &block) {
+            lines.clear();
+            for (size_t i = 0; i < block.docs.size(); i++) {
+                char buffer[16];
+                lines.append(buffer, std::to_chars(buffer, buffer + sizeof(buffer), block.docs[i]).ptr);
+                for (size_t c = 0; c < columns.size(); c++) {
+                    lines.push_back('\t');
+                    append_value(lines, *columns[c], block.values[c][i]);
+                }
+                lines.push_back('\n');
+            }
+            os.write(lines.data(), static_cast<std::streamsize>(lines.size()));
+        });
+    }
+
+} // namespace bridge::collector
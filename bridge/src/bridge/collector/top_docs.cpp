@@ -0,0 +1,102 @@
+// Copyright (c) 2021 Bridge Project (Marcos Pontes)
+
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to
+//  deal in the Software without restriction, including without limitation the
+//  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+//  sell copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+//  IN THE SOFTWARE.
+
+#include <algorithm>
+
+#include "bridge/collector/top_docs.hpp"
+#include "bridge/error.hpp"
+
+namespace bridge::collector {
+
+    /**
+     * @brief Construct a new collector.
+     */
+    top_docs_collector::top_docs_collector(size_t k, std::optional<hit> after) : k_(k), after_(after) {
+        heap_.reserve(k);
+    }
+
+    void top_docs_collector::collect(DocId doc, Score score) {
+        hit candidate{doc, score};
+        if (k_ == 0 || (after_ && !ranks_before(*after_, candidate))) {
+            return;
+        }
+        if (heap_.size() < k_) {
+            heap_.push_back(candidate);
+            std::push_heap(heap_.begin(), heap_.end(), ranks_before);
+        } else if (ranks_before(candidate, heap_.front())) {
+            std::pop_heap(heap_.begin(), heap_.end(), ranks_before);
+            heap_.back() = candidate;
+            std::push_heap(heap_.begin(), heap_.end(), ranks_before);
+        }
+    }
+
+    /**
+     * @brief The kept hits, best first.
+     */
+    std::vector<hit> top_docs_collector::hits() const {
+        std::vector<hit> sorted = heap_;
+        std::sort(sorted.begin(), sorted.end(), ranks_before);
+        return sorted;
+    }
+
+    /**
+     * @brief Construct a new collector.
+     */
+    top_field_collector::top_field_collector(size_t k, const fastfield::numeric_column &field, sort_order order,
+                                             std::optional<field_hit> after)
+        : k_(k), field_(&field), order_(order), after_(after) {
+        heap_.reserve(k);
+    }
+
+    void top_field_collector::collect(DocId doc, Score) {
+        if (k_ == 0) {
+            return;
+        }
+        if (doc >= field_->num_docs()) {
+            throw bridge_error("Doc id out of the sort field range");
+        }
+        field_hit candidate{doc, field_->get_raw(doc)};
+        if (after_ && !sorts_before(*after_, candidate)) {
+            return;
+        }
+
+        auto before = [this](const field_hit &a, const field_hit &b) { return sorts_before(a, b); };
+        if (heap_.size() < k_) {
+            heap_.push_back(candidate);
+            std::push_heap(heap_.begin(), heap_.end(), before);
+        } else if (sorts_before(candidate, heap_.front())) {
+            std::pop_heap(heap_.begin(), heap_.end(), before);
+            heap_.back() = candidate;
+            std::push_heap(heap_.begin(), heap_.end(), before);
+        }
+    }
+
+    /**
+     * @brief The kept hits, in sort order.
+     */
+    std::vector<field_hit> top_field_collector::hits() const {
+        std::vector<field_hit> sorted = heap_;
+        std::sort(sorted.begin(), sorted.end(), [this](const field_hit &a, const field_hit &b) {
+            return sorts_before(a, b);
+        });
+        return sorted;
+    }
+
+} // namespace bridge::collector
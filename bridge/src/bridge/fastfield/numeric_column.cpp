@@ -0,0 +1,160 @@
+// Copyright (c) 2021 Bridge Project (Marcos Pontes)
+
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to
+//  deal in the Software without restriction, including without limitation the
+//  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+//  sell copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+//  IN THE SOFTWARE.
+
+#include <algorithm>
+
+#include "bridge/error.hpp"
+#include "bridge/fastfield/numeric_column.hpp"
+
+namespace bridge::fastfield {
+
+    namespace {
+
+        constexpr size_t header_size = 1 + sizeof(uint32_t) + 2 * sizeof(uint64_t) + 1;
+
+    } // namespace
+
+    numeric_column numeric_column::build(const std::vector<uint64_t> &values) {
+        return pack(numeric_kind::U64, values);
+    }
+
+    numeric_column numeric_column::build(const std::vector<int64_t> &values) {
+        std::vector<uint64_t> sortable(values.size());
+        std::transform(values.begin(), values.end(), sortable.begin(), [](int64_t v) { return to_sortable(v); });
+        return pack(numeric_kind::I64, sortable);
+    }
+
+    numeric_column numeric_column::build(const std::vector<double> &values) {
+        std::vector<uint64_t> sortable(values.size());
+        std::transform(values.begin(), values.end(), sortable.begin(), [](double v) { return to_sortable(v); });
+        return pack(numeric_kind::F64, sortable);
+    }
+
+    numeric_column numeric_column::pack(numeric_kind kind, const std::vector<uint64_t> &sortable) {
+        numeric_column column;
+        column.kind_ = kind;
+        column.num_docs_ = static_cast<uint32_t>(sortable.size());
+        if (!sortable.empty()) {
+            auto [min, max] = std::minmax_element(sortable.begin(), sortable.end());
+            column.min_ = *min;
+            column.max_ = *max;
+            column.num_bits_ = static_cast<uint8_t>(std::bit_width(column.max_ - column.min_));
+            column.mask_ = column.num_bits_ == 64 ? ~0ULL : (1ULL << column.num_bits_) - 1;
+        }
+
+        std::vector<uint64_t> words((sortable.size() * column.num_bits_ + 63) / 64, 0);
+        for (size_t doc = 0; column.num_bits_ != 0 && doc < sortable.size(); doc++) {
+            uint64_t value = sortable[doc] - column.min_;
+            uint64_t bit = doc * column.num_bits_;
+            uint64_t shift = bit & 63;
+            words[bit >> 6] |= value << shift;
+            if (shift + column.num_bits_ > 64) {
+                words[(bit >> 6) + 1] |= value >> (64 - shift);
+            }
+        }
+
+        auto packed = std::make_shared<std::vector<bridge::byte_t>>();
+        packed->reserve(words.size() * sizeof(uint64_t));
+        for (uint64_t word : words) {
+            common::write_fixed(*packed, word);
+        }
+        column.packed_ = packed->data();
+        column.owned_ = std::move(packed);
+        return column;
+    }
+
+    /**
+     * @brief Get the values of several documents, converted to doubles.
+     */
+    void numeric_column::get_many(const DocId *docs, size_t count, double *out) const {
+        for (size_t i = 0; i < count; i++) {
+            if (docs[i] >= num_docs_) {
+                throw bridge_error("Doc id out of the column range");
+            }
+            out[i] = get(docs[i]);
+        }
+    }
+
+    /**
+     * @brief Writes the column.
+     */
+    uint64_t numeric_column::serialize(std::ostream &os) const {
+        std::vector<bridge::byte_t> header;
+        header.push_back(static_cast<bridge::byte_t>(kind_));
+        common::write_fixed(header, num_docs_);
+        common::write_fixed(header, min_);
+        common::write_fixed(header, max_);
+        header.push_back(static_cast<bridge::byte_t>(num_bits_));
+        os.write(header.data(), static_cast<std::streamsize>(header.size()));
+
+        auto packed_size = static_cast<std::streamsize>((static_cast<uint64_t>(num_docs_) * num_bits_ + 63) / 64 *
+                                                        sizeof(uint64_t));
+        os.write(packed_, packed_size);
+        return header.size() + static_cast<uint64_t>(packed_size);
+    }
+
+    size_t numeric_column::read_header(const bridge::byte_t *&data, const bridge::byte_t *end) {
+        if (end - data < static_cast<std::ptrdiff_t>(header_size)) {
+            throw bridge_error("Corrupted numeric column");
+        }
+        kind_ = static_cast<numeric_kind>(*data);
+        num_docs_ = common::read_fixed<uint32_t>(data + 1);
+        min_ = common::read_fixed<uint64_t>(data + 5);
+        max_ = common::read_fixed<uint64_t>(data + 13);
+        num_bits_ = static_cast<uint8_t>(data[21]);
+        data += header_size;
+        if (kind_ > numeric_kind::F64 || num_bits_ > 64) {
+            throw bridge_error("Corrupted numeric column");
+        }
+        mask_ = num_bits_ == 64 ? ~0ULL : (1ULL << num_bits_) - 1;
+
+        size_t packed_size = (static_cast<uint64_t>(num_docs_) * num_bits_ + 63) / 64 * sizeof(uint64_t);
+        if (static_cast<size_t>(end - data) < packed_size) {
+            throw bridge_error("Corrupted numeric column");
+        }
+        return packed_size;
+    }
+
+    /**
+     * @brief Reads a column.
+     */
+    numeric_column numeric_column::deserialize(const bridge::byte_t *&data, const bridge::byte_t *end) {
+        numeric_column column;
+        size_t packed_size = column.read_header(data, end);
+        auto packed = std::make_shared<std::vector<bridge::byte_t>>(data, data + packed_size);
+        data += packed_size;
+        column.packed_ = packed->data();
+        column.owned_ = std::move(packed);
+        return column;
+    }
+
+    /**
+     * @brief Opens a column in place, without copying its values.
+     */
+    numeric_column numeric_column::open(std::shared_ptr<directory::read_only_source> source) {
+        numeric_column column;
+        const bridge::byte_t *data = source->deref();
+        column.read_header(data, source->deref() + source->size());
+        column.packed_ = data;
+        column.source_ = std::move(source);
+        return column;
+    }
+
+} // namespace bridge::fastfield
@@ -0,0 +1,192 @@
+// Copyright (c) 2021 Bridge Project (Marcos Pontes)
+
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to
+//  deal in the Software without restriction, including without limitation the
+//  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+//  sell copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+//  IN THE SOFTWARE.
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+#include "bridge/error.hpp"
+#include "bridge/index/doc_reorder.hpp"
+
+namespace bridge::index {
+
+    namespace {
+
+        /**
+         * @brief Scratch state shared by every level of the recursion.
+         */
+        struct bisection {
+            const forward_index &docs;
+            const bisection_options &options;
+            std::vector<uint32_t> left_degrees;
+            std::vector<uint32_t> right_degrees;
+            std::vector<double> gains;
+
+            /// @brief Estimated cost of a term having `degree` documents in a partition of `size` documents.
+            static double cost(uint32_t degree, size_t size) {
+                if (degree == 0) {
+                    return 0.0;
+                }
+                return degree * std::log2(static_cast<double>(size) / (degree + 1));
+            }
+
+            /// @brief Cost reduction when a document leaves the partition `from` for the partition `to`.
+            double move_gain(DocId doc, const std::vector<uint32_t> &from, size_t from_size,
+                             const std::vector<uint32_t> &to, size_t to_size) const {
+                double gain = 0.0;
+                for (uint32_t term : docs[doc]) {
+                    double before = cost(from[term], from_size) + cost(to[term], to_size);
+                    double after = cost(from[term] - 1, from_size) + cost(to[term] + 1, to_size);
+                    gain += before - after;
+                }
+                return gain;
+            }
+
+            void count_degrees(const DocId *begin, const DocId *end, std::vector<uint32_t> &degrees) {
+                for (const DocId *doc = begin; doc != end; doc++) {
+                    for (uint32_t term : docs[*doc]) {
+                        degrees[term]++;
+                    }
+                }
+            }
+
+            void reset_degrees(const DocId *begin, const DocId *end) {
+                for (const DocId *doc = begin; doc != end; doc++) {
+                    for (uint32_t term : docs[*doc]) {
+                        left_degrees[term] = 0;
+                        right_degrees[term] = 0;
+                    }
+                }
+            }
+
+            /// @brief Sorts a half by decreasing gain, keeping the gains aligned with the documents.
+            void sort_by_gain(DocId *begin, DocId *end, double *gain) {
+                size_t size = end - begin;
+                std::vector<size_t> indexes(size);
+                std::iota(indexes.begin(), indexes.end(), 0);
+                std::sort(indexes.begin(), indexes.end(), [&](size_t a, size_t b) { return gain[a] > gain[b]; });
+
+                std::vector<DocId> sorted_docs(size);
+                std::vector<double> sorted_gains(size);
+                for (size_t i = 0; i < size; i++) {
+                    sorted_docs[i] = begin[indexes[i]];
+                    sorted_gains[i] = gain[indexes[i]];
+                }
+                std::copy(sorted_docs.begin(), sorted_docs.end(), begin);
+                std::copy(sorted_gains.begin(), sorted_gains.end(), gain);
+            }
+
+            void run(DocId *begin, DocId *end, uint32_t depth) {
+                size_t size = end - begin;
+                if (size < std::max<uint32_t>(options.min_partition_size, 2) ||
+                    (options.max_depth != 0 && depth >= options.max_depth)) {
+                    return;
+                }
+
+                DocId *middle = begin + size / 2;
+                size_t left_size = middle - begin;
+                size_t right_size = end - middle;
+
+                for (uint32_t iteration = 0; iteration < options.iterations; iteration++) {
+                    count_degrees(begin, middle, left_degrees);
+                    count_degrees(middle, end, right_degrees);
+
+                    gains.resize(size);
+                    for (size_t i = 0; i < left_size; i++) {
+                        gains[i] = move_gain(begin[i], left_degrees, left_size, right_degrees, right_size);
+                    }
+                    for (size_t i = 0; i < right_size; i++) {
+                        gains[left_size + i] =
+                            move_gain(middle[i], right_degrees, right_size, left_degrees, left_size);
+                    }
+                    reset_degrees(begin, end);
+
+                    sort_by_gain(begin, middle, gains.data());
+                    sort_by_gain(middle, end, gains.data() + left_size);
+
+                    size_t swaps = 0;
+                    for (size_t i = 0; i < std::min(left_size, right_size); i++) {
+                        if (gains[i] + gains[left_size + i] <= 0.0) {
+                            break;
+                        }
+                        std::swap(begin[i], middle[i]);
+                        swaps++;
+                    }
+                    if (swaps == 0) {
+                        break;
+                    }
+                }
+
+                run(begin, middle, depth + 1);
+                run(middle, end, depth + 1);
+            }
+        };
+
+    } // namespace
+
+    /**
+     * @brief Reorders the documents of a segment so that similar documents get nearby ids.
+     */
+    std::vector<DocId> recursive_graph_bisection(const forward_index &docs, uint32_t num_terms,
+                                                 const bisection_options &options) {
+        for (const auto &terms : docs) {
+            if (std::any_of(terms.begin(), terms.end(), [num_terms](uint32_t term) { return term >= num_terms; })) {
+                throw bridge_error("Term ordinal out of range");
+            }
+        }
+
+        std::vector<DocId> order(docs.size());
+        std::iota(order.begin(), order.end(), 0);
+
+        bisection state{docs, options, std::vector<uint32_t>(num_terms, 0), std::vector<uint32_t>(num_terms, 0), {}};
+        state.run(order.data(), order.data() + order.size(), 0);
+        return order;
+    }
+
+    /**
+     * @brief Inverts an order returned by recursive_graph_bisection.
+     */
+    std::vector<DocId> to_new_doc_ids(const std::vector<DocId> &order) {
+        std::vector<DocId> new_ids(order.size());
+        for (size_t new_id = 0; new_id < order.size(); new_id++) {
+            new_ids[order[new_id]] = static_cast<DocId>(new_id);
+        }
+        return new_ids;
+    }
+
+    /**
+     * @brief Estimates the size of the postings of a segment under a given order.
+     */
+    double log_gap_cost(const forward_index &docs, uint32_t num_terms, const std::vector<DocId> &order) {
+        std::vector<DocId> last_doc(num_terms, 0);
+        std::vector<bool> seen(num_terms, false);
+        double bits = 0.0;
+        for (size_t new_id = 0; new_id < order.size(); new_id++) {
+            for (uint32_t term : docs[order[new_id]]) {
+                DocId gap = seen[term] ? static_cast<DocId>(new_id) - last_doc[term] : static_cast<DocId>(new_id) + 1;
+                bits += std::log2(static_cast<double>(gap) + 1.0);
+                last_doc[term] = static_cast<DocId>(new_id);
+                seen[term] = true;
+            }
+        }
+        return bits;
+    }
+
+} // namespace bridge::index
@@ -0,0 +1,182 @@
+// Copyright (c) 2021 Bridge Project (Marcos Pontes)
+
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to
+//  deal in the Software without restriction, including without limitation the
+//  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+//  sell copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+//  IN THE SOFTWARE.
+
+#include <algorithm>
+#include <array>
+#include <cctype>
+
+#include "bridge/analyzer/analyzer.hpp"
+#include "bridge/error.hpp"
+#include "bridge/index/near_duplicates.hpp"
+
+namespace bridge::index {
+
+    namespace {
+
+        /// @brief FNV-1a followed by a 64 bits finalizer, so that every bit of a shingle hash is well mixed.
+        uint64_t hash_shingle(const std::vector<std::string> &tokens, size_t first, size_t size) {
+            uint64_t hash = 0xCBF29CE484222325ULL;
+            for (size_t t = first; t < first + size; t++) {
+                for (char c : tokens[t]) {
+                    hash = (hash ^ static_cast<uint8_t>(c)) * 0x100000001B3ULL;
+                }
+                hash = (hash ^ 0x1F) * 0x100000001B3ULL; // token separator
+            }
+            hash ^= hash >> 33;
+            hash *= 0xFF51AFD7ED558CCDULL;
+            hash ^= hash >> 33;
+            hash *= 0xC4CEB9FE1A85EC53ULL;
+            hash ^= hash >> 33;
+            return hash;
+        }
+
+    } // namespace
+
+    /**
+     * @brief SimHash of a sequence of tokens.
+     */
+    uint64_t simhash(const std::vector<std::string> &tokens, size_t shingle_size) {
+        if (shingle_size == 0) {
+            throw bridge_error("A shingle needs at least one token");
+        }
+        if (tokens.empty()) {
+            return 0;
+        }
+        size_t size = std::min(shingle_size, tokens.size());
+        std::array<int64_t, 64> votes{};
+        for (size_t first = 0; first + size <= tokens.size(); first++) {
+            uint64_t hash = hash_shingle(tokens, first, size);
+            for (size_t bit = 0; bit < 64; bit++) {
+                votes[bit] += static_cast<int64_t>((hash >> bit) & 1) * 2 - 1;
+            }
+        }
+        uint64_t signature = 0;
+        for (size_t bit = 0; bit < 64; bit++) {
+            signature |= static_cast<uint64_t>(votes[bit] > 0) << bit;
+        }
+        return signature;
+    }
+
+    /**
+     * @brief SimHash of a text, split into lowercase alphanumeric tokens.
+     */
+    uint64_t simhash_text(const std::string &text, size_t shingle_size) {
+        std::vector<std::string> tokens;
+        for (const auto &match : analyzer::alphanumeric_tokenizer(text)) {
+            std::string token = match.str();
+            std::transform(token.begin(), token.end(), token.begin(),
+                           [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+            tokens.push_back(std::move(token));
+        }
+        return simhash(tokens, shingle_size);
+    }
+
+    /**
+     * @brief Construct a new detector.
+     */
+    near_duplicate_detector::near_duplicate_detector(uint32_t max_distance, uint32_t num_bands)
+        : max_distance_(max_distance), num_bands_(num_bands), band_bits_(num_bands == 0 ? 0 : 64 / num_bands),
+          tables_(num_bands) {
+        if (num_bands == 0 || 64 % num_bands != 0) {
+            throw bridge_error("The number of bands must divide 64");
+        }
+        if (num_bands <= max_distance) {
+            throw bridge_error("The number of bands must exceed the maximum distance");
+        }
+    }
+
+    template <typename F> void near_duplicate_detector::for_each_candidate(uint64_t signature, F &&f) const {
+        for (uint32_t b = 0; b < num_bands_; b++) {
+            auto it = tables_[b].find(band(signature, b));
+            if (it == tables_[b].end()) {
+                continue;
+            }
+            for (uint32_t distinct : it->second) {
+                if (hamming_distance(distinct_signatures_[distinct], signature) <= max_distance_) {
+                    f(distinct_docs_[distinct]);
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief Finds the first indexed near duplicate of a signature.
+     */
+    std::optional<DocId> near_duplicate_detector::find(uint64_t signature) const {
+        std::optional<DocId> first;
+        for_each_candidate(signature, [&](const std::vector<DocId> &docs) {
+            if (!first || docs.front() < *first) {
+                first = docs.front();
+            }
+        });
+        return first;
+    }
+
+    /**
+     * @brief Every indexed near duplicate of a signature.
+     */
+    std::vector<DocId> near_duplicate_detector::near_duplicates(uint64_t signature) const {
+        std::vector<DocId> docs;
+        for_each_candidate(signature, [&](const std::vector<DocId> &found) {
+            docs.insert(docs.end(), found.begin(), found.end());
+        });
+        // a candidate sharing several bands is found several times
+        std::sort(docs.begin(), docs.end());
+        docs.erase(std::unique(docs.begin(), docs.end()), docs.end());
+        return docs;
+    }
+
+    /**
+     * @brief Adds the next document.
+     */
+    DocId near_duplicate_detector::add(uint64_t signature) {
+        auto doc = static_cast<DocId>(signatures_.size());
+        std::optional<DocId> duplicate = find(signature);
+        DocId cluster = duplicate ? static_cast<DocId>(clusters_[*duplicate]) : doc;
+
+        signatures_.push_back(signature);
+        clusters_.push_back(cluster);
+        auto [it, inserted] = distinct_.try_emplace(signature, static_cast<uint32_t>(distinct_docs_.size()));
+        if (inserted) {
+            distinct_signatures_.push_back(signature);
+            distinct_docs_.emplace_back();
+            for (uint32_t b = 0; b < num_bands_; b++) {
+                tables_[b][band(signature, b)].push_back(it->second);
+            }
+        }
+        distinct_docs_[it->second].push_back(doc);
+        return cluster;
+    }
+
+    /**
+     * @brief Fast field of the signatures, by doc id.
+     */
+    fastfield::numeric_column near_duplicate_detector::signature_column() const {
+        return fastfield::numeric_column::build(signatures_);
+    }
+
+    /**
+     * @brief Fast field of the clusters, by doc id.
+     */
+    fastfield::numeric_column near_duplicate_detector::cluster_column() const {
+        return fastfield::numeric_column::build(clusters_);
+    }
+
+} // namespace bridge::index
@@ -0,0 +1,51 @@
+// Copyright (c) 2021 Bridge Project (Marcos Pontes)
+
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to
+//  deal in the Software without restriction, including without limitation the
+//  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+//  sell copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+//  IN THE SOFTWARE.
+
+#include "bridge/error.hpp"
+#include "bridge/index/nested_blocks.hpp"
+
+namespace bridge::index {
+
+    /**
+     * @brief Appends a block.
+     */
+    DocId nested_block_writer::add_block(const std::vector<schema::document> &children,
+                                         const schema::document &parent) {
+        if (documents_.size() + children.size() + 1 >= postings::TERMINATED) {
+            throw bridge_error("Too many documents in the segment");
+        }
+        documents_.insert(documents_.end(), children.begin(), children.end());
+        documents_.push_back(parent);
+        parents_.push_back(num_docs() - 1);
+        return parents_.back();
+    }
+
+    /**
+     * @brief Builds the parent bit set of the segment.
+     */
+    postings::bit_set nested_block_writer::parents() const {
+        postings::bit_set set(num_docs());
+        for (DocId parent : parents_) {
+            set.insert(parent);
+        }
+        return set;
+    }
+
+} // namespace bridge::index
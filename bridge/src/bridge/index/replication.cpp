@@ -0,0 +1,296 @@
+// Copyright (c) 2021 Bridge Project (Marcos Pontes)
+
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to
+//  deal in the Software without restriction, including without limitation the
+//  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+//  sell copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+//  IN THE SOFTWARE.
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <fstream>
+#include <set>
+
+#include <fcntl.h>
+#include <unistd.h>
+#ifdef __linux__
+#include <linux/fs.h>
+#include <sys/ioctl.h>
+#endif
+
+#include "bridge/directory/directory.hpp"
+#include "bridge/error.hpp"
+#include "bridge/index/replication.hpp"
+
+namespace bridge::index {
+
+    namespace {
+
+        constexpr const char *temp_suffix = ".tmp";
+
+        [[noreturn]] void throw_errno(const std::string &what) {
+            throw directory::io_error(what + ": " + std::strerror(errno));
+        }
+
+        void sync_path(const std::filesystem::path &path, int flags) {
+            int fd = ::open(path.c_str(), flags | O_CLOEXEC);
+            if (fd < 0) {
+                throw_errno("Cannot open " + path.string());
+            }
+            int result = ::fsync(fd);
+            ::close(fd);
+            if (result != 0) {
+                throw_errno("Cannot sync " + path.string());
+            }
+        }
+
+        void sync_file(const std::filesystem::path &path) { sync_path(path, O_RDONLY); }
+
+        void sync_directory(const std::filesystem::path &path) { sync_path(path, O_RDONLY | O_DIRECTORY); }
+
+        /// @brief Durably and atomically replaces a small file: temporary file, sync, rename, directory sync.
+        void replace_file(const std::filesystem::path &directory, const std::string &name,
+                          const std::string &content) {
+            std::filesystem::path temp = directory / (name + temp_suffix);
+            {
+                std::ofstream out(temp, std::ios::trunc);
+                out << content;
+                if (!out.flush()) {
+                    throw directory::io_error("Cannot write " + temp.string());
+                }
+            }
+            sync_file(temp);
+            std::filesystem::rename(temp, directory / name);
+            sync_directory(directory);
+        }
+
+        /// @brief Refuses names that would escape the directory or clash with the files replication manages.
+        void check_file_name(const std::string &name) {
+            std::filesystem::path path(name);
+            if (name.empty() || name == "." || name == ".." || path.has_parent_path() || name == manifest_file_name ||
+                name == retired_file_name || name.ends_with(temp_suffix)) {
+                throw bridge_error("Invalid segment file name: " + name);
+            }
+        }
+
+        /// @brief Reads a manifest-formatted file of a directory, if it exists.
+        std::optional<segment_manifest> load_manifest(const std::filesystem::path &path) {
+            std::ifstream in(path);
+            if (!in) {
+                return std::nullopt;
+            }
+            try {
+                return segment_manifest::from_json(serialization::json_t::parse(in));
+            } catch (const serialization::json_t::exception &e) {
+                throw bridge_error(std::string("Corrupted manifest: ") + e.what());
+            }
+        }
+
+        const segment_file *find_file(const std::vector<segment_file> &files, const std::string &name) {
+            auto it = std::find_if(files.begin(), files.end(),
+                                   [&](const segment_file &file) { return file.name == name; });
+            return it == files.end() ? nullptr : &*it;
+        }
+
+        bool try_reflink(const std::filesystem::path &from, const std::filesystem::path &to) {
+#if defined(__linux__) && defined(FICLONE)
+            int in = ::open(from.c_str(), O_RDONLY | O_CLOEXEC);
+            if (in < 0) {
+                return false;
+            }
+            int out = ::open(to.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+            if (out < 0) {
+                ::close(in);
+                return false;
+            }
+            bool cloned = ::ioctl(out, FICLONE, in) == 0;
+            ::close(in);
+            ::close(out);
+            if (!cloned) {
+                std::filesystem::remove(to);
+            }
+            return cloned;
+#else
+            (void)from;
+            (void)to;
+            return false;
+#endif
+        }
+
+        /**
+         * @brief Transfers a file to its temporary name in the follower.
+         */
+        void transfer(const std::filesystem::path &from, const std::filesystem::path &to, copy_method method) {
+            std::error_code error;
+            if (method == copy_method::Auto || method == copy_method::HardLink) {
+                std::filesystem::create_hard_link(from, to, error);
+                if (!error) {
+                    return;
+                }
+                if (method == copy_method::HardLink) {
+                    throw directory::io_error("Cannot hard link " + from.string() + ": " + error.message());
+                }
+            }
+            if (method == copy_method::Auto || method == copy_method::Reflink) {
+                if (try_reflink(from, to)) {
+                    sync_file(to);
+                    return;
+                }
+                if (method == copy_method::Reflink) {
+                    throw directory::io_error("Cannot reflink " + from.string());
+                }
+            }
+            if (!std::filesystem::copy_file(from, to, std::filesystem::copy_options::overwrite_existing, error)) {
+                throw directory::io_error("Cannot copy " + from.string() + ": " + error.message());
+            }
+            sync_file(to);
+        }
+
+    } // namespace
+
+    serialization::json_t segment_manifest::to_json() const {
+        serialization::json_t json;
+        json["generation"] = generation;
+        json["files"] = serialization::json_t::array();
+        for (const auto &file : files) {
+            json["files"].push_back({{"name", file.name}, {"size", file.size}});
+        }
+        return json;
+    }
+
+    segment_manifest segment_manifest::from_json(const serialization::json_t &json) {
+        segment_manifest manifest;
+        try {
+            manifest.generation = json.at("generation").get<uint64_t>();
+            for (const auto &file : json.at("files")) {
+                manifest.files.push_back({file.at("name").get<std::string>(), file.at("size").get<uint64_t>()});
+            }
+        } catch (const std::exception &e) {
+            throw bridge_error(std::string("Corrupted manifest: ") + e.what());
+        }
+        for (const auto &file : manifest.files) {
+            check_file_name(file.name);
+        }
+        return manifest;
+    }
+
+    /**
+     * @brief Builds the manifest of files already written to a directory.
+     */
+    segment_manifest segment_manifest::of_files(const std::filesystem::path &directory,
+                                                std::vector<std::string> names, uint64_t generation) {
+        std::sort(names.begin(), names.end());
+        names.erase(std::unique(names.begin(), names.end()), names.end());
+        segment_manifest manifest;
+        manifest.generation = generation;
+        for (auto &name : names) {
+            check_file_name(name);
+            uint64_t size = std::filesystem::file_size(directory / name);
+            manifest.files.push_back({std::move(name), size});
+        }
+        return manifest;
+    }
+
+    /**
+     * @brief Reads the manifest of a directory, if it has one.
+     */
+    std::optional<segment_manifest> segment_manifest::load(const std::filesystem::path &directory) {
+        return load_manifest(directory / manifest_file_name);
+    }
+
+    /**
+     * @brief Durably and atomically replaces the manifest of a directory.
+     */
+    void segment_manifest::publish(const std::filesystem::path &directory) const {
+        replace_file(directory, manifest_file_name, to_json().dump());
+    }
+
+    /**
+     * @brief Brings a follower directory to the last commit of a leader directory.
+     */
+    replication_result replicate(const std::filesystem::path &leader, const std::filesystem::path &follower,
+                                 copy_method method) {
+        std::optional<segment_manifest> source = segment_manifest::load(leader);
+        if (!source) {
+            throw bridge_error("The leader has no commit");
+        }
+        std::filesystem::create_directories(follower);
+        segment_manifest previous = segment_manifest::load(follower).value_or(segment_manifest{});
+        segment_manifest retired = load_manifest(follower / retired_file_name).value_or(segment_manifest{});
+
+        replication_result result;
+        result.generation = source->generation;
+        if (source->generation < previous.generation) {
+            throw bridge_error("The follower is ahead of the leader");
+        }
+        if (*source == previous) {
+            result.files_reused = source->files.size();
+            return result;
+        }
+
+        // files are immutable: replacing one that is still on disk would change it under its readers
+        for (const auto &file : source->files) {
+            for (const auto *files : {&previous.files, &retired.files}) {
+                const segment_file *existing = find_file(*files, file.name);
+                if (existing != nullptr && existing->size != file.size) {
+                    throw bridge_error("The leader file " + file.name + " differs from the follower file");
+                }
+            }
+        }
+
+        for (const auto &file : source->files) {
+            std::filesystem::path target = follower / file.name;
+            if (find_file(previous.files, file.name) != nullptr || find_file(retired.files, file.name) != nullptr) {
+                result.files_reused++;
+                continue;
+            }
+            std::filesystem::path temp = follower / (file.name + temp_suffix);
+            std::filesystem::remove(temp);
+            transfer(leader / file.name, temp, method);
+            if (std::filesystem::file_size(temp) != file.size) {
+                std::filesystem::remove(temp);
+                throw bridge_error("The leader file " + file.name + " does not match its manifest");
+            }
+            std::filesystem::rename(temp, target);
+            result.files_copied++;
+            result.bytes_copied += file.size;
+        }
+        sync_directory(follower);
+        source->publish(follower);
+
+        // files of the commit before the previous one go now; those of the previous one stay for a generation
+        std::set<std::string> live;
+        for (const auto &file : source->files) {
+            live.insert(file.name);
+        }
+        for (const auto &file : retired.files) {
+            if (live.count(file.name) == 0 && find_file(previous.files, file.name) == nullptr &&
+                std::filesystem::remove(follower / file.name)) {
+                result.files_removed++;
+            }
+        }
+        segment_manifest retiring;
+        retiring.generation = source->generation;
+        for (const auto &file : previous.files) {
+            if (live.count(file.name) == 0) {
+                retiring.files.push_back(file);
+            }
+        }
+        replace_file(follower, retired_file_name, retiring.to_json().dump());
+        return result;
+    }
+
+} // namespace bridge::index
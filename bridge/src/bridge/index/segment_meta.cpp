@@ -0,0 +1,81 @@
+// Copyright (c) 2021 Bridge Project (Marcos Pontes)
+
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to
+//  deal in the Software without restriction, including without limitation the
+//  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+//  sell copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+//  IN THE SOFTWARE.
+
+#include "bridge/error.hpp"
+#include "bridge/index/segment_meta.hpp"
+
+namespace bridge::index {
+
+    /**
+     * @brief Records the range of a fast field of the segment.
+     */
+    void segment_meta::add_field(const std::string &field, const fastfield::numeric_column &column) {
+        if (column.num_docs() == 0) {
+            field_ranges.erase(field);
+            return;
+        }
+        field_ranges[field] = {column.min_raw(), column.max_raw()};
+    }
+
+    /**
+     * @brief Range of a fast field, if the segment has values for it.
+     */
+    std::optional<value_range> segment_meta::range(const std::string &field) const {
+        auto it = field_ranges.find(field);
+        if (it == field_ranges.end()) {
+            return std::nullopt;
+        }
+        return it->second;
+    }
+
+    /**
+     * @brief Checks whether some document may have a value of a field in a range.
+     */
+    bool segment_meta::may_match(const std::string &field, const value_range &filter) const {
+        auto it = field_ranges.find(field);
+        return it != field_ranges.end() && it->second.intersects(filter);
+    }
+
+    serialization::json_t segment_meta::to_json() const {
+        serialization::json_t json;
+        json["name"] = name;
+        json["num_docs"] = num_docs;
+        json["field_ranges"] = serialization::json_t::object();
+        for (const auto &[field, range] : field_ranges) {
+            json["field_ranges"][field] = {{"min", range.min_raw}, {"max", range.max_raw}};
+        }
+        return json;
+    }
+
+    segment_meta segment_meta::from_json(const serialization::json_t &json) {
+        segment_meta meta;
+        try {
+            meta.name = json.at("name").get<std::string>();
+            meta.num_docs = json.at("num_docs").get<uint32_t>();
+            for (const auto &[field, range] : json.at("field_ranges").items()) {
+                meta.field_ranges[field] = {range.at("min").get<uint64_t>(), range.at("max").get<uint64_t>()};
+            }
+        } catch (const std::exception &e) {
+            throw bridge_error(std::string("Corrupted segment meta: ") + e.what());
+        }
+        return meta;
+    }
+
+} // namespace bridge::index
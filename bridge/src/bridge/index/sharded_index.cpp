@@ -0,0 +1,365 @@
+// Copyright (c) 2021 Bridge Project (Marcos Pontes)
+
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to
+//  deal in the Software without restriction, including without limitation the
+//  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+//  sell copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+//  IN THE SOFTWARE.
+
+#include <algorithm>
+#include <fstream>
+#include <future>
+#include <mutex>
+#include <optional>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "bridge/analyzer/analyzer.hpp"
+#include "bridge/collector/top_docs.hpp"
+#include "bridge/common/serialization.hpp"
+#include "bridge/common/vint.hpp"
+#include "bridge/directory/directory.hpp"
+#include "bridge/error.hpp"
+#include "bridge/index/sharded_index.hpp"
+#include "bridge/postings/vec_postings.hpp"
+#include "bridge/query/bm25f_scorer.hpp"
+
+namespace bridge::index {
+
+    namespace {
+
+        constexpr const char *wal_file_name = "wal.log";
+        constexpr const char *shards_file_name = "shards.json";
+
+        /// @brief FNV-1a, stable across platforms and runs, unlike std::hash.
+        uint64_t fnv1a(const bridge::byte_t *data, size_t size) {
+            uint64_t hash = 0xCBF29CE484222325ULL;
+            for (size_t i = 0; i < size; i++) {
+                hash = (hash ^ static_cast<uint8_t>(data[i])) * 0x100000001B3ULL;
+            }
+            return hash;
+        }
+
+        /// @brief Path of the log of a shard, creating the directory of the shard if needed.
+        std::filesystem::path shard_wal_path(const std::filesystem::path &directory) {
+            std::filesystem::create_directories(directory);
+            return directory / wal_file_name;
+        }
+
+        void sync_path(const std::filesystem::path &path, int flags) {
+            int fd = ::open(path.c_str(), flags | O_CLOEXEC);
+            if (fd < 0 || ::fsync(fd) != 0) {
+                if (fd >= 0) {
+                    ::close(fd);
+                }
+                throw directory::io_error("Cannot sync " + path.string());
+            }
+            ::close(fd);
+        }
+
+        /// @brief Number of shards recorded under the root, if the index has been created.
+        std::optional<uint32_t> load_num_shards(const std::filesystem::path &root) {
+            std::ifstream in(root / shards_file_name);
+            if (!in) {
+                return std::nullopt;
+            }
+            try {
+                return serialization::json_t::parse(in).at("num_shards").get<uint32_t>();
+            } catch (const std::exception &e) {
+                throw bridge_error(std::string("Corrupted shard metadata: ") + e.what());
+            }
+        }
+
+        /// @brief Durably records the number of shards, before any shard is created.
+        void store_num_shards(const std::filesystem::path &root, uint32_t num_shards) {
+            std::filesystem::create_directories(root);
+            std::filesystem::path temp = root / (std::string(shards_file_name) + ".tmp");
+            {
+                std::ofstream out(temp, std::ios::trunc);
+                out << serialization::json_t{{"num_shards", num_shards}}.dump();
+                if (!out.flush()) {
+                    throw directory::io_error("Cannot write " + temp.string());
+                }
+            }
+            sync_path(temp, O_RDONLY);
+            std::filesystem::rename(temp, root / shards_file_name);
+            sync_path(root, O_RDONLY | O_DIRECTORY);
+        }
+
+        /// @brief Runs a function on every shard in parallel and returns the results by shard.
+        template <typename F>
+        auto fan_out(size_t num_shards, F &&function) -> std::vector<decltype(function(size_t{}))> {
+            std::vector<std::future<decltype(function(size_t{}))>> futures;
+            futures.reserve(num_shards);
+            for (size_t shard = 0; shard < num_shards; shard++) {
+                futures.push_back(std::async(std::launch::async, function, shard));
+            }
+            std::vector<decltype(function(size_t{}))> results;
+            results.reserve(num_shards);
+            for (auto &future : futures) {
+                results.push_back(future.get());
+            }
+            return results;
+        }
+
+    } // namespace
+
+    /**
+     * @brief Adds the statistics of another shard.
+     */
+    void search_statistics::merge(const search_statistics &other) {
+        if (doc_freqs.size() != other.doc_freqs.size()) {
+            throw bridge_error("The statistics are not those of the same query");
+        }
+        num_docs += other.num_docs;
+        total_tokens += other.total_tokens;
+        for (size_t t = 0; t < doc_freqs.size(); t++) {
+            doc_freqs[t] += other.doc_freqs[t];
+        }
+    }
+
+    /**
+     * @brief Opens a shard, creating its directory if needed.
+     */
+    index_shard::index_shard(const std::filesystem::path &directory, wal_options options)
+        : wal_(shard_wal_path(directory), options) {
+        write_ahead_log::replay(directory / wal_file_name, [this](const wal_record &record) {
+            if (record.op != wal_op::AddDocuments) {
+                throw bridge_error("Unsupported operation in the shard log");
+            }
+            for (const auto &document : record.documents) {
+                index(document);
+            }
+        });
+    }
+
+    /**
+     * @brief Logs and indexes a batch of documents.
+     */
+    uint64_t index_shard::add_documents(const std::vector<schema::document> &documents) {
+        std::unique_lock lock(mutex_);
+        uint64_t sequence = wal_.add_documents(documents);
+        for (const auto &document : documents) {
+            index(document);
+        }
+        return sequence;
+    }
+
+    void index_shard::index(const schema::document &document) {
+        auto doc = static_cast<DocId>(documents_.size());
+        documents_.push_back(document);
+
+        std::unordered_map<schema::id_t, std::unordered_map<std::string, uint32_t>> term_freqs;
+        for (const auto &field : document.get_fields()) {
+            if (!std::holds_alternative<schema::text_field>(field)) {
+                continue;
+            }
+            const auto &text = std::get<schema::text_field>(field);
+            auto &freqs = term_freqs[text.get_id()];
+            for (const auto &token : analyzer::alphanumeric_tokenizer(*text.get_value())) {
+                freqs[token.str()]++;
+            }
+        }
+        for (const auto &[id, freqs] : term_freqs) {
+            field_index &field = fields_[id];
+            uint32_t norm = 0;
+            for (const auto &[term, freq] : freqs) {
+                field.postings[term].emplace_back(doc, freq);
+                norm += freq;
+            }
+            field.field_norms.resize(doc + 1, 0);
+            field.field_norms[doc] = norm;
+            field.total_tokens += norm;
+        }
+    }
+
+    /**
+     * @brief Number of documents of the shard.
+     */
+    uint64_t index_shard::num_docs() const {
+        std::shared_lock lock(mutex_);
+        return documents_.size();
+    }
+
+    /**
+     * @brief Get a document.
+     */
+    schema::document index_shard::document(DocId doc) const {
+        std::shared_lock lock(mutex_);
+        if (doc >= documents_.size()) {
+            throw bridge_error("Doc id out of the shard range");
+        }
+        return documents_[doc];
+    }
+
+    /**
+     * @brief Local statistics of a query.
+     */
+    search_statistics index_shard::statistics(schema::id_t field, const std::vector<std::string> &terms) const {
+        std::shared_lock lock(mutex_);
+        search_statistics stats;
+        stats.num_docs = documents_.size();
+        stats.doc_freqs.resize(terms.size(), 0);
+        auto it = fields_.find(field);
+        if (it == fields_.end()) {
+            return stats;
+        }
+        stats.total_tokens = it->second.total_tokens;
+        for (size_t t = 0; t < terms.size(); t++) {
+            auto postings = it->second.postings.find(terms[t]);
+            if (postings != it->second.postings.end()) {
+                stats.doc_freqs[t] = postings->second.size();
+            }
+        }
+        return stats;
+    }
+
+    /**
+     * @brief BM25 top-k of a query.
+     */
+    std::vector<collector::hit> index_shard::search(schema::id_t field, const std::vector<std::string> &terms,
+                                                    const search_statistics &stats, size_t k) const {
+        if (stats.doc_freqs.size() != terms.size()) {
+            throw bridge_error("The statistics are not those of the query");
+        }
+        std::shared_lock lock(mutex_);
+        auto it = fields_.find(field);
+        if (it == fields_.end() || stats.num_docs == 0) {
+            return {};
+        }
+
+        Score average_field_norm =
+            std::max(1.0F, static_cast<Score>(stats.total_tokens) / static_cast<Score>(stats.num_docs));
+        std::vector<query::bm25f_field> fields = {{1.0F, &it->second.field_norms, average_field_norm}};
+        std::vector<query::bm25f_term> query_terms;
+        for (size_t t = 0; t < terms.size(); t++) {
+            query::bm25f_term term{scoring::idf(stats.doc_freqs[t], stats.num_docs), {}};
+            auto postings = it->second.postings.find(terms[t]);
+            if (postings != it->second.postings.end()) {
+                term.postings.push_back(std::make_unique<postings::vec_postings>(postings->second));
+            } else {
+                term.postings.push_back(nullptr);
+            }
+            query_terms.push_back(std::move(term));
+        }
+
+        query::bm25f_scorer scorer(std::move(fields), std::move(query_terms));
+        collector::top_docs_collector top(k);
+        collector::collect_all(scorer, top);
+        return top.hits();
+    }
+
+    /**
+     * @brief Opens a sharded index, creating it if needed.
+     */
+    sharded_index::sharded_index(const std::filesystem::path &root, uint32_t num_shards, schema::id_t routing_field,
+                                 wal_options options)
+        : routing_field_(routing_field) {
+        if (num_shards == 0) {
+            throw bridge_error("A sharded index needs at least one shard");
+        }
+        // the shard of a document depends on the number of shards, so it is fixed once the index exists
+        if (std::optional<uint32_t> created = load_num_shards(root)) {
+            if (*created != num_shards) {
+                throw bridge_error("The index was created with " + std::to_string(*created) + " shards");
+            }
+        } else {
+            store_num_shards(root, num_shards);
+        }
+        for (uint32_t shard = 0; shard < num_shards; shard++) {
+            shards_.push_back(std::make_unique<index_shard>(root / ("shard_" + std::to_string(shard)), options));
+        }
+    }
+
+    /**
+     * @brief Shard of a document.
+     */
+    uint32_t sharded_index::shard_of(const schema::document &document) const {
+        auto [first, last] = document.get_first_by_id(routing_field_);
+        if (first == last) {
+            throw bridge_error("The document has no routing field");
+        }
+        uint64_t hash = 0;
+        if (std::holds_alternative<schema::text_field>(*first)) {
+            std::string value = *std::get<schema::text_field>(*first).get_value();
+            hash = fnv1a(value.data(), value.size());
+        } else {
+            std::vector<bridge::byte_t> bytes;
+            common::write_fixed(bytes, *std::get<schema::uint32_field>(*first).get_value());
+            hash = fnv1a(bytes.data(), bytes.size());
+        }
+        return static_cast<uint32_t>(hash % shards_.size());
+    }
+
+    /**
+     * @brief Adds documents and waits until they are durable.
+     */
+    void sharded_index::add_documents(const std::vector<schema::document> &documents) {
+        std::vector<std::vector<schema::document>> batches(shards_.size());
+        for (const auto &document : documents) {
+            batches[shard_of(document)].push_back(document);
+        }
+        // each shard logs, indexes and syncs its batch on its own, so the fdatasyncs overlap
+        fan_out(shards_.size(), [&](size_t shard) {
+            if (!batches[shard].empty()) {
+                shards_[shard]->sync(shards_[shard]->add_documents(batches[shard]));
+            }
+            return batches[shard].size();
+        });
+    }
+
+    /**
+     * @brief Global statistics of a query.
+     */
+    search_statistics sharded_index::statistics(schema::id_t field, const std::vector<std::string> &terms) const {
+        auto per_shard =
+            fan_out(shards_.size(), [&](size_t shard) { return shards_[shard]->statistics(field, terms); });
+        search_statistics stats;
+        stats.doc_freqs.resize(terms.size(), 0);
+        for (const auto &shard_stats : per_shard) {
+            stats.merge(shard_stats);
+        }
+        return stats;
+    }
+
+    /**
+     * @brief BM25 top-k of a query over every shard.
+     */
+    std::vector<shard_hit> sharded_index::search(schema::id_t field, const std::vector<std::string> &terms,
+                                                 size_t k) const {
+        search_statistics stats = statistics(field, terms);
+        auto per_shard =
+            fan_out(shards_.size(), [&](size_t shard) { return shards_[shard]->search(field, terms, stats, k); });
+
+        std::vector<shard_hit> hits;
+        for (uint32_t shard = 0; shard < per_shard.size(); shard++) {
+            for (const auto &hit : per_shard[shard]) {
+                hits.push_back({shard, hit.doc, hit.score});
+            }
+        }
+        auto by_rank = [](const shard_hit &a, const shard_hit &b) {
+            if (a.score != b.score) {
+                return a.score > b.score;
+            }
+            return a.shard != b.shard ? a.shard < b.shard : a.doc < b.doc;
+        };
+        size_t n = std::min(k, hits.size());
+        std::partial_sort(hits.begin(), hits.begin() + static_cast<long>(n), hits.end(), by_rank);
+        hits.resize(n);
+        return hits;
+    }
+
+} // namespace bridge::index
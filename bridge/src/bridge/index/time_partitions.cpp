@@ -0,0 +1,134 @@
+// Copyright (c) 2021 Bridge Project (Marcos Pontes)
+
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to
+//  deal in the Software without restriction, including without limitation the
+//  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+//  sell copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+//  IN THE SOFTWARE.
+
+#include "bridge/error.hpp"
+#include "bridge/index/time_partitions.hpp"
+
+namespace bridge::index {
+
+    /**
+     * @brief Construct a new manager.
+     */
+    time_partitioned_index::time_partitioned_index(std::string time_field, int64_t window)
+        : time_field_(std::move(time_field)), window_(window) {
+        if (window <= 0) {
+            throw bridge_error("The time window must be positive");
+        }
+    }
+
+    /**
+     * @brief First timestamp of the window holding a timestamp.
+     */
+    int64_t time_partitioned_index::window_start(int64_t timestamp) const {
+        int64_t offset = timestamp % window_;
+        return timestamp - (offset < 0 ? offset + window_ : offset); // floor, also for negative timestamps
+    }
+
+    /**
+     * @brief Adds a segment to the partition of its window, creating the partition if needed.
+     */
+    const time_partition &time_partitioned_index::add_segment(segment_meta segment) {
+        std::optional<value_range> range = segment.range(time_field_);
+        if (!range) {
+            throw bridge_error("The segment has no time range");
+        }
+        int64_t start = window_start(fastfield::i64_from_sortable(range->min_raw));
+        if (window_start(fastfield::i64_from_sortable(range->max_raw)) != start) {
+            throw bridge_error("The segment spans several time windows");
+        }
+
+        auto [it, created] = partitions_.try_emplace(start, time_partition{start, start + window_, {}});
+        it->second.segments.push_back(std::move(segment));
+        return it->second;
+    }
+
+    /**
+     * @brief Drops the partitions whose window ends before a timestamp.
+     */
+    std::vector<time_partition> time_partitioned_index::expire(int64_t before) {
+        std::vector<time_partition> expired;
+        auto it = partitions_.begin();
+        while (it != partitions_.end() && it->second.end <= before) {
+            expired.push_back(std::move(it->second));
+            it = partitions_.erase(it);
+        }
+        return expired;
+    }
+
+    /**
+     * @brief Selects the segments that may hold documents within a time range.
+     */
+    partition_selection time_partitioned_index::select(int64_t from, int64_t to) const {
+        partition_selection selection;
+        if (from > to) {
+            return selection;
+        }
+        value_range filter = value_range::of(from, to);
+        // windows are disjoint and ordered, so the overlapping ones are contiguous
+        for (auto it = partitions_.lower_bound(window_start(from)); it != partitions_.end() && it->first <= to;
+             ++it) {
+            selection.partitions_visited++;
+            for (const auto &segment : it->second.segments) {
+                if (segment.may_match(time_field_, filter)) {
+                    selection.segments.push_back(&segment);
+                } else {
+                    selection.segments_skipped++;
+                }
+            }
+        }
+        return selection;
+    }
+
+    serialization::json_t time_partitioned_index::to_json() const {
+        serialization::json_t json;
+        json["time_field"] = time_field_;
+        json["window"] = window_;
+        json["partitions"] = serialization::json_t::array();
+        for (const auto &[start, partition] : partitions_) {
+            serialization::json_t segments = serialization::json_t::array();
+            for (const auto &segment : partition.segments) {
+                segments.push_back(segment.to_json());
+            }
+            json["partitions"].push_back({{"start", start}, {"segments", segments}});
+        }
+        return json;
+    }
+
+    time_partitioned_index time_partitioned_index::from_json(const serialization::json_t &json) {
+        try {
+            time_partitioned_index index(json.at("time_field").get<std::string>(), json.at("window").get<int64_t>());
+            for (const auto &partition : json.at("partitions")) {
+                auto start = partition.at("start").get<int64_t>();
+                if (index.window_start(start) != start) {
+                    throw bridge_error("Misaligned time partition");
+                }
+                time_partition &target = index.partitions_[start];
+                target = {start, start + index.window_, {}};
+                for (const auto &segment : partition.at("segments")) {
+                    target.segments.push_back(segment_meta::from_json(segment));
+                }
+            }
+            return index;
+        } catch (const serialization::json_t::exception &e) {
+            throw bridge_error(std::string("Corrupted time partitions: ") + e.what());
+        }
+    }
+
+} // namespace bridge::index
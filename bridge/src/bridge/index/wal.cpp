@@ -0,0 +1,471 @@
+// Copyright (c) 2021 Bridge Project (Marcos Pontes)
+
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to
+//  deal in the Software without restriction, including without limitation the
+//  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+//  sell copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+//  IN THE SOFTWARE.
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <thread>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "bridge/common/crc32.hpp"
+#include "bridge/common/vint.hpp"
+#include "bridge/directory/directory.hpp"
+#include "bridge/index/wal.hpp"
+
+namespace bridge::index {
+
+    namespace {
+
+        constexpr uint32_t wal_magic = 0x4C415742; // "BWAL"
+        constexpr size_t header_size = sizeof(uint32_t) + sizeof(uint64_t);
+        constexpr size_t record_header_size = 2 * sizeof(uint32_t);
+        constexpr size_t sequence_offset = 0; // the sequence number starts the payload
+        constexpr const char *temp_suffix = ".tmp";
+
+        enum class field_type : uint8_t { Text = 0, U32 = 1 };
+
+        [[noreturn]] void throw_errno(const std::string &what) {
+            throw directory::io_error(what + ": " + std::strerror(errno));
+        }
+
+        void encode_document(std::vector<bridge::byte_t> &out, const schema::document &document) {
+            const auto &fields = document.get_fields();
+            common::write_vint(out, fields.size());
+            for (const auto &field : fields) {
+                if (std::holds_alternative<schema::text_field>(field)) {
+                    const auto &text = std::get<schema::text_field>(field);
+                    std::string value = *text.get_value();
+                    out.push_back(static_cast<bridge::byte_t>(text.get_id()));
+                    out.push_back(static_cast<bridge::byte_t>(field_type::Text));
+                    common::write_vint(out, value.size());
+                    out.insert(out.end(), value.begin(), value.end());
+                } else {
+                    const auto &number = std::get<schema::uint32_field>(field);
+                    out.push_back(static_cast<bridge::byte_t>(number.get_id()));
+                    out.push_back(static_cast<bridge::byte_t>(field_type::U32));
+                    common::write_vint(out, *number.get_value());
+                }
+            }
+        }
+
+        schema::document decode_document(const bridge::byte_t *&data, const bridge::byte_t *end) {
+            schema::document document;
+            uint64_t num_fields = common::read_vint(data, end);
+            for (uint64_t i = 0; i < num_fields; i++) {
+                if (end - data < 2) {
+                    throw bridge_error("Corrupted write-ahead log record");
+                }
+                auto id = static_cast<schema::id_t>(*data++);
+                auto type = static_cast<field_type>(*data++);
+                if (type == field_type::Text) {
+                    uint64_t length = common::read_vint(data, end);
+                    if (static_cast<uint64_t>(end - data) < length) {
+                        throw bridge_error("Corrupted write-ahead log record");
+                    }
+                    document.add_text(id, std::string(data, data + length));
+                    data += length;
+                } else if (type == field_type::U32) {
+                    document.add_u32(id, static_cast<uint32_t>(common::read_vint(data, end)));
+                } else {
+                    throw bridge_error("Corrupted write-ahead log record");
+                }
+            }
+            return document;
+        }
+
+        wal_record decode_record(const bridge::byte_t *data, const bridge::byte_t *end) {
+            wal_record record;
+            if (end - data < static_cast<std::ptrdiff_t>(sizeof(uint64_t) + 1)) {
+                throw bridge_error("Corrupted write-ahead log record");
+            }
+            record.sequence = common::read_fixed<uint64_t>(data + sequence_offset);
+            data += sizeof(uint64_t);
+            record.op = static_cast<wal_op>(*data++);
+            uint64_t count = common::read_vint(data, end);
+            if (record.op == wal_op::AddDocuments) {
+                for (uint64_t i = 0; i < count; i++) {
+                    record.documents.push_back(decode_document(data, end));
+                }
+            } else if (record.op == wal_op::DeleteTerms) {
+                for (uint64_t i = 0; i < count; i++) {
+                    uint64_t length = common::read_vint(data, end);
+                    if (static_cast<uint64_t>(end - data) < length) {
+                        throw bridge_error("Corrupted write-ahead log record");
+                    }
+                    std::vector<bridge::byte_t> bytes(data, data + length);
+                    record.terms.emplace_back(bytes.data(), bytes.size());
+                    data += length;
+                }
+            } else {
+                throw bridge_error("Corrupted write-ahead log record");
+            }
+            return record;
+        }
+
+        /**
+         * @brief Result of a scan of the log: where the valid records end and the last sequence number.
+         */
+        struct scan_result {
+            size_t valid_size;
+            uint64_t last_sequence;
+        };
+
+        /**
+         * @brief Walks the records of a log, stopping at the first torn or corrupted one.
+         * @details A log shorter than its header holds no record, it was torn while being created: its valid
+         * size is 0.
+         */
+        scan_result scan(const std::vector<bridge::byte_t> &bytes,
+                         const std::function<void(const bridge::byte_t *, const bridge::byte_t *)> &on_record) {
+            if (bytes.size() < header_size) {
+                return {0, 0};
+            }
+            if (common::read_fixed<uint32_t>(bytes.data()) != wal_magic) {
+                throw bridge_error("Not a write-ahead log");
+            }
+            scan_result result{header_size, common::read_fixed<uint64_t>(bytes.data() + sizeof(uint32_t))};
+            const bridge::byte_t *data = bytes.data() + header_size;
+            const bridge::byte_t *end = bytes.data() + bytes.size();
+            while (end - data >= static_cast<std::ptrdiff_t>(record_header_size)) {
+                uint32_t length = common::read_fixed<uint32_t>(data);
+                uint32_t checksum = common::read_fixed<uint32_t>(data + sizeof(uint32_t));
+                const bridge::byte_t *payload = data + record_header_size;
+                if (static_cast<uint64_t>(end - payload) < length || length < sizeof(uint64_t) ||
+                    common::crc32(payload, length) != checksum) {
+                    break; // torn write at the end of the log
+                }
+                uint64_t sequence = common::read_fixed<uint64_t>(payload + sequence_offset);
+                if (sequence <= result.last_sequence) {
+                    break;
+                }
+                if (on_record) {
+                    on_record(payload, payload + length);
+                }
+                result.last_sequence = sequence;
+                data = payload + length;
+                result.valid_size = static_cast<size_t>(data - bytes.data());
+            }
+            return result;
+        }
+
+        std::vector<bridge::byte_t> read_file(const std::filesystem::path &path) {
+            std::ifstream in(path, std::ios::binary);
+            if (!in) {
+                throw directory::io_error("Cannot read the write-ahead log " + path.string());
+            }
+            return {std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>()};
+        }
+
+        void sync_directory(const std::filesystem::path &path) {
+            std::filesystem::path parent = path.parent_path().empty() ? "." : path.parent_path();
+            int fd = ::open(parent.c_str(), O_RDONLY | O_DIRECTORY);
+            if (fd >= 0) {
+                (void)::fsync(fd);
+                ::close(fd);
+            }
+        }
+
+        void write_all(int fd, const std::vector<bridge::byte_t> &bytes, const std::filesystem::path &path) {
+            const bridge::byte_t *data = bytes.data();
+            size_t remaining = bytes.size();
+            while (remaining > 0) {
+                ssize_t written = ::write(fd, data, remaining);
+                if (written < 0) {
+                    if (errno == EINTR) {
+                        continue;
+                    }
+                    throw_errno("Cannot write the write-ahead log " + path.string());
+                }
+                data += written;
+                remaining -= static_cast<size_t>(written);
+            }
+        }
+
+        std::vector<bridge::byte_t> encode_header(uint64_t first_sequence) {
+            std::vector<bridge::byte_t> header;
+            common::write_fixed(header, wal_magic);
+            common::write_fixed(header, first_sequence);
+            return header;
+        }
+
+        /**
+         * @brief Appends to out the records of a buffer whose sequence number is larger than after.
+         * @details The records must be valid, i.e. already scanned or built by this process.
+         */
+        void copy_records_after(const bridge::byte_t *data, const bridge::byte_t *end, uint64_t after,
+                                std::vector<bridge::byte_t> &out) {
+            while (data < end) {
+                uint32_t length = common::read_fixed<uint32_t>(data);
+                const bridge::byte_t *next = data + record_header_size + length;
+                if (common::read_fixed<uint64_t>(data + record_header_size + sequence_offset) > after) {
+                    out.insert(out.end(), data, next);
+                }
+                data = next;
+            }
+        }
+
+    } // namespace
+
+    /**
+     * @brief Opens a log, creating it if needed.
+     */
+    write_ahead_log::write_ahead_log(std::filesystem::path path, wal_options options)
+        : path_(std::move(path)), options_(options) {
+        // a crash during a reset may leave its temporary log behind, the log itself is still the old one
+        std::filesystem::remove(path_.string() + temp_suffix);
+
+        scan_result scanned{0, 0};
+        if (std::filesystem::exists(path_)) {
+            scanned = scan(read_file(path_), nullptr);
+        }
+
+        fd_ = ::open(path_.c_str(), O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC, 0644);
+        if (fd_ < 0) {
+            throw_errno("Cannot open the write-ahead log " + path_.string());
+        }
+        if (scanned.valid_size == 0) {
+            // a new log, or one whose header was torn: the header must be durable before any record follows
+            try {
+                if (::ftruncate(fd_, 0) != 0) {
+                    throw_errno("Cannot truncate the write-ahead log " + path_.string());
+                }
+                write_all(fd_, encode_header(0), path_);
+                if (::fdatasync(fd_) != 0) {
+                    throw_errno("Cannot sync the write-ahead log " + path_.string());
+                }
+            } catch (...) {
+                ::close(fd_);
+                throw;
+            }
+            sync_directory(path_);
+            scanned.valid_size = header_size;
+        } else if (std::filesystem::file_size(path_) > scanned.valid_size) {
+            // cut off the torn record, so that new records follow the valid ones
+            if (::ftruncate(fd_, static_cast<off_t>(scanned.valid_size)) != 0 || ::fdatasync(fd_) != 0) {
+                int error = errno;
+                ::close(fd_);
+                errno = error;
+                throw_errno("Cannot truncate the write-ahead log " + path_.string());
+            }
+        }
+        last_sequence_ = durable_sequence_ = scanned.last_sequence;
+        durable_size_ = scanned.valid_size;
+    }
+
+    /**
+     * @brief Flushes the buffered records and closes the log.
+     */
+    write_ahead_log::~write_ahead_log() {
+        try {
+            sync();
+        } catch (...) { // NOLINT(bugprone-empty-catch): a destructor must not throw, the batches were not acked
+        }
+        ::close(fd_);
+    }
+
+    /**
+     * @brief Buffers a batch of documents.
+     */
+    uint64_t write_ahead_log::add_documents(const std::vector<schema::document> &documents) {
+        std::vector<bridge::byte_t> payload(sizeof(uint64_t));
+        payload.push_back(static_cast<bridge::byte_t>(wal_op::AddDocuments));
+        common::write_vint(payload, documents.size());
+        for (const auto &document : documents) {
+            encode_document(payload, document);
+        }
+        return append(std::move(payload));
+    }
+
+    /**
+     * @brief Buffers a batch of deletes.
+     */
+    uint64_t write_ahead_log::delete_terms(const std::vector<schema::term> &terms) {
+        std::vector<bridge::byte_t> payload(sizeof(uint64_t));
+        payload.push_back(static_cast<bridge::byte_t>(wal_op::DeleteTerms));
+        common::write_vint(payload, terms.size());
+        for (const auto &term : terms) {
+            common::write_vint(payload, term.size());
+            payload.insert(payload.end(), term.as_ref(), term.as_ref() + term.size());
+        }
+        return append(std::move(payload));
+    }
+
+    uint64_t write_ahead_log::append(std::vector<bridge::byte_t> &&payload) {
+        std::lock_guard lock(mutex_);
+        check_not_failed();
+        uint64_t sequence = ++last_sequence_;
+        for (size_t i = 0; i < sizeof(uint64_t); i++) {
+            payload[sequence_offset + i] = static_cast<bridge::byte_t>(sequence >> (8 * i));
+        }
+        common::write_fixed(pending_, static_cast<uint32_t>(payload.size()));
+        common::write_fixed(pending_, common::crc32(payload.data(), payload.size()));
+        pending_.insert(pending_.end(), payload.begin(), payload.end());
+        return sequence;
+    }
+
+    /**
+     * @brief Waits until a batch is durable.
+     */
+    void write_ahead_log::sync(uint64_t sequence) {
+        std::unique_lock lock(mutex_);
+        if (sequence > last_sequence_) {
+            throw bridge_error("Cannot sync a batch that was not written to the write-ahead log");
+        }
+        while (durable_sequence_ < sequence) {
+            check_not_failed();
+            if (flushing_) {
+                flushed_.wait(lock);
+                continue;
+            }
+
+            // this writer leads the group: it flushes the records of every waiting writer
+            flushing_ = true;
+            if (options_.group_delay.count() > 0) {
+                lock.unlock();
+                std::this_thread::sleep_for(options_.group_delay);
+                lock.lock();
+            }
+            std::vector<bridge::byte_t> group;
+            group.swap(pending_);
+            uint64_t group_sequence = last_sequence_;
+            lock.unlock();
+
+            try {
+                write_all(fd_, group, path_);
+                if (::fdatasync(fd_) != 0) {
+                    throw_errno("Cannot sync the write-ahead log " + path_.string());
+                }
+            } catch (...) {
+                // the group may be partly on disk and its records are lost: cut off the torn bytes so that
+                // nothing is ever appended after them, and refuse any further write
+                (void)::ftruncate(fd_, static_cast<off_t>(durable_size_));
+                lock.lock();
+                failed_ = true;
+                flushing_ = false;
+                flushed_.notify_all();
+                throw;
+            }
+            lock.lock();
+            durable_size_ += group.size();
+            durable_sequence_ = group_sequence;
+            num_syncs_++;
+            flushing_ = false;
+            flushed_.notify_all();
+        }
+    }
+
+    /**
+     * @brief Sequence number of the last buffered batch, 0 if none.
+     */
+    uint64_t write_ahead_log::last_sequence() const {
+        std::lock_guard lock(mutex_);
+        return last_sequence_;
+    }
+
+    /**
+     * @brief Sequence number of the last durable batch, 0 if none.
+     */
+    uint64_t write_ahead_log::durable_sequence() const {
+        std::lock_guard lock(mutex_);
+        return durable_sequence_;
+    }
+
+    /**
+     * @brief Number of fdatasync calls since the log was opened.
+     */
+    uint64_t write_ahead_log::num_syncs() const {
+        std::lock_guard lock(mutex_);
+        return num_syncs_;
+    }
+
+    /**
+     * @brief Drops the batches that are in a committed segment.
+     */
+    void write_ahead_log::reset(uint64_t committed) {
+        std::unique_lock lock(mutex_);
+        flushed_.wait(lock, [this] { return !flushing_; });
+        check_not_failed();
+        if (committed > last_sequence_) {
+            throw bridge_error("Cannot reset the write-ahead log past its last batch");
+        }
+
+        // the new log is built aside and renamed over the old one, so a crash leaves either of them
+        std::vector<bridge::byte_t> durable = read_file(path_);
+        std::vector<bridge::byte_t> kept = encode_header(committed);
+        copy_records_after(durable.data() + header_size, durable.data() + durable_size_, committed, kept);
+
+        std::filesystem::path temp = path_.string() + temp_suffix;
+        int fd = ::open(temp.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_APPEND | O_CLOEXEC, 0644);
+        if (fd < 0) {
+            throw_errno("Cannot create the write-ahead log " + temp.string());
+        }
+        try {
+            write_all(fd, kept, temp);
+            if (::fdatasync(fd) != 0) {
+                throw_errno("Cannot sync the write-ahead log " + temp.string());
+            }
+            std::filesystem::rename(temp, path_);
+        } catch (...) {
+            ::close(fd);
+            std::filesystem::remove(temp);
+            throw;
+        }
+        sync_directory(path_);
+        ::close(fd_);
+        fd_ = fd;
+        durable_size_ = kept.size();
+        num_syncs_++;
+
+        // buffered batches that are already committed need no flush anymore
+        std::vector<bridge::byte_t> pending;
+        copy_records_after(pending_.data(), pending_.data() + pending_.size(), committed, pending);
+        pending_.swap(pending);
+        durable_sequence_ = std::max(durable_sequence_, committed);
+        flushed_.notify_all();
+    }
+
+    void write_ahead_log::check_not_failed() const {
+        if (failed_) {
+            throw directory::io_error("The write-ahead log " + path_.string() + " failed, it must be reopened");
+        }
+    }
+
+    /**
+     * @brief Reads the records of a log.
+     */
+    uint64_t write_ahead_log::replay(const std::filesystem::path &path, const replay_callback &callback,
+                                     uint64_t after) {
+        if (!std::filesystem::exists(path)) {
+            return 0;
+        }
+        return scan(read_file(path),
+                    [&](const bridge::byte_t *payload, const bridge::byte_t *end) {
+                        if (common::read_fixed<uint64_t>(payload + sequence_offset) > after) {
+                            callback(decode_record(payload, end));
+                        }
+                    })
+            .last_sequence;
+    }
+
+} // namespace bridge::index
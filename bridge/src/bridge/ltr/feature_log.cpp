@@ -0,0 +1,225 @@
+// Copyright (c) 2021 Bridge Project (Marcos Pontes)
+
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to
+//  deal in the Software without restriction, including without limitation the
+//  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+//  sell copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+//  IN THE SOFTWARE.
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <exception>
+#include <map>
+#include <mutex>
+#include <thread>
+
+#include "bridge/common/vint.hpp"
+#include "bridge/error.hpp"
+#include "bridge/ltr/feature_log.hpp"
+#include "bridge/scoring/bm25.hpp"
+
+namespace bridge::ltr {
+
+    namespace {
+
+        // number of leading columns before the features: query ids, doc ids and relevances
+        constexpr uint64_t leading_columns = 3;
+
+        constexpr size_t footer_size = sizeof(uint64_t) + sizeof(uint32_t);
+
+    } // namespace
+
+    /**
+     * @brief Extracts the features of a field from its term vectors.
+     */
+    void extract_field_features(const field_query &query, std::span<const DocId> docs, feature_batch &batch,
+                                uint32_t first_feature) {
+        if (first_feature + features_per_field > batch.num_features() || docs.size() != batch.num_docs()) {
+            throw bridge_error("The batch does not fit the field features");
+        }
+
+        std::vector<scoring::bm25_weight> weights;
+        weights.reserve(query.terms.size());
+        for (const auto &[term, doc_freq] : query.terms) {
+            weights.emplace_back(doc_freq, query.num_docs, query.average_field_norm);
+        }
+
+        float *bm25 = batch.column(first_feature);
+        float *term_freqs = batch.column(first_feature + 1);
+        float *field_norms = batch.column(first_feature + 2);
+        for (size_t i = 0; i < docs.size(); i++) {
+            postings::term_vector vector = query.vectors->get(docs[i]);
+            uint32_t field_norm = 0;
+            for (const auto &entry : vector) {
+                field_norm += entry.term_freq;
+            }
+
+            Score score = 0.0F;
+            uint32_t matched = 0;
+            for (size_t t = 0; t < query.terms.size(); t++) {
+                auto entry = std::lower_bound(
+                    vector.begin(), vector.end(), query.terms[t].first,
+                    [](const postings::term_vector_entry &e, uint32_t term) { return e.term_ordinal < term; });
+                if (entry != vector.end() && entry->term_ordinal == query.terms[t].first) {
+                    score += weights[t].score(entry->term_freq, field_norm);
+                    matched += entry->term_freq;
+                }
+            }
+            bm25[i] = score;
+            term_freqs[i] = static_cast<float>(matched);
+            field_norms[i] = static_cast<float>(field_norm);
+        }
+    }
+
+    /**
+     * @brief Construct a new logger.
+     */
+    feature_logger::feature_logger(uint32_t num_features, size_t num_threads)
+        : num_features_(num_features),
+          num_threads_(num_threads != 0 ? num_threads : std::max(1U, std::thread::hardware_concurrency())) {}
+
+    /**
+     * @brief Extracts and writes the features of a judgment list.
+     */
+    uint64_t feature_logger::log(const std::vector<judgment> &judgments, const feature_extractor &extractor,
+                                 std::ostream &os) const {
+        std::map<uint32_t, std::vector<judgment>> by_query;
+        for (const auto &j : judgments) {
+            by_query[j.query_id].push_back(j);
+        }
+
+        struct query_task {
+            const std::vector<judgment> *judgments;
+            std::vector<DocId> docs;
+            feature_batch batch;
+        };
+        std::vector<query_task> tasks;
+        tasks.reserve(by_query.size());
+        for (const auto &[query_id, query_judgments] : by_query) {
+            std::vector<DocId> docs;
+            docs.reserve(query_judgments.size());
+            for (const auto &j : query_judgments) {
+                docs.push_back(j.doc);
+            }
+            tasks.push_back({&query_judgments, std::move(docs), feature_batch(num_features_, query_judgments.size())});
+        }
+
+        // workers pick the next query until none is left
+        std::atomic<size_t> next{0};
+        std::exception_ptr error;
+        std::mutex error_mutex;
+        auto work = [&]() {
+            for (size_t i = next++; i < tasks.size(); i = next++) {
+                try {
+                    query_task &task = tasks[i];
+                    extractor(task.judgments->front().query_id, task.docs, task.batch);
+                } catch (...) {
+                    std::lock_guard<std::mutex> lock(error_mutex);
+                    if (!error) {
+                        error = std::current_exception();
+                    }
+                    next = tasks.size();
+                }
+            }
+        };
+        std::vector<std::thread> workers;
+        for (size_t t = 1; t < std::min(num_threads_, tasks.size()); t++) {
+            workers.emplace_back(work);
+        }
+        work();
+        for (auto &worker : workers) {
+            worker.join();
+        }
+        if (error) {
+            std::rethrow_exception(error);
+        }
+
+        std::vector<bridge::byte_t> buffer;
+        for (const auto &task : tasks) {
+            for (const auto &j : *task.judgments) {
+                common::write_fixed(buffer, j.query_id);
+            }
+        }
+        for (const auto &task : tasks) {
+            for (DocId doc : task.docs) {
+                common::write_fixed(buffer, doc);
+            }
+        }
+        for (const auto &task : tasks) {
+            for (const auto &j : *task.judgments) {
+                common::write_fixed(buffer, std::bit_cast<uint32_t>(j.relevance));
+            }
+        }
+        for (uint32_t feature = 0; feature < num_features_; feature++) {
+            for (const auto &task : tasks) {
+                const float *column = task.batch.column(feature);
+                for (size_t i = 0; i < task.docs.size(); i++) {
+                    common::write_fixed(buffer, std::bit_cast<uint32_t>(column[i]));
+                }
+            }
+        }
+
+        common::write_fixed(buffer, static_cast<uint64_t>(judgments.size()));
+        common::write_fixed(buffer, num_features_);
+        os.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+        return judgments.size();
+    }
+
+    /**
+     * @brief Construct a new reader.
+     */
+    feature_log_reader::feature_log_reader(std::shared_ptr<directory::read_only_source> source)
+        : source_(std::move(source)) {
+        if (source_->size() < footer_size) {
+            throw bridge_error("Corrupted feature log");
+        }
+        const bridge::byte_t *footer = source_->deref() + source_->size() - footer_size;
+        num_rows_ = common::read_fixed<uint64_t>(footer);
+        num_features_ = common::read_fixed<uint32_t>(footer + sizeof(uint64_t));
+        if ((leading_columns + num_features_) * num_rows_ * sizeof(uint32_t) + footer_size != source_->size()) {
+            throw bridge_error("Corrupted feature log");
+        }
+    }
+
+    uint32_t feature_log_reader::read_cell(uint64_t column, uint64_t row) const {
+        return common::read_fixed<uint32_t>(source_->deref() + (column * num_rows_ + row) * sizeof(uint32_t));
+    }
+
+    /**
+     * @brief Get the judgment of a row.
+     */
+    judgment feature_log_reader::row(uint64_t row) const {
+        if (row >= num_rows_) {
+            throw bridge_error("Row out of range");
+        }
+        return {read_cell(0, row), read_cell(1, row), std::bit_cast<float>(read_cell(2, row))};
+    }
+
+    /**
+     * @brief Get a feature column.
+     */
+    std::vector<float> feature_log_reader::column(uint32_t feature) const {
+        if (feature >= num_features_) {
+            throw bridge_error("Feature out of range");
+        }
+        std::vector<float> values(num_rows_);
+        for (uint64_t row = 0; row < num_rows_; row++) {
+            values[row] = std::bit_cast<float>(read_cell(leading_columns + feature, row));
+        }
+        return values;
+    }
+
+} // namespace bridge::ltr
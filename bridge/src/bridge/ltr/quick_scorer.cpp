@@ -0,0 +1,184 @@
+// Copyright (c) 2021 Bridge Project (Marcos Pontes)
+
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to
+//  deal in the Software without restriction, including without limitation the
+//  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+//  sell copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+//  IN THE SOFTWARE.
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <limits>
+
+#include "bridge/error.hpp"
+#include "bridge/ltr/quick_scorer.hpp"
+
+namespace bridge::ltr {
+
+    namespace {
+
+        /// @brief Number the leaves of a subtree from left to right, returning its [first, last) leaf range.
+        std::pair<uint32_t, uint32_t> leaf_range(const regression_tree &tree, int32_t node, uint32_t &next_leaf,
+                                                 std::vector<std::pair<uint32_t, uint32_t>> &ranges) {
+            uint32_t first = next_leaf;
+            if (tree.nodes[node].is_leaf()) {
+                next_leaf++;
+            } else {
+                leaf_range(tree, tree.nodes[node].left, next_leaf, ranges);
+                leaf_range(tree, tree.nodes[node].right, next_leaf, ranges);
+            }
+            ranges[node] = {first, next_leaf};
+            return ranges[node];
+        }
+
+    } // namespace
+
+    /**
+     * @brief Construct a batch filled with zeros.
+     */
+    feature_batch::feature_batch(uint32_t num_features, size_t num_docs)
+        : num_features_(num_features), num_docs_(num_docs), values_(num_features * num_docs, 0.0F) {}
+
+    /**
+     * @brief Copy the features of a document into a row vector.
+     */
+    std::vector<float> feature_batch::row(size_t doc) const {
+        std::vector<float> features(num_features_);
+        for (uint32_t feature = 0; feature < num_features_; feature++) {
+            features[feature] = get(doc, feature);
+        }
+        return features;
+    }
+
+    /**
+     * @brief Compiles an ensemble.
+     */
+    quick_scorer::quick_scorer(const tree_ensemble &ensemble)
+        : num_features_(ensemble.num_features()), num_trees_(static_cast<uint32_t>(ensemble.trees().size())),
+          base_score_(ensemble.base_score()) {
+        std::vector<std::vector<condition>> by_feature(num_features_);
+        for (uint32_t t = 0; t < num_trees_; t++) {
+            const regression_tree &tree = ensemble.trees()[t];
+            std::vector<std::pair<uint32_t, uint32_t>> ranges(tree.nodes.size());
+            uint32_t num_leaves = 0;
+            leaf_range(tree, 0, num_leaves, ranges);
+            if (num_leaves > 64) {
+                throw bridge_error("QuickScorer supports trees of at most 64 leaves");
+            }
+
+            leaf_offsets_.push_back(leaves_.size());
+            leaves_.resize(leaves_.size() + num_leaves);
+            for (size_t n = 0; n < tree.nodes.size(); n++) {
+                const tree_node &node = tree.nodes[n];
+                if (node.is_leaf()) {
+                    leaves_[leaf_offsets_.back() + ranges[n].first] = node.value;
+                    continue;
+                }
+                auto [first, last] = ranges[node.left];
+                uint64_t left_leaves = ((last - first == 64) ? ~0ULL : ((1ULL << (last - first)) - 1)) << first;
+                by_feature[node.feature].push_back({node.threshold, t, ~left_leaves, !node.missing_left});
+            }
+        }
+
+        feature_offsets_.push_back(0);
+        for (auto &conditions : by_feature) {
+            std::stable_sort(conditions.begin(), conditions.end(),
+                             [](const condition &a, const condition &b) { return a.threshold < b.threshold; });
+            conditions_.insert(conditions_.end(), conditions.begin(), conditions.end());
+            feature_offsets_.push_back(conditions_.size());
+        }
+    }
+
+    /**
+     * @brief Score every document of a batch.
+     */
+    std::vector<Score> quick_scorer::score(const feature_batch &batch) const {
+        if (batch.num_features() < num_features_) {
+            throw bridge_error("The batch lacks features used by the model");
+        }
+        std::vector<Score> scores(batch.num_docs());
+        // leaf bit vectors of the current block, laid out tree by tree
+        std::vector<uint64_t> leaves(num_trees_ * block_size);
+        for (size_t first = 0; first < batch.num_docs(); first += block_size) {
+            size_t count = std::min(block_size, batch.num_docs() - first);
+            score_block(batch, first, count, leaves.data(), scores.data() + first);
+        }
+        return scores;
+    }
+
+    void quick_scorer::score_block(const feature_batch &batch, size_t first, size_t count, uint64_t *leaves,
+                                   Score *out) const {
+        std::fill(leaves, leaves + num_trees_ * block_size, ~0ULL);
+
+        // padding documents never fail a test, so the inner loop always runs on a full block
+        float values[block_size];
+        for (uint32_t feature = 0; feature < num_features_; feature++) {
+            const float *column = batch.column(feature) + first;
+            std::copy(column, column + count, values);
+            std::fill(values + count, values + block_size, -std::numeric_limits<float>::infinity());
+            // missing values count as -inf for the early exit, std::max_element would return a leading NaN
+            float max_value = -std::numeric_limits<float>::infinity();
+            bool missing[block_size];
+            bool any_missing = false;
+            for (size_t d = 0; d < block_size; d++) {
+                missing[d] = std::isnan(values[d]);
+                any_missing |= missing[d];
+                max_value = values[d] > max_value ? values[d] : max_value;
+            }
+
+            for (size_t c = feature_offsets_[feature]; c < feature_offsets_[feature + 1]; c++) {
+                const condition &cond = conditions_[c];
+                if (!(max_value >= cond.threshold) && !any_missing) {
+                    break; // the remaining thresholds are higher, no document of the block fails them
+                }
+                uint64_t *bits = leaves + cond.tree * block_size;
+                for (size_t d = 0; d < block_size; d++) {
+                    bool fails = (values[d] >= cond.threshold) | (missing[d] & cond.missing_right);
+                    bits[d] &= cond.mask | (0ULL - static_cast<uint64_t>(!fails));
+                }
+            }
+        }
+
+        std::fill(out, out + count, base_score_);
+        for (uint32_t t = 0; t < num_trees_; t++) {
+            const uint64_t *bits = leaves + t * block_size;
+            const Score *values = leaves_.data() + leaf_offsets_[t];
+            for (size_t d = 0; d < count; d++) {
+                out[d] += values[std::countr_zero(bits[d])];
+            }
+        }
+    }
+
+    /**
+     * @brief Re-ranks the top candidates of a first-stage retrieval.
+     */
+    std::vector<ranked_doc> rerank(const std::vector<ranked_doc> &candidates, const feature_batch &features,
+                                   const quick_scorer &model) {
+        if (features.num_docs() != candidates.size()) {
+            throw bridge_error("The batch must hold the features of every candidate");
+        }
+        std::vector<Score> scores = model.score(features);
+        std::vector<ranked_doc> ranked(candidates.size());
+        for (size_t i = 0; i < candidates.size(); i++) {
+            ranked[i] = {candidates[i].doc, scores[i]};
+        }
+        std::sort(ranked.begin(), ranked.end(), [](const ranked_doc &a, const ranked_doc &b) {
+            return a.score != b.score ? a.score > b.score : a.doc < b.doc;
+        });
+        return ranked;
+    }
+
+} // namespace bridge::ltr
@@ -0,0 +1,175 @@
+// Copyright (c) 2021 Bridge Project (Marcos Pontes)
+
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to
+//  deal in the Software without restriction, including without limitation the
+//  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+//  sell copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+//  IN THE SOFTWARE.
+
+#include <cmath>
+#include <map>
+#include <string>
+
+#include "bridge/error.hpp"
+#include "bridge/ltr/tree_ensemble.hpp"
+
+namespace bridge::ltr {
+
+    namespace {
+
+        uint32_t parse_feature(const serialization::json_t &split) {
+            if (split.is_number_unsigned()) {
+                return split.get<uint32_t>();
+            }
+            std::string name = split.get<std::string>();
+            size_t begin = (!name.empty() && name[0] == 'f') ? 1 : 0;
+            size_t parsed = 0;
+            unsigned long feature = std::stoul(name.substr(begin), &parsed);
+            if (begin + parsed != name.size()) {
+                throw bridge_error("Invalid split feature: " + name);
+            }
+            return static_cast<uint32_t>(feature);
+        }
+
+        /// @brief Appends the subtree rooted at a JSON node, returning the index of its root.
+        int32_t parse_node(const serialization::json_t &json, regression_tree &tree) {
+            auto index = static_cast<int32_t>(tree.nodes.size());
+            tree.nodes.emplace_back();
+            if (json.contains("leaf")) {
+                tree.nodes[index].value = json["leaf"].get<Score>();
+                return index;
+            }
+
+            std::map<int64_t, const serialization::json_t *> children;
+            for (const auto &child : json.at("children")) {
+                children[child.at("nodeid").get<int64_t>()] = &child;
+            }
+            auto yes = children.find(json.at("yes").get<int64_t>());
+            auto no = children.find(json.at("no").get<int64_t>());
+            if (yes == children.end() || no == children.end()) {
+                throw bridge_error("Missing child in tree node");
+            }
+
+            tree_node node;
+            node.feature = parse_feature(json.at("split"));
+            node.threshold = json.at("split_condition").get<float>();
+            if (json.contains("missing")) {
+                auto missing = json["missing"].get<int64_t>();
+                if (missing != yes->first && missing != no->first) {
+                    throw bridge_error("Missing-value child is neither yes nor no");
+                }
+                node.missing_left = missing == yes->first;
+            }
+            node.left = parse_node(*yes->second, tree);
+            node.right = parse_node(*no->second, tree);
+            tree.nodes[index] = node;
+            return index;
+        }
+
+    } // namespace
+
+    /**
+     * @brief Output of the tree for a document.
+     */
+    Score regression_tree::score(const float *features) const {
+        const tree_node *node = nodes.data();
+        while (!node->is_leaf()) {
+            float value = features[node->feature];
+            bool right = std::isnan(value) ? !node->missing_left : value >= node->threshold;
+            node = &nodes[right ? node->right : node->left];
+        }
+        return node->value;
+    }
+
+    /**
+     * @brief Number of leaves of the tree.
+     */
+    size_t regression_tree::num_leaves() const {
+        size_t leaves = 0;
+        for (const auto &node : nodes) {
+            leaves += node.is_leaf() ? 1 : 0;
+        }
+        return leaves;
+    }
+
+    /**
+     * @brief Construct a new ensemble.
+     */
+    tree_ensemble::tree_ensemble(std::vector<regression_tree> &&trees, uint32_t num_features, Score base_score)
+        : trees_(std::move(trees)), num_features_(num_features), base_score_(base_score) {
+        for (const auto &tree : trees_) {
+            if (tree.nodes.empty()) {
+                throw bridge_error("Empty regression tree");
+            }
+            for (const auto &node : tree.nodes) {
+                if (node.is_leaf()) {
+                    continue;
+                }
+                if (node.feature >= num_features_) {
+                    throw bridge_error("Tree feature out of range");
+                }
+                auto size = static_cast<int32_t>(tree.nodes.size());
+                if (node.left >= size || node.right < 0 || node.right >= size) {
+                    throw bridge_error("Tree child out of range");
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief Loads an ensemble from its JSON export.
+     */
+    tree_ensemble tree_ensemble::from_json(const serialization::json_t &json) {
+        try {
+            const serialization::json_t &trees_json = json.is_array() ? json : json.at("trees");
+            std::vector<regression_tree> trees;
+            trees.reserve(trees_json.size());
+            uint32_t num_features = 0;
+            for (const auto &tree_json : trees_json) {
+                regression_tree tree;
+                parse_node(tree_json, tree);
+                for (const auto &node : tree.nodes) {
+                    if (!node.is_leaf()) {
+                        num_features = std::max(num_features, node.feature + 1);
+                    }
+                }
+                trees.push_back(std::move(tree));
+            }
+
+            Score base_score = 0.0F;
+            if (json.is_object()) {
+                base_score = json.value("base_score", 0.0F);
+                num_features = std::max(num_features, json.value("num_features", 0U));
+            }
+            return tree_ensemble(std::move(trees), num_features, base_score);
+        } catch (const bridge_error &) {
+            throw;
+        } catch (const std::exception &e) {
+            throw bridge_error(e.what());
+        }
+    }
+
+    /**
+     * @brief Score a document by walking every tree.
+     */
+    Score tree_ensemble::score(const float *features) const {
+        Score score = base_score_;
+        for (const auto &tree : trees_) {
+            score += tree.score(features);
+        }
+        return score;
+    }
+
+} // namespace bridge::ltr
@@ -0,0 +1,136 @@
+// Copyright (c) 2021 Bridge Project (Marcos Pontes)
+
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to
+//  deal in the Software without restriction, including without limitation the
+//  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+//  sell copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+//  IN THE SOFTWARE.
+
+#include <algorithm>
+#include <bit>
+
+#include "bridge/common/vint.hpp"
+#include "bridge/error.hpp"
+#include "bridge/postings/bit_set.hpp"
+
+namespace bridge::postings {
+
+    /**
+     * @brief Construct an empty set.
+     */
+    bit_set::bit_set(DocId num_bits) : num_bits_(num_bits), words_((static_cast<size_t>(num_bits) + 63) / 64, 0) {
+        if (num_bits == TERMINATED) {
+            throw bridge_error("A bit set cannot hold the TERMINATED doc id");
+        }
+    }
+
+    /**
+     * @brief Adds a document to the set.
+     */
+    void bit_set::insert(DocId doc) {
+        if (doc >= num_bits_) {
+            throw bridge_error("Doc id out of the bit set range");
+        }
+        words_[doc / 64] |= uint64_t{1} << (doc % 64);
+    }
+
+    /**
+     * @brief First document of the set greater or equal to doc.
+     */
+    DocId bit_set::next_set_bit(DocId doc) const {
+        if (doc >= num_bits_) {
+            return TERMINATED;
+        }
+        size_t index = doc / 64;
+        uint64_t word = words_[index] >> (doc % 64);
+        if (word != 0) {
+            return doc + static_cast<DocId>(std::countr_zero(word));
+        }
+        for (index++; index < words_.size(); index++) {
+            if (words_[index] != 0) {
+                return static_cast<DocId>(index * 64 + std::countr_zero(words_[index]));
+            }
+        }
+        return TERMINATED;
+    }
+
+    /**
+     * @brief Last document of the set lower or equal to doc.
+     */
+    DocId bit_set::prev_set_bit(DocId doc) const {
+        if (num_bits_ == 0) {
+            return TERMINATED;
+        }
+        doc = std::min(doc, num_bits_ - 1);
+        size_t index = doc / 64;
+        uint64_t word = words_[index] << (63 - doc % 64);
+        if (word != 0) {
+            return doc - static_cast<DocId>(std::countl_zero(word));
+        }
+        while (index-- > 0) {
+            if (words_[index] != 0) {
+                return static_cast<DocId>(index * 64 + 63 - std::countl_zero(words_[index]));
+            }
+        }
+        return TERMINATED;
+    }
+
+    /**
+     * @brief Number of documents in the set.
+     */
+    uint32_t bit_set::count() const {
+        uint32_t total = 0;
+        for (uint64_t word : words_) {
+            total += static_cast<uint32_t>(std::popcount(word));
+        }
+        return total;
+    }
+
+    /**
+     * @brief Writes the set.
+     */
+    uint64_t bit_set::serialize(std::ostream &os) const {
+        std::vector<bridge::byte_t> buffer;
+        common::write_vint(buffer, num_bits_);
+        for (uint64_t word : words_) {
+            common::write_fixed(buffer, word);
+        }
+        os.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+        return buffer.size();
+    }
+
+    /**
+     * @brief Reads a set.
+     */
+    bit_set bit_set::deserialize(const bridge::byte_t *&data, const bridge::byte_t *end) {
+        uint64_t num_bits = common::read_vint(data, end);
+        if (num_bits >= TERMINATED) {
+            throw bridge_error("Corrupted bit set");
+        }
+        bit_set set(static_cast<DocId>(num_bits));
+        if (static_cast<size_t>(end - data) < set.words_.size() * sizeof(uint64_t)) {
+            throw bridge_error("Corrupted bit set");
+        }
+        for (auto &word : set.words_) {
+            word = common::read_fixed<uint64_t>(data);
+            data += sizeof(uint64_t);
+        }
+        if (num_bits % 64 != 0 && set.words_.back() >> (num_bits % 64) != 0) {
+            throw bridge_error("Corrupted bit set");
+        }
+        return set;
+    }
+
+} // namespace bridge::postings
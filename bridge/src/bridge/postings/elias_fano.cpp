@@ -0,0 +1,350 @@
+// Copyright (c) 2021 Bridge Project (Marcos Pontes)
+
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to
+//  deal in the Software without restriction, including without limitation the
+//  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+//  sell copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+//  IN THE SOFTWARE.
+
+#include <algorithm>
+#include <bit>
+
+#include "bridge/common/vint.hpp"
+#include "bridge/error.hpp"
+#include "bridge/postings/elias_fano.hpp"
+
+namespace bridge::postings {
+
+    static constexpr size_t no_bit = std::numeric_limits<size_t>::max();
+
+    /// @brief Position of the first set bit at or after `from`, or no_bit.
+    static size_t next_set_bit(const std::vector<uint64_t> &words, size_t from) {
+        size_t word = from / 64;
+        if (word >= words.size()) {
+            return no_bit;
+        }
+        uint64_t bits = words[word] & (~uint64_t{0} << (from % 64));
+        while (bits == 0) {
+            if (++word == words.size()) {
+                return no_bit;
+            }
+            bits = words[word];
+        }
+        return word * 64 + static_cast<size_t>(std::countr_zero(bits));
+    }
+
+    /// @brief Position right after the h-th zero, i.e. where the bucket h starts in the high part.
+    static size_t bucket_start(const std::vector<uint64_t> &words, uint64_t h) {
+        if (h == 0) {
+            return 0;
+        }
+        uint64_t seen = 0;
+        for (size_t word = 0; word < words.size(); word++) {
+            uint64_t zeros = ~words[word];
+            auto count = static_cast<uint64_t>(std::popcount(zeros));
+            if (seen + count >= h) {
+                for (uint64_t skip = h - seen - 1; skip > 0; skip--) {
+                    zeros &= zeros - 1; // clear lowest zero
+                }
+                return word * 64 + static_cast<size_t>(std::countr_zero(zeros)) + 1;
+            }
+            seen += count;
+        }
+        throw bridge_error("Corrupted Elias-Fano high bits");
+    }
+
+    /// @brief Number of set bits strictly before `bit`.
+    static uint32_t rank(const std::vector<uint64_t> &words, size_t bit) {
+        uint32_t count = 0;
+        for (size_t word = 0; word < bit / 64; word++) {
+            count += static_cast<uint32_t>(std::popcount(words[word]));
+        }
+        if (bit % 64 != 0) {
+            count += static_cast<uint32_t>(std::popcount(words[bit / 64] & ((uint64_t{1} << (bit % 64)) - 1)));
+        }
+        return count;
+    }
+
+    static uint64_t read_bits(const std::vector<uint64_t> &words, size_t offset, uint8_t width) {
+        if (width == 0) {
+            return 0;
+        }
+        size_t word = offset / 64;
+        size_t shift = offset % 64;
+        uint64_t value = words[word] >> shift;
+        if (shift + width > 64) {
+            value |= words[word + 1] << (64 - shift);
+        }
+        return width == 64 ? value : value & ((uint64_t{1} << width) - 1);
+    }
+
+    static void write_bits(std::vector<uint64_t> &words, size_t offset, uint8_t width, uint64_t value) {
+        if (width == 0) {
+            return;
+        }
+        if (width < 64) {
+            value &= (uint64_t{1} << width) - 1;
+        }
+        size_t word = offset / 64;
+        size_t shift = offset % 64;
+        words[word] |= value << shift;
+        if (shift + width > 64) {
+            words[word + 1] |= value >> (64 - shift);
+        }
+    }
+
+    /**
+     * @brief Encodes one partition, choosing between Elias-Fano and a bitmap.
+     */
+    elias_fano_postings::partition elias_fano_postings::encode(const DocId *docs, uint32_t size, DocId base) {
+        uint64_t universe = static_cast<uint64_t>(docs[size - 1]) - base + 1;
+        uint8_t low_bits = 0;
+        if (universe > size) {
+            low_bits = static_cast<uint8_t>(std::bit_width(universe / size) - 1);
+        }
+        uint64_t ef_bits = uint64_t{size} * low_bits + size + (universe >> low_bits) + 1;
+
+        partition part{base, size, universe <= ef_bits, low_bits, {}, {}};
+        if (part.dense) {
+            part.low_bits = 0;
+            part.highs.resize((universe + 63) / 64, 0);
+            for (uint32_t i = 0; i < size; i++) {
+                uint64_t bit = docs[i] - base;
+                part.highs[bit / 64] |= uint64_t{1} << (bit % 64);
+            }
+            return part;
+        }
+
+        part.lows.resize((uint64_t{size} * low_bits + 63) / 64, 0);
+        part.highs.resize((size + (universe >> low_bits) + 1 + 63) / 64, 0);
+        for (uint32_t i = 0; i < size; i++) {
+            uint64_t value = docs[i] - base;
+            write_bits(part.lows, uint64_t{i} * low_bits, low_bits, value);
+            uint64_t bit = (value >> low_bits) + i;
+            part.highs[bit / 64] |= uint64_t{1} << (bit % 64);
+        }
+        return part;
+    }
+
+    /**
+     * @brief Encodes a postings list.
+     */
+    elias_fano_postings elias_fano_postings::build(const std::vector<DocId> &docs) {
+        elias_fano_postings postings;
+        postings.len_ = docs.size();
+
+        DocId base = 0;
+        for (size_t start = 0; start < docs.size(); start += partition_size) {
+            auto size = static_cast<uint32_t>(std::min<size_t>(partition_size, docs.size() - start));
+            for (size_t i = start; i < start + size; i++) {
+                if (docs[i] < base || (i > start && docs[i] <= docs[i - 1]) || docs[i] == TERMINATED) {
+                    throw bridge_error("Doc ids must be strictly increasing");
+                }
+            }
+            postings.partitions_.push_back(encode(&docs[start], size, base));
+            postings.lasts_.push_back(docs[start + size - 1]);
+            base = docs[start + size - 1] + 1;
+        }
+        return postings;
+    }
+
+    /**
+     * @brief Returns the size of the encoded doc ids, in bytes.
+     */
+    size_t elias_fano_postings::num_bytes() const {
+        size_t bytes = lasts_.size() * sizeof(DocId);
+        for (const auto &part : partitions_) {
+            bytes += (part.lows.size() + part.highs.size()) * sizeof(uint64_t);
+        }
+        return bytes;
+    }
+
+    /**
+     * @brief Returns a cursor positioned on the first document.
+     */
+    elias_fano_cursor elias_fano_postings::cursor() const { return elias_fano_cursor(*this); }
+
+    /**
+     * @brief Writes the postings list.
+     */
+    uint64_t elias_fano_postings::serialize(std::ostream &os) const {
+        std::vector<bridge::byte_t> buffer;
+        common::write_vint(buffer, len_);
+        common::write_vint(buffer, partitions_.size());
+        for (size_t p = 0; p < partitions_.size(); p++) {
+            const partition &part = partitions_[p];
+            common::write_vint(buffer, part.size);
+            common::write_vint(buffer, lasts_[p] - part.base);
+            buffer.push_back(static_cast<bridge::byte_t>(part.dense ? 1 : 0));
+            buffer.push_back(static_cast<bridge::byte_t>(part.low_bits));
+            for (const auto *words : {&part.lows, &part.highs}) {
+                common::write_vint(buffer, words->size());
+                for (uint64_t word : *words) {
+                    common::write_fixed<uint64_t>(buffer, word);
+                }
+            }
+        }
+        os.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+        return buffer.size();
+    }
+
+    /**
+     * @brief Reads a postings list.
+     */
+    elias_fano_postings elias_fano_postings::deserialize(const bridge::byte_t *&data, const bridge::byte_t *end) {
+        elias_fano_postings postings;
+        postings.len_ = common::read_vint(data, end);
+        size_t num_partitions = common::read_vint(data, end);
+
+        uint64_t total = 0;
+        DocId base = 0;
+        for (size_t p = 0; p < num_partitions; p++) {
+            uint64_t size = common::read_vint(data, end);
+            uint64_t last = base + common::read_vint(data, end);
+            if (size == 0 || size > partition_size || last >= TERMINATED || end - data < 2) {
+                throw bridge_error("Corrupted Elias-Fano postings");
+            }
+            partition part{base, static_cast<uint32_t>(size), *data++ != 0, static_cast<uint8_t>(*data++), {}, {}};
+            for (auto *words : {&part.lows, &part.highs}) {
+                uint64_t count = common::read_vint(data, end);
+                if (count > static_cast<size_t>(end - data) / sizeof(uint64_t)) {
+                    throw bridge_error("Corrupted Elias-Fano postings");
+                }
+                words->resize(count);
+                for (auto &word : *words) {
+                    word = common::read_fixed<uint64_t>(data);
+                    data += sizeof(uint64_t);
+                }
+            }
+
+            // The cursor indexes lows and highs from size, low_bits and the universe, so they must agree with
+            // the word counts exactly as encode() lays them out.
+            uint64_t universe = last - base + 1;
+            uint64_t ones = 0;
+            for (uint64_t word : part.highs) {
+                ones += static_cast<uint64_t>(std::popcount(word));
+            }
+            bool consistent = part.dense ? part.low_bits == 0 && part.lows.empty() &&
+                                               part.highs.size() == (universe + 63) / 64
+                                         : part.low_bits < 32 && part.lows.size() == (size * part.low_bits + 63) / 64 &&
+                                               part.highs.size() == (size + (universe >> part.low_bits) + 1 + 63) / 64;
+            if (!consistent || ones != size) {
+                throw bridge_error("Corrupted Elias-Fano postings");
+            }
+
+            postings.partitions_.push_back(std::move(part));
+            postings.lasts_.push_back(static_cast<DocId>(last));
+            total += size;
+            base = static_cast<DocId>(last + 1);
+        }
+        if (total != postings.len_) {
+            throw bridge_error("Corrupted Elias-Fano postings");
+        }
+        return postings;
+    }
+
+    /**
+     * @brief Construct a cursor positioned on the first document.
+     */
+    elias_fano_cursor::elias_fano_cursor(const elias_fano_postings &postings) : postings_(&postings) {
+        if (!postings.partitions_.empty()) {
+            position(0, 0, 0);
+        }
+    }
+
+    /**
+     * @brief Positions the cursor on the first document of the partition at or after bit `from`.
+     */
+    DocId elias_fano_cursor::position(size_t partition, size_t from_bit, uint32_t index) {
+        const auto &part = postings_->partitions_[partition];
+        size_t bit = next_set_bit(part.highs, from_bit);
+        if (bit == no_bit) {
+            throw bridge_error("Corrupted Elias-Fano postings");
+        }
+        partition_ = partition;
+        bit_ = bit;
+        index_ = index;
+        if (part.dense) {
+            doc_ = part.base + static_cast<DocId>(bit);
+        } else {
+            uint64_t high = bit - index;
+            uint64_t low = read_bits(part.lows, uint64_t{index} * part.low_bits, part.low_bits);
+            doc_ = part.base + static_cast<DocId>((high << part.low_bits) | low);
+        }
+        return doc_;
+    }
+
+    /**
+     * @brief Moves to the next document.
+     */
+    DocId elias_fano_cursor::advance() {
+        if (doc_ == TERMINATED) {
+            return doc_;
+        }
+        if (index_ + 1 < postings_->partitions_[partition_].size) {
+            return position(partition_, bit_ + 1, index_ + 1);
+        }
+        if (partition_ + 1 < postings_->partitions_.size()) {
+            return position(partition_ + 1, 0, 0);
+        }
+        doc_ = TERMINATED;
+        return doc_;
+    }
+
+    /**
+     * @brief Moves to the first document greater or equal to target.
+     */
+    DocId elias_fano_cursor::seek(DocId target) {
+        if (target <= doc_) {
+            return doc_;
+        }
+
+        const auto &lasts = postings_->lasts_;
+        size_t partition = partition_;
+        if (target > lasts[partition]) {
+            // gallop from the current partition, then binary search the bracketed range
+            size_t step = 1;
+            size_t low = partition + 1;
+            while (low + step < lasts.size() && lasts[low + step] < target) {
+                low += step;
+                step *= 2;
+            }
+            auto begin = lasts.begin() + static_cast<long>(low);
+            auto end = lasts.begin() + static_cast<long>(std::min(low + step + 1, lasts.size()));
+            partition = static_cast<size_t>(std::lower_bound(begin, end, target) - lasts.begin());
+            if (partition >= lasts.size()) {
+                doc_ = TERMINATED;
+                return doc_;
+            }
+        }
+
+        const auto &part = postings_->partitions_[partition];
+        uint64_t relative = target < part.base ? 0 : target - part.base;
+        if (part.dense) {
+            size_t bit = next_set_bit(part.highs, relative);
+            return position(partition, bit, rank(part.highs, bit));
+        }
+
+        uint64_t bucket = relative >> part.low_bits;
+        size_t bit = bucket_start(part.highs, bucket);
+        auto index = static_cast<uint32_t>(bit - bucket);
+        DocId candidate = position(partition, bit, index);
+        while (candidate < target) {
+            candidate = position(partition, bit_ + 1, index_ + 1);
+        }
+        return candidate;
+    }
+
+} // namespace bridge::postings
@@ -0,0 +1,143 @@
+// Copyright (c) 2021 Bridge Project (Marcos Pontes)
+
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to
+//  deal in the Software without restriction, including without limitation the
+//  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+//  sell copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+//  IN THE SOFTWARE.
+
+#include <algorithm>
+#include <cmath>
+#include <map>
+
+#include "bridge/common/vint.hpp"
+#include "bridge/postings/impact_postings.hpp"
+
+namespace bridge::postings {
+
+    /**
+     * @brief Construct a new impact quantizer.
+     */
+    impact_quantizer::impact_quantizer(Score max_score, uint8_t bits) : max_score_(max_score) {
+        if (bits == 0 || bits > 8) {
+            throw bridge_error("Impacts must have between 1 and 8 bits");
+        }
+        if (!(max_score > 0.0F)) {
+            throw bridge_error("The maximum score must be positive");
+        }
+        max_impact_ = static_cast<uint8_t>((1U << bits) - 1);
+    }
+
+    /**
+     * @brief Quantize a score.
+     */
+    uint8_t impact_quantizer::quantize(Score score) const {
+        Score clamped = std::clamp(score, 0.0F, max_score_);
+        auto impact = static_cast<long>(std::ceil(clamped / max_score_ * static_cast<Score>(max_impact_)));
+        return static_cast<uint8_t>(std::clamp(impact, 1L, static_cast<long>(max_impact_)));
+    }
+
+    /**
+     * @brief Approximate score of an impact.
+     */
+    Score impact_quantizer::dequantize(uint8_t impact) const {
+        return static_cast<Score>(impact) * max_score_ / static_cast<Score>(max_impact_);
+    }
+
+    /**
+     * @brief Construct a postings list from its segments.
+     */
+    impact_postings::impact_postings(std::vector<impact_segment> &&segments) : segments_(std::move(segments)) {}
+
+    /**
+     * @brief Builds the impact-ordered postings of a term.
+     */
+    impact_postings impact_postings::build(const std::vector<std::pair<DocId, Score>> &scored,
+                                           const impact_quantizer &quantizer) {
+        std::map<uint8_t, std::vector<DocId>, std::greater<>> by_impact;
+        for (const auto &[doc, score] : scored) {
+            by_impact[quantizer.quantize(score)].push_back(doc);
+        }
+
+        std::vector<impact_segment> segments;
+        segments.reserve(by_impact.size());
+        for (auto &[impact, docs] : by_impact) {
+            std::sort(docs.begin(), docs.end());
+            segments.push_back({impact, std::move(docs)});
+        }
+        return impact_postings(std::move(segments));
+    }
+
+    /**
+     * @brief Returns the number of documents in the postings list.
+     */
+    size_t impact_postings::len() const {
+        size_t total = 0;
+        for (const auto &segment : segments_) {
+            total += segment.docs.size();
+        }
+        return total;
+    }
+
+    /**
+     * @brief Writes the postings list.
+     */
+    uint64_t impact_postings::serialize(std::ostream &os) const {
+        std::vector<bridge::byte_t> buffer;
+        common::write_vint(buffer, segments_.size());
+        for (const auto &segment : segments_) {
+            buffer.push_back(static_cast<bridge::byte_t>(segment.impact));
+            common::write_vint(buffer, segment.docs.size());
+            DocId previous = 0;
+            for (DocId doc : segment.docs) {
+                common::write_vint(buffer, doc - previous);
+                previous = doc;
+            }
+        }
+        os.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+        return buffer.size();
+    }
+
+    /**
+     * @brief Reads a postings list.
+     */
+    impact_postings impact_postings::deserialize(const bridge::byte_t *&data, const bridge::byte_t *end) {
+        // Every segment takes at least two bytes (impact and count) and every doc at least one, so
+        // counts beyond the remaining input are corrupt and must not reach an allocation.
+        uint64_t num_segments = common::read_vint(data, end);
+        if (num_segments > static_cast<uint64_t>(end - data) / 2) {
+            throw bridge_error("Corrupted impact postings");
+        }
+        std::vector<impact_segment> segments(num_segments);
+        for (auto &segment : segments) {
+            if (data >= end) {
+                throw bridge_error("Corrupted impact postings");
+            }
+            segment.impact = static_cast<uint8_t>(*data++);
+            uint64_t num_docs = common::read_vint(data, end);
+            if (num_docs > static_cast<uint64_t>(end - data)) {
+                throw bridge_error("Corrupted impact postings");
+            }
+            segment.docs.resize(num_docs);
+            DocId doc = 0;
+            for (auto &slot : segment.docs) {
+                doc += static_cast<DocId>(common::read_vint(data, end));
+                slot = doc;
+            }
+        }
+        return impact_postings(std::move(segments));
+    }
+
+} // namespace bridge::postings
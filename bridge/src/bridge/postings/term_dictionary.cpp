@@ -0,0 +1,140 @@
+// Copyright (c) 2021 Bridge Project (Marcos Pontes)
+
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to
+//  deal in the Software without restriction, including without limitation the
+//  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+//  sell copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+//  IN THE SOFTWARE.
+
+#include <algorithm>
+
+#include "bridge/common/vint.hpp"
+#include "bridge/error.hpp"
+#include "bridge/postings/term_dictionary.hpp"
+
+namespace bridge::postings {
+
+    /**
+     * @brief Builds a dictionary.
+     */
+    term_dictionary term_dictionary::build(std::vector<std::pair<std::string, uint64_t>> terms) {
+        std::sort(terms.begin(), terms.end());
+        term_dictionary dictionary;
+        dictionary.doc_freqs_.reserve(terms.size());
+        dictionary.offsets_.reserve(terms.size() + 1);
+        for (size_t i = 0; i < terms.size(); i++) {
+            if (i > 0 && terms[i].first == terms[i - 1].first) {
+                throw bridge_error("Duplicate term in dictionary: " + terms[i].first);
+            }
+            dictionary.bytes_ += terms[i].first;
+            dictionary.offsets_.push_back(static_cast<uint32_t>(dictionary.bytes_.size()));
+            dictionary.doc_freqs_.push_back(terms[i].second);
+        }
+        return dictionary;
+    }
+
+    /**
+     * @brief Ordinal of the first term greater or equal to a key.
+     */
+    uint32_t term_dictionary::lower_bound(std::string_view key) const {
+        uint32_t low = 0;
+        uint32_t high = size();
+        while (low < high) {
+            uint32_t middle = low + (high - low) / 2;
+            if (term(middle) < key) {
+                low = middle + 1;
+            } else {
+                high = middle;
+            }
+        }
+        return low;
+    }
+
+    /**
+     * @brief Ordinal of the first term greater or equal to a key, searching from an ordinal onward.
+     */
+    uint32_t term_dictionary::lower_bound(std::string_view key, uint32_t from) const {
+        uint32_t probe = from;
+        uint64_t step = 1;
+        while (probe < size() && term(probe) < key) {
+            // every term up to the probe is lower than the key: probe twice as far
+            from = probe + 1;
+            probe = static_cast<uint32_t>(std::min<uint64_t>(from + step - 1, size()));
+            step *= 2;
+        }
+        uint32_t low = from;
+        uint32_t high = std::min(probe, size());
+        while (low < high) {
+            uint32_t middle = low + (high - low) / 2;
+            if (term(middle) < key) {
+                low = middle + 1;
+            } else {
+                high = middle;
+            }
+        }
+        return low;
+    }
+
+    /**
+     * @brief Ordinal of a term, if the dictionary holds it.
+     */
+    std::optional<uint32_t> term_dictionary::ordinal(std::string_view term) const {
+        uint32_t ordinal = lower_bound(term);
+        if (ordinal < size() && this->term(ordinal) == term) {
+            return ordinal;
+        }
+        return std::nullopt;
+    }
+
+    /**
+     * @brief Writes the dictionary.
+     */
+    uint64_t term_dictionary::serialize(std::ostream &os) const {
+        std::vector<bridge::byte_t> buffer;
+        common::write_vint(buffer, size());
+        for (uint32_t ordinal = 0; ordinal < size(); ordinal++) {
+            std::string_view t = term(ordinal);
+            common::write_vint(buffer, t.size());
+            buffer.insert(buffer.end(), t.begin(), t.end());
+            common::write_vint(buffer, doc_freqs_[ordinal]);
+        }
+        os.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+        return buffer.size();
+    }
+
+    /**
+     * @brief Reads a dictionary.
+     */
+    term_dictionary term_dictionary::deserialize(const bridge::byte_t *&data, const bridge::byte_t *end) {
+        term_dictionary dictionary;
+        uint64_t num_terms = common::read_vint(data, end);
+        if (num_terms > static_cast<uint64_t>(end - data)) {
+            throw bridge_error("Corrupted term dictionary");
+        }
+        dictionary.doc_freqs_.reserve(num_terms);
+        for (uint64_t i = 0; i < num_terms; i++) {
+            uint64_t length = common::read_vint(data, end);
+            if (length > static_cast<uint64_t>(end - data)) {
+                throw bridge_error("Corrupted term dictionary");
+            }
+            dictionary.bytes_.append(data, length);
+            data += length;
+            dictionary.offsets_.push_back(static_cast<uint32_t>(dictionary.bytes_.size()));
+            dictionary.doc_freqs_.push_back(common::read_vint(data, end));
+        }
+        return dictionary;
+    }
+
+} // namespace bridge::postings
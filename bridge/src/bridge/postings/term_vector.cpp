@@ -0,0 +1,197 @@
+// Copyright (c) 2021 Bridge Project (Marcos Pontes)
+
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to
+//  deal in the Software without restriction, including without limitation the
+//  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+//  sell copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+//  IN THE SOFTWARE.
+
+#include <algorithm>
+#include <utility>
+
+#include "bridge/common/vint.hpp"
+#include "bridge/error.hpp"
+#include "bridge/postings/term_vector.hpp"
+
+namespace bridge::postings {
+
+    static constexpr size_t footer_size = sizeof(uint32_t) + 1;
+
+    /**
+     * @brief Records one occurrence of a term.
+     */
+    void term_vector_builder::add_token(uint32_t term_ordinal, uint32_t from, uint32_t to) {
+        tokens_.emplace_back(term_ordinal, term_offset{from, to});
+    }
+
+    /**
+     * @brief Builds the term vector and resets the builder.
+     */
+    term_vector term_vector_builder::build() {
+        // stable: occurrences of a term keep their position order
+        std::stable_sort(tokens_.begin(), tokens_.end(),
+                         [](const auto &a, const auto &b) { return a.first < b.first; });
+
+        term_vector vector;
+        for (const auto &[ordinal, offset] : tokens_) {
+            if (vector.empty() || vector.back().term_ordinal != ordinal) {
+                vector.push_back({ordinal, 0, {}});
+            }
+            vector.back().term_freq++;
+            vector.back().offsets.push_back(offset);
+        }
+
+        tokens_.clear();
+        return vector;
+    }
+
+    /**
+     * @brief Construct a new term vector writer.
+     */
+    term_vector_writer::term_vector_writer(schema::text_indexing_option option)
+        : with_offsets_(option.is_offset_enabled()) {
+        if (!option.is_term_vector_enabled()) {
+            throw bridge_error("Term vectors are not enabled for this indexing option");
+        }
+    }
+
+    /**
+     * @brief Adds the term vector of the next document.
+     */
+    void term_vector_writer::add_document(DocId doc, const term_vector &vector) {
+        if (doc < doc_addresses_.size()) {
+            throw bridge_error("Term vectors must be added by increasing doc id");
+        }
+        while (doc_addresses_.size() < doc) {
+            doc_addresses_.push_back(data_.size());
+            common::write_vint(data_, 0);
+        }
+        doc_addresses_.push_back(data_.size());
+
+        common::write_vint(data_, vector.size());
+        uint32_t previous_ordinal = 0;
+        for (const auto &entry : vector) {
+            if (entry.term_ordinal < previous_ordinal) {
+                throw bridge_error("Term vector must be sorted by term ordinal");
+            }
+            common::write_vint(data_, entry.term_ordinal - previous_ordinal);
+            common::write_vint(data_, entry.term_freq);
+            previous_ordinal = entry.term_ordinal;
+
+            if (!with_offsets_) {
+                continue;
+            }
+            if (entry.offsets.size() != entry.term_freq) {
+                throw bridge_error("Term vector offsets do not match the term frequency");
+            }
+            uint32_t previous_to = 0;
+            for (const auto &offset : entry.offsets) {
+                if (offset.from < previous_to || offset.to < offset.from) {
+                    throw bridge_error("Term vector offsets must be increasing and non-overlapping");
+                }
+                common::write_vint(data_, offset.from - previous_to);
+                common::write_vint(data_, offset.to - offset.from);
+                previous_to = offset.to;
+            }
+        }
+    }
+
+    /**
+     * @brief Writes the term vector file.
+     */
+    uint64_t term_vector_writer::serialize(std::ostream &os) const {
+        os.write(data_.data(), static_cast<std::streamsize>(data_.size()));
+        for (uint64_t address : doc_addresses_) {
+            common::write_fixed<uint64_t>(os, address);
+        }
+        common::write_fixed<uint64_t>(os, data_.size());
+        common::write_fixed<uint32_t>(os, static_cast<uint32_t>(doc_addresses_.size()));
+        os.put(static_cast<bridge::byte_t>(with_offsets_ ? 1 : 0));
+        return data_.size() + (doc_addresses_.size() + 1) * sizeof(uint64_t) + footer_size;
+    }
+
+    /**
+     * @brief Opens a term vector file.
+     */
+    term_vector_reader::term_vector_reader(std::shared_ptr<directory::read_only_source> source)
+        : source_(std::move(source)) {
+        size_t size = source_->size();
+        if (size < footer_size + sizeof(uint64_t)) {
+            throw bridge_error("Term vector file is too small");
+        }
+        const bridge::byte_t *footer = source_->deref() + size - footer_size;
+        num_docs_ = common::read_fixed<uint32_t>(footer);
+        with_offsets_ = footer[sizeof(uint32_t)] != 0;
+
+        size_t addresses_size = (static_cast<size_t>(num_docs_) + 1) * sizeof(uint64_t);
+        if (size < footer_size + addresses_size) {
+            throw bridge_error("Corrupted term vector file");
+        }
+        addresses_ = footer - addresses_size;
+
+        // get() decodes between two addresses, so they must stay ordered and inside the data section
+        uint64_t data_size = static_cast<uint64_t>(addresses_ - source_->deref());
+        uint64_t previous = 0;
+        for (size_t i = 0; i <= num_docs_; i++) {
+            uint64_t address = common::read_fixed<uint64_t>(addresses_ + i * sizeof(uint64_t));
+            if (address < previous || address > data_size) {
+                throw bridge_error("Corrupted term vector file");
+            }
+            previous = address;
+        }
+    }
+
+    /**
+     * @brief Decodes the term vector of a document.
+     */
+    term_vector term_vector_reader::get(DocId doc) const {
+        if (doc >= num_docs_) {
+            return {};
+        }
+        const bridge::byte_t *base = source_->deref();
+        const bridge::byte_t *data = base + common::read_fixed<uint64_t>(addresses_ + doc * sizeof(uint64_t));
+        const bridge::byte_t *end = base + common::read_fixed<uint64_t>(addresses_ + (doc + 1) * sizeof(uint64_t));
+
+        // every entry takes at least two bytes, every offset two more: counts beyond that are corrupted
+        uint64_t num_entries = common::read_vint(data, end);
+        if (num_entries > static_cast<uint64_t>(end - data) / 2) {
+            throw bridge_error("Corrupted term vector");
+        }
+        term_vector vector(num_entries);
+        uint32_t ordinal = 0;
+        for (auto &entry : vector) {
+            ordinal += static_cast<uint32_t>(common::read_vint(data, end));
+            entry.term_ordinal = ordinal;
+            entry.term_freq = static_cast<uint32_t>(common::read_vint(data, end));
+
+            if (!with_offsets_) {
+                continue;
+            }
+            if (entry.term_freq > static_cast<uint64_t>(end - data) / 2) {
+                throw bridge_error("Corrupted term vector");
+            }
+            entry.offsets.reserve(entry.term_freq);
+            uint32_t previous_to = 0;
+            for (uint32_t i = 0; i < entry.term_freq; i++) {
+                uint32_t from = previous_to + static_cast<uint32_t>(common::read_vint(data, end));
+                uint32_t to = from + static_cast<uint32_t>(common::read_vint(data, end));
+                entry.offsets.push_back({from, to});
+                previous_to = to;
+            }
+        }
+        return vector;
+    }
+
+} // namespace bridge::postings
@@ -0,0 +1,160 @@
+// Copyright (c) 2021 Bridge Project (Marcos Pontes)
+
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to
+//  deal in the Software without restriction, including without limitation the
+//  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+//  sell copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+//  IN THE SOFTWARE.
+
+#include <algorithm>
+
+#include "bridge/error.hpp"
+#include "bridge/query/block_join.hpp"
+
+namespace bridge::query {
+
+    using postings::TERMINATED;
+
+    namespace {
+        /// @brief First document of the block ending at, or holding, doc.
+        DocId block_start(const postings::bit_set &parents, DocId doc) {
+            DocId previous = doc == 0 ? TERMINATED : parents.prev_set_bit(doc - 1);
+            return previous == TERMINATED ? 0 : previous + 1;
+        }
+    } // namespace
+
+    /**
+     * @brief Construct a new scorer.
+     */
+    to_parent_scorer::to_parent_scorer(std::unique_ptr<scorer> children, const postings::bit_set &parents,
+                                       block_join_score_mode mode)
+        : children_(std::move(children)), parents_(&parents), mode_(mode) {
+        next_parent();
+    }
+
+    DocId to_parent_scorer::advance() {
+        if (doc_ == TERMINATED) {
+            return doc_;
+        }
+        return next_parent();
+    }
+
+    DocId to_parent_scorer::seek(DocId target) {
+        if (target <= doc_) {
+            return doc_;
+        }
+        children_->seek(block_start(*parents_, target));
+        return next_parent();
+    }
+
+    /**
+     * @brief Consumes the block of the current child and moves to its parent.
+     */
+    DocId to_parent_scorer::next_parent() {
+        DocId child = children_->doc();
+        if (child == TERMINATED) {
+            return doc_ = TERMINATED;
+        }
+        DocId parent = parents_->next_set_bit(child);
+        if (parent == TERMINATED) {
+            throw bridge_error("Child document without a parent");
+        }
+
+        Score total = 0.0F;
+        Score best = children_->score();
+        Score worst = best;
+        uint32_t count = 0;
+        for (; child < parent; child = children_->advance()) {
+            Score score = children_->score();
+            total += score;
+            best = std::max(best, score);
+            worst = std::min(worst, score);
+            count++;
+        }
+        if (child == parent) {
+            throw bridge_error("The child query of a block join matched a parent document");
+        }
+
+        switch (mode_) {
+        case block_join_score_mode::None:
+            score_ = 0.0F;
+            break;
+        case block_join_score_mode::Avg:
+            score_ = total / static_cast<Score>(count);
+            break;
+        case block_join_score_mode::Max:
+            score_ = best;
+            break;
+        case block_join_score_mode::Min:
+            score_ = worst;
+            break;
+        case block_join_score_mode::Total:
+            score_ = total;
+            break;
+        }
+        num_children_ = count;
+        return doc_ = parent;
+    }
+
+    /**
+     * @brief Construct a new scorer.
+     */
+    to_child_scorer::to_child_scorer(std::unique_ptr<scorer> parents_query, const postings::bit_set &parents)
+        : parents_query_(std::move(parents_query)), parents_(&parents) {
+        first_child(0);
+    }
+
+    DocId to_child_scorer::advance() {
+        if (doc_ == TERMINATED) {
+            return doc_;
+        }
+        if (++doc_ < parent_) {
+            return doc_;
+        }
+        parents_query_->advance();
+        return first_child(0);
+    }
+
+    DocId to_child_scorer::seek(DocId target) {
+        if (target <= doc_) {
+            return doc_;
+        }
+        if (target < parent_) {
+            return doc_ = target;
+        }
+        parents_query_->seek(parents_->next_set_bit(target));
+        return first_child(target);
+    }
+
+    /**
+     * @brief Moves to the first child, not below min_doc, of the current parent or of the next ones.
+     */
+    DocId to_child_scorer::first_child(DocId min_doc) {
+        for (DocId parent = parents_query_->doc(); parent != TERMINATED; parent = parents_query_->advance()) {
+            if (!parents_->contains(parent)) {
+                throw bridge_error("The parent query of a block join matched a child document");
+            }
+            DocId child = std::max(block_start(*parents_, parent), min_doc);
+            if (child < parent) {
+                parent_ = parent;
+                score_ = parents_query_->score();
+                return doc_ = child;
+            }
+        }
+        parent_ = TERMINATED;
+        return doc_ = TERMINATED;
+    }
+
+} // namespace bridge::query
@@ -0,0 +1,123 @@
+// Copyright (c) 2021 Bridge Project (Marcos Pontes)
+
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to
+//  deal in the Software without restriction, including without limitation the
+//  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+//  sell copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+//  IN THE SOFTWARE.
+
+#include <algorithm>
+#include <utility>
+
+#include "bridge/error.hpp"
+#include "bridge/query/bm25f_scorer.hpp"
+
+namespace bridge::query {
+
+    /**
+     * @brief Construct a new scorer, positioned on the first matching document.
+     */
+    bm25f_scorer::bm25f_scorer(std::vector<bm25f_field> fields, std::vector<bm25f_term> terms, Score k1)
+        : fields_(std::move(fields)), terms_(std::move(terms)), norms_(fields_.size()),
+          pseudo_freqs_(terms_.size()), k1_(k1) {
+        for (const auto &field : fields_) {
+            if (field.field_norms == nullptr) {
+                throw bridge_error("A BM25F field needs its field norms");
+            }
+        }
+        for (uint32_t t = 0; t < terms_.size(); t++) {
+            if (terms_[t].postings.size() != fields_.size()) {
+                throw bridge_error("A term needs one postings cursor per field");
+            }
+            for (uint32_t f = 0; f < fields_.size(); f++) {
+                if (terms_[t].postings[f]) {
+                    cursors_.push_back({t, f, terms_[t].postings[f].get()});
+                }
+            }
+        }
+        doc_ = next_doc();
+    }
+
+    DocId bm25f_scorer::next_doc() const {
+        DocId next = postings::TERMINATED;
+        for (const auto &entry : cursors_) {
+            next = std::min(next, entry.cursor->doc());
+        }
+        return next;
+    }
+
+    DocId bm25f_scorer::advance() {
+        if (doc_ == postings::TERMINATED) {
+            return doc_;
+        }
+        for (auto &entry : cursors_) {
+            if (entry.cursor->doc() == doc_) {
+                entry.cursor->advance();
+            }
+        }
+        doc_ = next_doc();
+        return doc_;
+    }
+
+    DocId bm25f_scorer::seek(DocId target) {
+        if (target <= doc_) {
+            return doc_;
+        }
+        for (auto &entry : cursors_) {
+            entry.cursor->seek(target);
+        }
+        doc_ = next_doc();
+        return doc_;
+    }
+
+    uint32_t bm25f_scorer::size_hint() const {
+        uint32_t hint = 0;
+        for (const auto &entry : cursors_) {
+            hint = std::max(hint, entry.cursor->size_hint());
+        }
+        return hint;
+    }
+
+    /**
+     * @brief Score of the current document.
+     */
+    Score bm25f_scorer::score() const {
+        if (doc_ == postings::TERMINATED) {
+            return 0.0F;
+        }
+
+        // length normalization of each field, computed once for every term
+        for (size_t f = 0; f < fields_.size(); f++) {
+            const bm25f_field &field = fields_[f];
+            auto length = static_cast<Score>((*field.field_norms)[doc_]);
+            norms_[f] = field.weight / (1.0F - field.b + field.b * length / field.average_field_norm);
+        }
+
+        std::fill(pseudo_freqs_.begin(), pseudo_freqs_.end(), 0.0F);
+        for (const auto &entry : cursors_) {
+            if (entry.cursor->doc() == doc_) {
+                pseudo_freqs_[entry.term] += static_cast<Score>(entry.cursor->term_freq()) * norms_[entry.field];
+            }
+        }
+
+        Score score = 0.0F;
+        for (size_t t = 0; t < terms_.size(); t++) {
+            Score tf = pseudo_freqs_[t];
+            score += terms_[t].idf * (k1_ + 1.0F) * tf / (k1_ + tf);
+        }
+        return score;
+    }
+
+} // namespace bridge::query
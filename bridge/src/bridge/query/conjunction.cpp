@@ -0,0 +1,144 @@
+// Copyright (c) 2021 Bridge Project (Marcos Pontes)
+
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to
+//  deal in the Software without restriction, including without limitation the
+//  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+//  sell copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+//  IN THE SOFTWARE.
+
+#include <algorithm>
+
+#include "bridge/error.hpp"
+#include "bridge/query/conjunction.hpp"
+
+namespace bridge::query {
+
+    using postings::TERMINATED;
+
+    namespace {
+        /// @brief Approximations of the scorers, the sparsest first.
+        std::vector<postings::doc_set *> approximations(const std::vector<std::unique_ptr<scorer>> &scorers) {
+            if (scorers.empty()) {
+                throw bridge_error("A conjunction needs at least one clause");
+            }
+            std::vector<postings::doc_set *> sets;
+            sets.reserve(scorers.size());
+            for (const auto &clause : scorers) {
+                postings::two_phase_iterator *phase = clause->two_phase();
+                sets.push_back(phase != nullptr ? &phase->approximation() : clause.get());
+            }
+            std::stable_sort(sets.begin(), sets.end(), [](const postings::doc_set *a, const postings::doc_set *b) {
+                return a->size_hint() < b->size_hint();
+            });
+            return sets;
+        }
+    } // namespace
+
+    /**
+     * @brief Construct a new intersection.
+     */
+    doc_set_intersection::doc_set_intersection(std::vector<postings::doc_set *> sets) : sets_(std::move(sets)) {
+        if (sets_.empty()) {
+            throw bridge_error("An intersection needs at least one doc set");
+        }
+        align(sets_.front()->doc());
+    }
+
+    DocId doc_set_intersection::advance() {
+        if (doc_ == TERMINATED) {
+            return doc_;
+        }
+        return align(sets_.front()->advance());
+    }
+
+    DocId doc_set_intersection::seek(DocId target) {
+        if (target <= doc_) {
+            return doc_;
+        }
+        return align(sets_.front()->seek(target));
+    }
+
+    /**
+     * @brief Moves every doc set to the first document they all hold, from a document of the lead.
+     */
+    DocId doc_set_intersection::align(DocId doc) {
+        while (doc != TERMINATED) {
+            DocId overshoot = doc;
+            for (size_t i = 1; i < sets_.size() && overshoot == doc; i++) {
+                overshoot = sets_[i]->seek(doc);
+            }
+            if (overshoot == doc) {
+                break;
+            }
+            doc = sets_.front()->seek(overshoot);
+        }
+        return doc_ = doc;
+    }
+
+    /**
+     * @brief Construct a new scorer.
+     */
+    conjunction_scorer::conjunction_scorer(std::vector<std::unique_ptr<scorer>> scorers)
+        : scorers_(std::move(scorers)), approximation_(approximations(scorers_)) {
+        for (const auto &clause : scorers_) {
+            if (postings::two_phase_iterator *phase = clause->two_phase()) {
+                phases_.push_back(phase);
+            }
+        }
+        std::stable_sort(phases_.begin(), phases_.end(),
+                         [](const postings::two_phase_iterator *a, const postings::two_phase_iterator *b) {
+                             return a->match_cost() < b->match_cost();
+                         });
+        next_match();
+    }
+
+    DocId conjunction_scorer::advance() {
+        if (doc() == TERMINATED) {
+            return doc();
+        }
+        approximation_.advance();
+        return next_match();
+    }
+
+    DocId conjunction_scorer::seek(DocId target) {
+        if (target <= doc()) {
+            return doc();
+        }
+        approximation_.seek(target);
+        return next_match();
+    }
+
+    Score conjunction_scorer::score() const {
+        Score total = 0.0F;
+        for (const auto &clause : scorers_) {
+            total += clause->score();
+        }
+        return total;
+    }
+
+    bool conjunction_scorer::matches() {
+        return std::all_of(phases_.begin(), phases_.end(),
+                           [](postings::two_phase_iterator *phase) { return phase->matches(); });
+    }
+
+    float conjunction_scorer::match_cost() const {
+        float total = 0.0F;
+        for (const auto *phase : phases_) {
+            total += phase->match_cost();
+        }
+        return total;
+    }
+
+} // namespace bridge::query
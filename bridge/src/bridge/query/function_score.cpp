@@ -0,0 +1,321 @@
+// Copyright (c) 2021 Bridge Project (Marcos Pontes)
+
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to
+//  deal in the Software without restriction, including without limitation the
+//  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+//  sell copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+//  IN THE SOFTWARE.
+
+#include <algorithm>
+#include <cmath>
+#include <numbers>
+#include <utility>
+
+#include "bridge/error.hpp"
+#include "bridge/query/function_score.hpp"
+
+namespace bridge::query {
+
+    namespace {
+
+        // mean radius of the earth, in meters
+        constexpr double earth_radius = 6371008.8;
+
+        constexpr double to_radians(double degrees) { return degrees * std::numbers::pi / 180.0; }
+
+        /// @brief Combines a block of values into another, the operation being resolved once per block.
+        template <typename Op> void combine(Score *into, const Score *values, size_t count, Op op) {
+            for (size_t i = 0; i < count; i++) {
+                into[i] = op(into[i], values[i]);
+            }
+        }
+
+    } // namespace
+
+    /**
+     * @brief Construct a new decay function over a numeric column.
+     */
+    decay_function::decay_function(decay_kind kind, const fastfield::numeric_column &column, double origin,
+                                   double scale, double offset, double decay)
+        : decay_function(kind, scale, offset, decay) {
+        column_ = &column;
+        origin_ = origin;
+    }
+
+    decay_function::decay_function(decay_kind kind, double scale, double offset, double decay)
+        : kind_(kind), offset_(offset) {
+        if (!(scale > 0.0) || !(decay > 0.0 && decay < 1.0) || !(offset >= 0.0)) {
+            throw bridge_error("A decay needs a positive scale, a non-negative offset and a decay in (0, 1)");
+        }
+        switch (kind_) {
+        case decay_kind::Linear:
+            factor_ = (1.0 - decay) / scale;
+            break;
+        case decay_kind::Exp:
+            factor_ = std::log(decay) / scale;
+            break;
+        case decay_kind::Gauss:
+            factor_ = std::log(decay) / (scale * scale);
+            break;
+        }
+    }
+
+    void decay_function::evaluate(const DocId *docs, size_t count, Score *out) const {
+        double distances[block_size];
+        column_->get_many(docs, count, distances);
+        for (size_t i = 0; i < count; i++) {
+            distances[i] = std::abs(distances[i] - origin_);
+        }
+        decay_distances(distances, count, out);
+    }
+
+    /**
+     * @brief Turns a block of distances into function values.
+     */
+    void decay_function::decay_distances(const double *distances, size_t count, Score *out) const {
+        // the kind is resolved once per block so that every loop is branch free
+        switch (kind_) {
+        case decay_kind::Linear:
+            for (size_t i = 0; i < count; i++) {
+                double d = std::max(0.0, distances[i] - offset_);
+                out[i] = static_cast<Score>(std::max(0.0, 1.0 - d * factor_));
+            }
+            break;
+        case decay_kind::Exp:
+            for (size_t i = 0; i < count; i++) {
+                double d = std::max(0.0, distances[i] - offset_);
+                out[i] = static_cast<Score>(std::exp(d * factor_));
+            }
+            break;
+        case decay_kind::Gauss:
+            for (size_t i = 0; i < count; i++) {
+                double d = std::max(0.0, distances[i] - offset_);
+                out[i] = static_cast<Score>(std::exp(d * d * factor_));
+            }
+            break;
+        }
+    }
+
+    /**
+     * @brief Construct a new geo decay function.
+     */
+    geo_decay_function::geo_decay_function(decay_kind kind, const fastfield::numeric_column &latitudes,
+                                           const fastfield::numeric_column &longitudes, double origin_latitude,
+                                           double origin_longitude, double scale, double offset, double decay)
+        : decay_function(kind, scale, offset, decay), latitudes_(&latitudes), longitudes_(&longitudes),
+          origin_latitude_(to_radians(origin_latitude)), origin_longitude_(to_radians(origin_longitude)) {}
+
+    void geo_decay_function::evaluate(const DocId *docs, size_t count, Score *out) const {
+        double latitudes[block_size];
+        double longitudes[block_size];
+        latitudes_->get_many(docs, count, latitudes);
+        longitudes_->get_many(docs, count, longitudes);
+
+        // haversine distance to the origin
+        double distances[block_size];
+        double cos_origin = std::cos(origin_latitude_);
+        for (size_t i = 0; i < count; i++) {
+            double latitude = to_radians(latitudes[i]);
+            double sin_latitude = std::sin((latitude - origin_latitude_) / 2.0);
+            double sin_longitude = std::sin((to_radians(longitudes[i]) - origin_longitude_) / 2.0);
+            double h = sin_latitude * sin_latitude + cos_origin * std::cos(latitude) * sin_longitude * sin_longitude;
+            distances[i] = 2.0 * earth_radius * std::asin(std::sqrt(std::min(1.0, h)));
+        }
+        decay_distances(distances, count, out);
+    }
+
+    /**
+     * @brief Construct a new field value factor.
+     */
+    field_value_factor::field_value_factor(const fastfield::numeric_column &column, double factor,
+                                           value_modifier modifier)
+        : column_(&column), factor_(factor), modifier_(modifier) {}
+
+    void field_value_factor::evaluate(const DocId *docs, size_t count, Score *out) const {
+        double values[block_size];
+        column_->get_many(docs, count, values);
+        for (size_t i = 0; i < count; i++) {
+            values[i] *= factor_;
+        }
+
+        switch (modifier_) {
+        case value_modifier::None:
+            break;
+        case value_modifier::Log:
+            std::transform(values, values + count, values, [](double v) { return std::log10(v); });
+            break;
+        case value_modifier::Log1p:
+            std::transform(values, values + count, values, [](double v) { return std::log10(v + 1.0); });
+            break;
+        case value_modifier::Log2p:
+            std::transform(values, values + count, values, [](double v) { return std::log10(v + 2.0); });
+            break;
+        case value_modifier::Ln:
+            std::transform(values, values + count, values, [](double v) { return std::log(v); });
+            break;
+        case value_modifier::Ln1p:
+            std::transform(values, values + count, values, [](double v) { return std::log1p(v); });
+            break;
+        case value_modifier::Ln2p:
+            std::transform(values, values + count, values, [](double v) { return std::log(v + 2.0); });
+            break;
+        case value_modifier::Square:
+            std::transform(values, values + count, values, [](double v) { return v * v; });
+            break;
+        case value_modifier::Sqrt:
+            std::transform(values, values + count, values, [](double v) { return std::sqrt(v); });
+            break;
+        case value_modifier::Reciprocal:
+            std::transform(values, values + count, values, [](double v) { return 1.0 / v; });
+            break;
+        }
+        for (size_t i = 0; i < count; i++) {
+            out[i] = static_cast<Score>(values[i]);
+        }
+    }
+
+    /**
+     * @brief Construct a new function score scorer, positioned on the first matching document.
+     */
+    function_score_scorer::function_score_scorer(std::unique_ptr<scorer> inner,
+                                                 std::vector<std::unique_ptr<score_function>> functions,
+                                                 score_mode functions_mode, boost_mode query_mode)
+        : inner_(std::move(inner)), functions_(std::move(functions)), functions_mode_(functions_mode),
+          query_mode_(query_mode) {
+        if (!inner_) {
+            throw bridge_error("A function score needs a query");
+        }
+        // the first document may only be a seek start, so it is not worth a block yet
+        hold_inner();
+    }
+
+    DocId function_score_scorer::advance() {
+        if (position_ < count_ && ++position_ == count_) {
+            if (holds_inner_) {
+                inner_->advance();
+            }
+            refill();
+        }
+        return doc();
+    }
+
+    DocId function_score_scorer::seek(DocId target) {
+        while (position_ < count_ && docs_[position_] < target) {
+            position_++;
+        }
+        if (position_ == count_) {
+            inner_->seek(target);
+            hold_inner();
+        }
+        return doc();
+    }
+
+    /**
+     * @brief Score of the current document.
+     */
+    Score function_score_scorer::score() const {
+        if (position_ >= count_) {
+            return 0.0F;
+        }
+        if (unscored_) {
+            scores_[0] = inner_->score();
+            apply_functions(1);
+            unscored_ = false;
+        }
+        return scores_[position_];
+    }
+
+    void function_score_scorer::hold_inner() {
+        DocId doc = inner_->doc();
+        docs_[0] = doc;
+        count_ = doc == postings::TERMINATED ? 0 : 1;
+        position_ = 0;
+        holds_inner_ = true;
+        unscored_ = count_ > 0;
+    }
+
+    void function_score_scorer::refill() {
+        count_ = 0;
+        position_ = 0;
+        holds_inner_ = false;
+        unscored_ = false;
+        for (DocId doc = inner_->doc(); doc != postings::TERMINATED && count_ < docs_.size();
+             doc = inner_->advance()) {
+            docs_[count_] = doc;
+            scores_[count_] = inner_->score();
+            count_++;
+        }
+        apply_functions(count_);
+    }
+
+    /**
+     * @brief Mixes the function values into the query scores of the first count buffered documents.
+     */
+    void function_score_scorer::apply_functions(size_t count) const {
+        if (count == 0 || functions_.empty()) {
+            return;
+        }
+
+        std::array<Score, score_function::block_size> combined{};
+        std::array<Score, score_function::block_size> values{};
+        functions_[0]->evaluate(docs_.data(), count, combined.data());
+        for (size_t f = 1; f < functions_.size(); f++) {
+            functions_[f]->evaluate(docs_.data(), count, values.data());
+            switch (functions_mode_) {
+            case score_mode::Multiply:
+                combine(combined.data(), values.data(), count, [](Score a, Score b) { return a * b; });
+                break;
+            case score_mode::Sum:
+            case score_mode::Avg:
+                combine(combined.data(), values.data(), count, [](Score a, Score b) { return a + b; });
+                break;
+            case score_mode::Max:
+                combine(combined.data(), values.data(), count, [](Score a, Score b) { return std::max(a, b); });
+                break;
+            case score_mode::Min:
+                combine(combined.data(), values.data(), count, [](Score a, Score b) { return std::min(a, b); });
+                break;
+            }
+        }
+        if (functions_mode_ == score_mode::Avg) {
+            auto n = static_cast<Score>(functions_.size());
+            for (size_t i = 0; i < count; i++) {
+                combined[i] /= n;
+            }
+        }
+
+        switch (query_mode_) {
+        case boost_mode::Multiply:
+            combine(scores_.data(), combined.data(), count, [](Score a, Score b) { return a * b; });
+            break;
+        case boost_mode::Sum:
+            combine(scores_.data(), combined.data(), count, [](Score a, Score b) { return a + b; });
+            break;
+        case boost_mode::Replace:
+            std::copy_n(combined.begin(), count, scores_.begin());
+            break;
+        case boost_mode::Avg:
+            combine(scores_.data(), combined.data(), count, [](Score a, Score b) { return (a + b) / 2.0F; });
+            break;
+        case boost_mode::Max:
+            combine(scores_.data(), combined.data(), count, [](Score a, Score b) { return std::max(a, b); });
+            break;
+        case boost_mode::Min:
+            combine(scores_.data(), combined.data(), count, [](Score a, Score b) { return std::min(a, b); });
+            break;
+        }
+    }
+
+} // namespace bridge::query
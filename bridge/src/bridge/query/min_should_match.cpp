@@ -0,0 +1,165 @@
+// Copyright (c) 2021 Bridge Project (Marcos Pontes)
+
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to
+//  deal in the Software without restriction, including without limitation the
+//  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+//  sell copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+//  IN THE SOFTWARE.
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+
+#include "bridge/error.hpp"
+#include "bridge/query/min_should_match.hpp"
+
+namespace bridge::query {
+
+    using postings::TERMINATED;
+
+    /**
+     * @brief Construct a new scorer.
+     */
+    min_should_match_scorer::min_should_match_scorer(std::vector<std::unique_ptr<scorer>> scorers,
+                                                     uint32_t minimum_should_match)
+        : scorers_(std::move(scorers)), minimum_(minimum_should_match) {
+        if (minimum_ == 0) {
+            throw bridge_error("The minimum number of matching clauses must be at least 1");
+        }
+        heap_.reserve(scorers_.size());
+        for (uint32_t clause = 0; clause < scorers_.size(); clause++) {
+            push(clause);
+        }
+        next_match();
+    }
+
+    /**
+     * @brief Number of clauses required for a percentage of them, rounded down but at least 1.
+     */
+    uint32_t min_should_match_scorer::from_percentage(size_t num_clauses, double percentage) {
+        if (!(percentage >= 0.0 && percentage <= 100.0)) {
+            throw bridge_error("The percentage of matching clauses must be in [0, 100]");
+        }
+        auto required = static_cast<uint32_t>(std::floor(static_cast<double>(num_clauses) * percentage / 100.0));
+        return std::max<uint32_t>(required, 1);
+    }
+
+    DocId min_should_match_scorer::advance() {
+        if (doc_ == TERMINATED) {
+            return doc_;
+        }
+        for (uint32_t clause : lead_) {
+            scorers_[clause]->advance();
+            push(clause);
+        }
+        lead_.clear();
+        return next_match();
+    }
+
+    DocId min_should_match_scorer::seek(DocId target) {
+        if (target <= doc_) {
+            return doc_;
+        }
+        for (uint32_t clause : lead_) {
+            scorers_[clause]->seek(target);
+            push(clause);
+        }
+        lead_.clear();
+        while (!heap_.empty() && heap_.front().first < target) {
+            uint32_t clause = pop();
+            scorers_[clause]->seek(target);
+            push(clause);
+        }
+        return next_match();
+    }
+
+    uint32_t min_should_match_scorer::size_hint() const {
+        if (minimum_ > scorers_.size()) {
+            return 0;
+        }
+        // a match is in m clauses, so it is in at least one of any n - m + 1 of them: take the smallest
+        std::vector<uint64_t> sizes;
+        sizes.reserve(scorers_.size());
+        for (const auto &clause : scorers_) {
+            sizes.push_back(clause->size_hint());
+        }
+        std::sort(sizes.begin(), sizes.end());
+        uint64_t total = 0;
+        for (size_t i = 0; i < scorers_.size() - minimum_ + 1; i++) {
+            total += sizes[i];
+        }
+        return static_cast<uint32_t>(std::min<uint64_t>(total, TERMINATED));
+    }
+
+    Score min_should_match_scorer::score() const {
+        Score total = 0.0F;
+        for (uint32_t clause : lead_) {
+            total += scorers_[clause]->score();
+        }
+        return total;
+    }
+
+    /**
+     * @brief Adds a clause to the heap, unless it is exhausted.
+     */
+    void min_should_match_scorer::push(uint32_t clause) {
+        DocId doc = scorers_[clause]->doc();
+        if (doc != TERMINATED) {
+            heap_.emplace_back(doc, clause);
+            std::push_heap(heap_.begin(), heap_.end(), std::greater<>());
+        }
+    }
+
+    /**
+     * @brief Removes the clause with the smallest doc id from the heap.
+     */
+    uint32_t min_should_match_scorer::pop() {
+        std::pop_heap(heap_.begin(), heap_.end(), std::greater<>());
+        uint32_t clause = heap_.back().second;
+        heap_.pop_back();
+        return clause;
+    }
+
+    /**
+     * @brief Moves to the next match from the clauses of the heap.
+     */
+    DocId min_should_match_scorer::next_match() {
+        while (heap_.size() >= minimum_) {
+            tail_.clear();
+            for (uint32_t i = 1; i < minimum_; i++) {
+                tail_.push_back(pop());
+            }
+            DocId candidate = heap_.front().first;
+            bool agree = std::all_of(tail_.begin(), tail_.end(),
+                                     [&](uint32_t clause) { return scorers_[clause]->doc() == candidate; });
+            for (uint32_t clause : tail_) {
+                if (!agree) {
+                    // fewer than m clauses can match before the candidate
+                    scorers_[clause]->seek(candidate);
+                }
+                push(clause);
+            }
+            if (agree) {
+                while (!heap_.empty() && heap_.front().first == candidate) {
+                    lead_.push_back(pop());
+                }
+                return doc_ = candidate;
+            }
+        }
+        heap_.clear();
+        return doc_ = TERMINATED;
+    }
+
+} // namespace bridge::query
@@ -0,0 +1,67 @@
+// Copyright (c) 2021 Bridge Project (Marcos Pontes)
+
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to
+//  deal in the Software without restriction, including without limitation the
+//  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+//  sell copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+//  IN THE SOFTWARE.
+
+#include "bridge/query/predicate_scorer.hpp"
+
+namespace bridge::query {
+
+    /**
+     * @brief Construct a new scorer.
+     */
+    predicate_scorer::predicate_scorer(std::unique_ptr<scorer> inner, doc_predicate predicate, float cost)
+        : inner_(std::move(inner)), inner_phase_(inner_->two_phase()),
+          approximation_(inner_phase_ != nullptr ? &inner_phase_->approximation() : inner_.get()),
+          predicate_(std::move(predicate)), cost_(cost) {
+        next_match();
+    }
+
+    DocId predicate_scorer::advance() {
+        if (doc() == postings::TERMINATED) {
+            return doc();
+        }
+        approximation_->advance();
+        return next_match();
+    }
+
+    DocId predicate_scorer::seek(DocId target) {
+        if (target <= doc()) {
+            return doc();
+        }
+        approximation_->seek(target);
+        return next_match();
+    }
+
+    bool predicate_scorer::matches() {
+        DocId doc = approximation_->doc();
+        if (doc == confirmed_) {
+            return true;
+        }
+        if ((inner_phase_ == nullptr || inner_phase_->matches()) && predicate_(doc)) {
+            confirmed_ = doc;
+            return true;
+        }
+        return false;
+    }
+
+    float predicate_scorer::match_cost() const {
+        return cost_ + (inner_phase_ != nullptr ? inner_phase_->match_cost() : 0.0F);
+    }
+
+} // namespace bridge::query
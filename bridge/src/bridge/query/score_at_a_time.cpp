@@ -0,0 +1,96 @@
+// Copyright (c) 2021 Bridge Project (Marcos Pontes)
+
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to
+//  deal in the Software without restriction, including without limitation the
+//  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+//  sell copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+//  IN THE SOFTWARE.
+
+#include <algorithm>
+
+#include "bridge/error.hpp"
+#include "bridge/query/score_at_a_time.hpp"
+
+namespace bridge::query {
+
+    /**
+     * @brief Construct a new evaluator.
+     */
+    score_at_a_time::score_at_a_time(DocId max_doc) : accumulators_(max_doc, 0) {}
+
+    /**
+     * @brief Adds a query term.
+     */
+    void score_at_a_time::add_term(const postings::impact_postings &postings, uint32_t query_weight) {
+        // an accumulator at 0 marks an untouched doc, so every processed posting must add a positive impact
+        if (query_weight == 0) {
+            throw bridge_error("Query weight must be positive");
+        }
+        // validated up front so that top_k never fails with dirty accumulators; segments are sorted by doc id
+        for (const auto &segment : postings.segments()) {
+            if (!segment.docs.empty() && segment.docs.back() >= accumulators_.size()) {
+                throw bridge_error("Doc id out of the segment range");
+            }
+        }
+        for (const auto &segment : postings.segments()) {
+            if (segment.impact > 0) {
+                pending_.push_back({segment.impact * query_weight, &segment});
+            }
+        }
+    }
+
+    /**
+     * @brief Evaluates the query and clears the terms.
+     */
+    std::vector<impact_hit> score_at_a_time::top_k(size_t k, uint64_t budget) {
+        // highest impacts first; stable so that a term keeps its segment order on ties
+        std::stable_sort(pending_.begin(), pending_.end(),
+                         [](const pending_segment &a, const pending_segment &b) { return a.impact > b.impact; });
+
+        processed_ = 0;
+        for (const auto &[impact, segment] : pending_) {
+            if (processed_ >= budget) {
+                break;
+            }
+            size_t remaining = std::min<uint64_t>(budget - processed_, segment->docs.size());
+            for (size_t i = 0; i < remaining; i++) {
+                DocId doc = segment->docs[i];
+                if (accumulators_[doc] == 0) {
+                    touched_.push_back(doc);
+                }
+                accumulators_[doc] += impact;
+            }
+            processed_ += remaining;
+        }
+        pending_.clear();
+
+        std::vector<impact_hit> hits;
+        hits.reserve(touched_.size());
+        for (DocId doc : touched_) {
+            hits.push_back({doc, accumulators_[doc]});
+            accumulators_[doc] = 0; // reset for the next query
+        }
+        touched_.clear();
+
+        auto by_score = [](const impact_hit &a, const impact_hit &b) {
+            return a.score != b.score ? a.score > b.score : a.doc < b.doc;
+        };
+        size_t n = std::min(k, hits.size());
+        std::partial_sort(hits.begin(), hits.begin() + static_cast<long>(n), hits.end(), by_score);
+        hits.resize(n);
+        return hits;
+    }
+
+} // namespace bridge::query
@@ -0,0 +1,150 @@
+// Copyright (c) 2021 Bridge Project (Marcos Pontes)
+
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to
+//  deal in the Software without restriction, including without limitation the
+//  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+//  sell copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+//  IN THE SOFTWARE.
+
+#include <algorithm>
+
+#include "bridge/postings/bit_set.hpp"
+#include "bridge/query/terms_set.hpp"
+
+namespace bridge::query {
+
+    using postings::TERMINATED;
+
+    namespace {
+        /// @brief Cursor owning the bit set it iterates.
+        class owned_bit_set_cursor : public postings::doc_set {
+          public:
+            explicit owned_bit_set_cursor(postings::bit_set &&set) : set_(std::move(set)), cursor_(set_) {}
+
+            DocId advance() override { return cursor_.advance(); }
+
+            [[nodiscard]] DocId doc() const override { return cursor_.doc(); }
+
+            DocId seek(DocId target) override { return cursor_.seek(target); }
+
+            [[nodiscard]] uint32_t size_hint() const override { return cursor_.size_hint(); }
+
+          private:
+            postings::bit_set set_;
+            postings::bit_set_cursor cursor_;
+        };
+    } // namespace
+
+    /**
+     * @brief Construct a new union.
+     */
+    doc_set_union::doc_set_union(std::vector<std::unique_ptr<postings::doc_set>> sets) : sets_(std::move(sets)) {
+        update();
+    }
+
+    DocId doc_set_union::advance() {
+        if (doc_ == TERMINATED) {
+            return doc_;
+        }
+        for (auto &set : sets_) {
+            if (set->doc() == doc_) {
+                set->advance();
+            }
+        }
+        return update();
+    }
+
+    DocId doc_set_union::seek(DocId target) {
+        if (target <= doc_) {
+            return doc_;
+        }
+        for (auto &set : sets_) {
+            set->seek(target);
+        }
+        return update();
+    }
+
+    uint32_t doc_set_union::size_hint() const {
+        uint64_t total = 0;
+        for (const auto &set : sets_) {
+            total += set->size_hint();
+        }
+        return static_cast<uint32_t>(std::min<uint64_t>(total, TERMINATED));
+    }
+
+    /**
+     * @brief Moves to the smallest current document of the cursors.
+     */
+    DocId doc_set_union::update() {
+        doc_ = TERMINATED;
+        for (const auto &set : sets_) {
+            doc_ = std::min(doc_, set->doc());
+        }
+        return doc_;
+    }
+
+    /**
+     * @brief Construct a new filter.
+     */
+    terms_set::terms_set(std::vector<std::string> terms) : terms_(std::move(terms)) {
+        std::sort(terms_.begin(), terms_.end());
+        terms_.erase(std::unique(terms_.begin(), terms_.end()), terms_.end());
+    }
+
+    /**
+     * @brief Ordinals of the terms of the set found in a dictionary, in increasing order.
+     */
+    std::vector<uint32_t> terms_set::ordinals(const postings::term_dictionary &dictionary) const {
+        std::vector<uint32_t> ordinals;
+        uint32_t ordinal = 0;
+        for (const auto &term : terms_) {
+            ordinal = dictionary.lower_bound(term, ordinal);
+            if (ordinal == dictionary.size()) {
+                break;
+            }
+            if (dictionary.term(ordinal) == term) {
+                ordinals.push_back(ordinal++);
+            }
+        }
+        return ordinals;
+    }
+
+    /**
+     * @brief Matching documents of a segment.
+     */
+    std::unique_ptr<postings::doc_set> terms_set::matching_docs(const postings::term_dictionary &dictionary,
+                                                                const postings_opener &open, DocId max_doc,
+                                                                size_t union_threshold) const {
+        std::vector<uint32_t> matching = ordinals(dictionary);
+        if (matching.size() <= union_threshold) {
+            std::vector<std::unique_ptr<postings::doc_set>> cursors;
+            cursors.reserve(matching.size());
+            for (uint32_t ordinal : matching) {
+                cursors.push_back(open(ordinal));
+            }
+            return std::make_unique<doc_set_union>(std::move(cursors));
+        }
+
+        postings::bit_set bits(max_doc);
+        for (uint32_t ordinal : matching) {
+            auto postings = open(ordinal);
+            for (DocId doc = postings->doc(); doc != TERMINATED; doc = postings->advance()) {
+                bits.insert(doc);
+            }
+        }
+        return std::make_unique<owned_bit_set_cursor>(std::move(bits));
+    }
+
+} // namespace bridge::query
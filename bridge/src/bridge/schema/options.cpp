@@ -130,6 +130,10 @@ namespace bridge::schema {
             return "tokenized_with_freq";
         case TokenizedWithFreqAndPosition:
             return "tokenized_with_freq_and_position";
+        case TokenizedWithTermVector:
+            return "tokenized_with_term_vector";
+        case TokenizedWithTermVectorAndOffsets:
+            return "tokenized_with_term_vector_and_offsets";
         default:
             throw bridge_error("Unknown indexing option");
         }
@@ -152,6 +156,10 @@ namespace bridge::schema {
             return TokenizedWithFreq;
         } else if (str == "tokenized_with_freq_and_position") {
             return TokenizedWithFreqAndPosition;
+        } else if (str == "tokenized_with_term_vector") {
+            return TokenizedWithTermVector;
+        } else if (str == "tokenized_with_term_vector_and_offsets") {
+            return TokenizedWithTermVectorAndOffsets;
         } else {
             throw bridge_error("Unknown indexing option");
         }
@@ -166,6 +174,39 @@ namespace bridge::schema {
         return std::hash<int>()(_index_options);
     }
 
+    /**
+     * @brief Get the string representation of a postings codec.
+     *
+     * @param codec Postings codec.
+     * @return The string representation of the codec.
+     */
+    [[nodiscard]] std::string postings_codec_str(postings_codec codec) {
+        switch (codec) {
+        case postings_codec::Default:
+            return "default";
+        case postings_codec::EliasFano:
+            return "elias_fano";
+        default:
+            throw bridge_error("Unknown postings codec");
+        }
+    }
+
+    /**
+     * @brief Constructs a postings codec from a string.
+     *
+     * @param str String representation of the codec.
+     * @return The postings codec.
+     */
+    [[nodiscard]] postings_codec postings_codec_from_str(const std::string &str) {
+        if (str == "default") {
+            return postings_codec::Default;
+        } else if (str == "elias_fano") {
+            return postings_codec::EliasFano;
+        } else {
+            throw bridge_error("Unknown postings codec");
+        }
+    }
+
     /**
      * @brief Default constructor.
      */
@@ -215,7 +256,7 @@ namespace bridge::schema {
      * @param other Other text_field to be moved.
      */
     text_field_option::text_field_option(text_field_option &&other) noexcept
-        : indexing_options(std::move(other.indexing_options)), stored(other.stored) {}
+        : indexing_options(std::move(other.indexing_options)), stored(other.stored), codec(other.codec) {}
 
     /**
      * @briief Move assignment operator.
@@ -226,6 +267,7 @@ namespace bridge::schema {
     text_field_option &text_field_option::operator=(text_field_option &&other) noexcept {
         indexing_options = other.indexing_options;
         stored = other.stored;
+        codec = other.codec;
         return *this;
     }
 
@@ -237,7 +279,7 @@ namespace bridge::schema {
      */
     bool text_field_option::operator==(const text_field_option &other) const {
         return static_cast<const text_indexing_option>(indexing_options) == other.indexing_options &&
-               stored == other.stored;
+               stored == other.stored && codec == other.codec;
     }
 
     /**
@@ -274,6 +316,15 @@ namespace bridge::schema {
      */
     [[maybe_unused]] void text_field_option::set_stored(bool is_stored) { this->stored = is_stored; }
 
+    /**
+     * @brief Set the codec of the field postings.
+     *
+     * @param postings_codec The new postings codec.
+     */
+    [[maybe_unused]] void text_field_option::set_postings_codec(postings_codec postings_codec) {
+        this->codec = postings_codec;
+    }
+
     /**
      * @brief The | operator allows to combine two text_field.
      *
@@ -281,7 +332,15 @@ namespace bridge::schema {
      * @return A new text_field from the combination of the two text_field.
      */
     text_field_option text_field_option::operator|(const text_field_option &other) const {
-        return {indexing_options | other.indexing_options, stored || other.stored};
+        text_field_option combined{indexing_options | other.indexing_options, stored || other.stored};
+        if (codec == postings_codec::Default) {
+            combined.codec = other.codec;
+        } else if (other.codec == postings_codec::Default || codec == other.codec) {
+            combined.codec = codec;
+        } else {
+            throw bridge_error("Cannot combine postings codecs");
+        }
+        return combined;
     }
 
     /**
@@ -290,6 +349,9 @@ namespace bridge::schema {
      */
     [[nodiscard]] serialization::json_t text_field_option::to_json() const {
         serialization::json_t text_field_json = {{"indexing", indexing_options.get_str()}, {"stored", is_stored()}};
+        if (codec != postings_codec::Default) {
+            text_field_json["codec"] = postings_codec_str(codec);
+        }
         return text_field_json;
     }
 
@@ -307,7 +369,11 @@ namespace bridge::schema {
         }
         text_indexing_option indexing_option = text_indexing_option::from_str(json.at("indexing"));
         bool stored = json.at("stored").get<bool>();
-        return {indexing_option, stored};
+        text_field_option options{indexing_option, stored};
+        if (json.find("codec") != json.end()) {
+            options.set_postings_codec(postings_codec_from_str(json.at("codec")));
+        }
+        return options;
     }
 
     /**
@@ -0,0 +1,254 @@
+// Copyright (c) 2021 Bridge Project (Marcos Pontes)
+
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to
+//  deal in the Software without restriction, including without limitation the
+//  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+//  sell copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+//  IN THE SOFTWARE.
+
+#include <algorithm>
+#include <queue>
+#include <tuple>
+
+#include "bridge/common/vint.hpp"
+#include "bridge/error.hpp"
+#include "bridge/suggest/completion.hpp"
+
+namespace bridge::suggest {
+
+    /**
+     * @brief Lower cases ASCII letters, the default normalizer.
+     */
+    std::string lowercase(std::string_view text) {
+        std::string lowered(text);
+        std::transform(lowered.begin(), lowered.end(), lowered.begin(),
+                       [](char c) { return (c >= 'A' && c <= 'Z') ? static_cast<char>(c - 'A' + 'a') : c; });
+        return lowered;
+    }
+
+    /**
+     * @brief Construct a new builder.
+     */
+    completion_builder::completion_builder(normalizer normalize) : normalize_(std::move(normalize)) {}
+
+    /**
+     * @brief Adds a completion.
+     */
+    void completion_builder::add(std::string_view input, std::string output, uint64_t weight) {
+        entries_.push_back({normalize_(input), std::move(output), weight});
+    }
+
+    /**
+     * @brief Builds the suggester.
+     */
+    completion_suggester completion_builder::build() {
+        std::sort(entries_.begin(), entries_.end(), [](const entry &a, const entry &b) {
+            return std::tie(a.key, b.weight, a.output) < std::tie(b.key, a.weight, b.output);
+        });
+
+        completion_suggester suggester;
+        suggester.normalize_ = normalize_;
+        suggester.outputs_.reserve(entries_.size());
+
+        // breadth-first, so that the children of a node are contiguous
+        struct pending {
+            uint32_t node;
+            size_t begin;
+            size_t end;
+            size_t depth;
+        };
+        std::queue<pending> queue;
+        suggester.nodes_.clear();
+        suggester.nodes_.push_back({0, 0, 0, 0, 0, '\0'});
+        queue.push({0, 0, entries_.size(), 0});
+        while (!queue.empty()) {
+            auto [index, begin, end, depth] = queue.front();
+            queue.pop();
+
+            // entries ending at this node come first in the sorted order
+            size_t i = begin;
+            suggester.nodes_[index].first_output = static_cast<uint32_t>(suggester.outputs_.size());
+            for (; i < end && entries_[i].key.size() == depth; i++) {
+                suggester.outputs_.push_back({std::move(entries_[i].output), entries_[i].weight});
+            }
+            suggester.nodes_[index].num_outputs =
+                static_cast<uint32_t>(suggester.outputs_.size()) - suggester.nodes_[index].first_output;
+
+            suggester.nodes_[index].first_child = static_cast<uint32_t>(suggester.nodes_.size());
+            while (i < end) {
+                char label = entries_[i].key[depth];
+                size_t group_end = i;
+                while (group_end < end && entries_[group_end].key[depth] == label) {
+                    group_end++;
+                }
+                auto child = static_cast<uint32_t>(suggester.nodes_.size());
+                suggester.nodes_.push_back({0, 0, 0, 0, 0, label});
+                queue.push({child, i, group_end, depth + 1});
+                i = group_end;
+            }
+            suggester.nodes_[index].num_children =
+                static_cast<uint32_t>(suggester.nodes_.size()) - suggester.nodes_[index].first_child;
+        }
+
+        suggester.compute_max_weights();
+        entries_.clear();
+        return suggester;
+    }
+
+    /**
+     * @brief Construct an empty suggester.
+     */
+    completion_suggester::completion_suggester() : normalize_(lowercase), nodes_{{1, 0, 0, 0, 0, '\0'}} {}
+
+    void completion_suggester::compute_max_weights() {
+        // children come after their parent, so a reverse scan sees them first
+        for (size_t i = nodes_.size(); i-- > 0;) {
+            node &n = nodes_[i];
+            n.max_weight = n.num_outputs > 0 ? outputs_[n.first_output].weight : 0;
+            for (uint32_t c = n.first_child; c < n.first_child + n.num_children; c++) {
+                n.max_weight = std::max(n.max_weight, nodes_[c].max_weight);
+            }
+        }
+    }
+
+    /**
+     * @brief Best completions of a prefix.
+     */
+    std::vector<suggestion> completion_suggester::top_k(std::string_view prefix, size_t k) const {
+        std::vector<suggestion> suggestions;
+        if (k == 0) {
+            return suggestions;
+        }
+
+        uint32_t current = 0;
+        for (char c : normalize_(prefix)) {
+            const node &parent = nodes_[current];
+            auto first = nodes_.begin() + parent.first_child;
+            auto last = first + parent.num_children;
+            // labels are sorted like std::string sorts its characters, as unsigned bytes
+            auto child = std::lower_bound(first, last, c, [](const node &n, char l) {
+                return static_cast<unsigned char>(n.label) < static_cast<unsigned char>(l);
+            });
+            if (child == last || child->label != c) {
+                return suggestions;
+            }
+            current = static_cast<uint32_t>(child - nodes_.begin());
+        }
+
+        // (bound, is_node, index): outputs pop before subtrees of the same weight
+        using candidate = std::tuple<uint64_t, bool, uint32_t>;
+        auto worse = [](const candidate &a, const candidate &b) {
+            if (std::get<0>(a) != std::get<0>(b)) {
+                return std::get<0>(a) < std::get<0>(b);
+            }
+            if (std::get<1>(a) != std::get<1>(b)) {
+                return std::get<1>(a);
+            }
+            return std::get<2>(a) > std::get<2>(b);
+        };
+        std::priority_queue<candidate, std::vector<candidate>, decltype(worse)> queue(worse);
+        queue.emplace(nodes_[current].max_weight, true, current);
+
+        while (!queue.empty() && suggestions.size() < k) {
+            auto [weight, is_node, index] = queue.top();
+            queue.pop();
+            if (!is_node) {
+                suggestions.push_back({outputs_[index].text, weight});
+                continue;
+            }
+            const node &n = nodes_[index];
+            for (uint32_t o = n.first_output; o < n.first_output + n.num_outputs; o++) {
+                queue.emplace(outputs_[o].weight, false, o);
+            }
+            for (uint32_t c = n.first_child; c < n.first_child + n.num_children; c++) {
+                queue.emplace(nodes_[c].max_weight, true, c);
+            }
+        }
+        return suggestions;
+    }
+
+    /**
+     * @brief Writes the suggester.
+     */
+    uint64_t completion_suggester::serialize(std::ostream &os) const {
+        std::vector<bridge::byte_t> buffer;
+        common::write_vint(buffer, nodes_.size());
+        for (const auto &n : nodes_) {
+            buffer.push_back(n.label);
+            common::write_vint(buffer, n.num_children);
+            common::write_vint(buffer, n.num_outputs);
+        }
+        for (const auto &o : outputs_) {
+            common::write_vint(buffer, o.weight);
+            common::write_vint(buffer, o.text.size());
+            buffer.insert(buffer.end(), o.text.begin(), o.text.end());
+        }
+        os.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+        return buffer.size();
+    }
+
+    /**
+     * @brief Reads a suggester.
+     */
+    completion_suggester completion_suggester::deserialize(const bridge::byte_t *&data, const bridge::byte_t *end,
+                                                           normalizer normalize) {
+        completion_suggester suggester;
+        suggester.normalize_ = std::move(normalize);
+
+        uint64_t num_nodes = common::read_vint(data, end);
+        if (num_nodes == 0 || num_nodes > static_cast<uint64_t>(end - data)) {
+            throw bridge_error("Corrupted completion suggester");
+        }
+        suggester.nodes_.resize(num_nodes);
+
+        // offsets are implied by the breadth-first order
+        uint64_t next_child = 1;
+        uint64_t next_output = 0;
+        for (auto &n : suggester.nodes_) {
+            if (data >= end) {
+                throw bridge_error("Corrupted completion suggester");
+            }
+            n.label = *data++;
+            uint64_t num_children = common::read_vint(data, end);
+            uint64_t num_outputs = common::read_vint(data, end);
+            if (next_child + num_children > num_nodes) {
+                throw bridge_error("Corrupted completion suggester");
+            }
+            n.first_child = static_cast<uint32_t>(next_child);
+            n.num_children = static_cast<uint32_t>(num_children);
+            n.first_output = static_cast<uint32_t>(next_output);
+            n.num_outputs = static_cast<uint32_t>(num_outputs);
+            next_child += num_children;
+            next_output += num_outputs;
+        }
+
+        if (next_output > static_cast<uint64_t>(end - data)) {
+            throw bridge_error("Corrupted completion suggester");
+        }
+        suggester.outputs_.resize(next_output);
+        for (auto &o : suggester.outputs_) {
+            o.weight = common::read_vint(data, end);
+            uint64_t length = common::read_vint(data, end);
+            if (length > static_cast<uint64_t>(end - data)) {
+                throw bridge_error("Corrupted completion suggester");
+            }
+            o.text.assign(data, length);
+            data += length;
+        }
+        suggester.compute_max_weights();
+        return suggester;
+    }
+
+} // namespace bridge::suggest
@@ -0,0 +1,217 @@
+// Copyright (c) 2021 Bridge Project (Marcos Pontes)
+
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to
+//  deal in the Software without restriction, including without limitation the
+//  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+//  sell copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+//  IN THE SOFTWARE.
+
+#include <algorithm>
+
+#include "bridge/error.hpp"
+#include "bridge/suggest/spelling.hpp"
+
+namespace bridge::suggest {
+
+    namespace {
+
+        /// @brief Smallest string greater than every string starting with prefix, empty if there is none.
+        std::string prefix_successor(std::string_view prefix) {
+            std::string successor(prefix);
+            while (!successor.empty() && static_cast<unsigned char>(successor.back()) == 0xFF) {
+                successor.pop_back();
+            }
+            if (!successor.empty()) {
+                successor.back() = static_cast<char>(static_cast<unsigned char>(successor.back()) + 1);
+            }
+            return successor;
+        }
+
+    } // namespace
+
+    /**
+     * @brief Construct a new automaton.
+     */
+    levenshtein_automaton::levenshtein_automaton(std::string_view query, uint8_t max_distance)
+        : query_(query), max_distance_(max_distance) {
+        if (max_distance_ > 254) {
+            throw bridge_error("Distance too large");
+        }
+    }
+
+    /**
+     * @brief State before any input.
+     */
+    levenshtein_automaton::state levenshtein_automaton::start() const {
+        state s(query_.size() + 1);
+        for (size_t i = 0; i < s.size(); i++) {
+            s[i] = static_cast<uint8_t>(std::min<size_t>(i, max_distance_ + 1));
+        }
+        return s;
+    }
+
+    /**
+     * @brief Consumes a byte.
+     */
+    void levenshtein_automaton::step(const state &from, char c, state &to) const {
+        // computed in int: a saturated cell of 255 plus one must not wrap to 0
+        int cap = max_distance_ + 1;
+        to.resize(from.size());
+        to[0] = static_cast<uint8_t>(std::min(from[0] + 1, cap));
+        for (size_t i = 1; i < from.size(); i++) {
+            int substitution = from[i - 1] + (query_[i - 1] == c ? 0 : 1);
+            int deletion = to[i - 1] + 1;
+            int insertion = from[i] + 1;
+            to[i] = static_cast<uint8_t>(std::min({substitution, deletion, insertion, cap}));
+        }
+    }
+
+    /**
+     * @brief Whether some continuation of the input read so far can still be accepted.
+     */
+    bool levenshtein_automaton::can_match(const state &s) const {
+        return *std::min_element(s.begin(), s.end()) <= max_distance_;
+    }
+
+    /**
+     * @brief Distance between the input read so far and the query, if it is accepted.
+     */
+    std::optional<uint8_t> levenshtein_automaton::distance(const state &s) const {
+        if (s.back() <= max_distance_) {
+            return s.back();
+        }
+        return std::nullopt;
+    }
+
+    /**
+     * @brief Finds the terms of a dictionary within a Levenshtein distance of a term.
+     */
+    std::vector<correction> fuzzy_terms(const postings::term_dictionary &dictionary, std::string_view term,
+                                        uint8_t max_distance) {
+        levenshtein_automaton automaton(term, max_distance);
+        std::vector<levenshtein_automaton::state> states{automaton.start()};
+        std::string_view previous;
+        std::vector<correction> found;
+
+        uint32_t ordinal = 0;
+        while (ordinal < dictionary.size()) {
+            std::string_view current = dictionary.term(ordinal);
+
+            // states of the prefix shared with the previous term are still valid
+            size_t depth = 0;
+            size_t valid = std::min(states.size() - 1, std::min(previous.size(), current.size()));
+            while (depth < valid && previous[depth] == current[depth]) {
+                depth++;
+            }
+            states.resize(depth + 1);
+
+            bool dead = false;
+            for (; depth < current.size(); depth++) {
+                states.emplace_back();
+                automaton.step(states[depth], current[depth], states[depth + 1]);
+                if (!automaton.can_match(states[depth + 1])) {
+                    dead = true;
+                    break;
+                }
+            }
+            previous = current;
+
+            if (dead) {
+                // no term starting with this prefix can match
+                std::string successor = prefix_successor(current.substr(0, depth + 1));
+                uint32_t next = successor.empty() ? dictionary.size() : dictionary.lower_bound(successor);
+                states.pop_back();
+                ordinal = std::max(next, ordinal + 1);
+                continue;
+            }
+            if (auto distance = automaton.distance(states.back())) {
+                found.push_back({std::string(current), *distance, dictionary.doc_freq(ordinal)});
+            }
+            ordinal++;
+        }
+
+        std::sort(found.begin(), found.end(), [](const correction &a, const correction &b) {
+            if (a.distance != b.distance) {
+                return a.distance < b.distance;
+            }
+            if (a.doc_freq != b.doc_freq) {
+                return a.doc_freq > b.doc_freq;
+            }
+            return a.term < b.term;
+        });
+        return found;
+    }
+
+    /**
+     * @brief Construct a new spell checker.
+     */
+    spell_checker::spell_checker(const postings::term_dictionary &dictionary, uint8_t max_distance)
+        : dictionary_(&dictionary), max_distance_(max_distance) {
+        if (max_distance_ == 0 || max_distance_ > 2) {
+            throw bridge_error("The spell checker supports 1 or 2 edits");
+        }
+    }
+
+    uint8_t spell_checker::distance_for(std::string_view term) const {
+        if (term.size() <= 2) {
+            return 0;
+        }
+        return term.size() <= 5 ? 1 : max_distance_;
+    }
+
+    /**
+     * @brief Best corrections of a term, the term itself excluded.
+     */
+    std::vector<correction> spell_checker::candidates(std::string_view term, size_t max_candidates) const {
+        uint8_t distance = distance_for(term);
+        if (distance == 0) {
+            return {};
+        }
+        std::vector<correction> found = fuzzy_terms(*dictionary_, term, distance);
+        std::erase_if(found, [](const correction &c) { return c.distance == 0 || c.doc_freq == 0; });
+        if (found.size() > max_candidates) {
+            found.resize(max_candidates);
+        }
+        return found;
+    }
+
+    /**
+     * @brief Rewrites a query by replacing each unknown term by its best correction.
+     */
+    std::optional<std::vector<std::string>> spell_checker::did_you_mean(const std::vector<std::string> &terms) const {
+        std::vector<std::string> rewritten;
+        rewritten.reserve(terms.size());
+        bool changed = false;
+        for (const auto &term : terms) {
+            auto ordinal = dictionary_->ordinal(term);
+            if (ordinal && dictionary_->doc_freq(*ordinal) > 0) {
+                rewritten.push_back(term);
+                continue;
+            }
+            std::vector<correction> best = candidates(term, 1);
+            if (best.empty()) {
+                rewritten.push_back(term);
+            } else {
+                rewritten.push_back(best[0].term);
+                changed = true;
+            }
+        }
+        if (!changed) {
+            return std::nullopt;
+        }
+        return rewritten;
+    }
+
+} // namespace bridge::suggest
@@ -0,0 +1,148 @@
+// Copyright (c) 2021 Bridge Project (Marcos Pontes)
+
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to
+//  deal in the Software without restriction, including without limitation the
+//  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+//  sell copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+//  IN THE SOFTWARE.
+
+#include <sstream>
+
+#include <gtest/gtest.h>
+
+#include "bridge/bridge.hpp"
+#include "fixed_scorer.hpp"
+
+namespace {
+
+    using bridge::postings::TERMINATED;
+    using bridge::testing::fixed_scorer;
+
+    /// @brief Blocks [0, 1 | 2], [| 3], [4, 5, 6 | 7] and [8 | 9], parents after the bar.
+    bridge::postings::bit_set product_blocks() {
+        bridge::index::nested_block_writer writer;
+        bridge::schema::document doc;
+        EXPECT_EQ(writer.add_block({doc, doc}, doc), 2U);
+        EXPECT_EQ(writer.add_block({}, doc), 3U);
+        EXPECT_EQ(writer.add_block({doc, doc, doc}, doc), 7U);
+        EXPECT_EQ(writer.add_block({doc}, doc), 9U);
+        EXPECT_EQ(writer.num_docs(), 10U);
+        return writer.parents();
+    }
+
+} // namespace
+
+TEST(BitSetTest, NextAndPrevious) {
+    bridge::postings::bit_set set(200);
+    for (bridge::DocId doc : {3U, 64U, 130U, 199U}) {
+        set.insert(doc);
+    }
+    ASSERT_EQ(set.count(), 4U);
+    ASSERT_TRUE(set.contains(64));
+    ASSERT_FALSE(set.contains(65));
+    ASSERT_FALSE(set.contains(500));
+
+    ASSERT_EQ(set.next_set_bit(0), 3U);
+    ASSERT_EQ(set.next_set_bit(4), 64U);
+    ASSERT_EQ(set.next_set_bit(65), 130U);
+    ASSERT_EQ(set.next_set_bit(199), 199U);
+    ASSERT_EQ(set.next_set_bit(200), TERMINATED);
+    ASSERT_EQ(set.prev_set_bit(2), TERMINATED);
+    ASSERT_EQ(set.prev_set_bit(63), 3U);
+    ASSERT_EQ(set.prev_set_bit(129), 64U);
+    ASSERT_EQ(set.prev_set_bit(1000), 199U);
+    ASSERT_THROW(set.insert(200), bridge::bridge_error);
+
+    bridge::postings::bit_set_cursor cursor(set);
+    ASSERT_EQ(cursor.doc(), 3U);
+    ASSERT_EQ(cursor.seek(100), 130U);
+    ASSERT_EQ(cursor.advance(), 199U);
+    ASSERT_EQ(cursor.advance(), TERMINATED);
+
+    std::stringstream stream;
+    uint64_t size = set.serialize(stream);
+    std::string bytes = stream.str();
+    ASSERT_EQ(bytes.size(), size);
+    const bridge::byte_t *data = bytes.data();
+    auto copy = bridge::postings::bit_set::deserialize(data, bytes.data() + bytes.size());
+    ASSERT_EQ(data, bytes.data() + bytes.size());
+    ASSERT_EQ(copy.num_bits(), 200U);
+    for (bridge::DocId doc = 0; doc < 200; doc++) {
+        ASSERT_EQ(copy.contains(doc), set.contains(doc));
+    }
+}
+
+TEST(BlockJoinTest, ToParent) {
+    using namespace bridge::query;
+    auto parents = product_blocks();
+    auto children = [] {
+        return std::make_unique<fixed_scorer>(std::vector<std::pair<bridge::DocId, bridge::Score>>{
+            {1, 1.0F}, {4, 2.0F}, {6, 4.0F}, {8, 3.0F}});
+    };
+
+    to_parent_scorer avg(children(), parents);
+    ASSERT_EQ(avg.doc(), 2U);
+    ASSERT_FLOAT_EQ(avg.score(), 1.0F);
+    ASSERT_EQ(avg.advance(), 7U);
+    ASSERT_FLOAT_EQ(avg.score(), 3.0F);
+    ASSERT_EQ(avg.num_children(), 2U);
+    ASSERT_EQ(avg.advance(), 9U);
+    ASSERT_EQ(avg.advance(), TERMINATED);
+    ASSERT_EQ(avg.advance(), TERMINATED);
+
+    to_parent_scorer max(children(), parents, block_join_score_mode::Max);
+    ASSERT_EQ(max.seek(3), 7U);
+    ASSERT_FLOAT_EQ(max.score(), 4.0F);
+    ASSERT_EQ(max.seek(5), 7U);
+    ASSERT_EQ(max.seek(8), 9U);
+    ASSERT_FLOAT_EQ(max.score(), 3.0F);
+
+    to_parent_scorer total(children(), parents, block_join_score_mode::Total);
+    ASSERT_EQ(total.seek(4), 7U);
+    ASSERT_FLOAT_EQ(total.score(), 6.0F);
+
+    auto matches_parent =
+        std::make_unique<fixed_scorer>(std::vector<std::pair<bridge::DocId, bridge::Score>>{{3, 1.0F}});
+    ASSERT_THROW(to_parent_scorer(std::move(matches_parent), parents), bridge::bridge_error);
+}
+
+TEST(BlockJoinTest, ToChild) {
+    using namespace bridge::query;
+    auto parents = product_blocks();
+    auto products = [] {
+        return std::make_unique<fixed_scorer>(
+            std::vector<std::pair<bridge::DocId, bridge::Score>>{{2, 1.5F}, {3, 0.5F}, {7, 2.0F}});
+    };
+
+    to_child_scorer variants(products(), parents);
+    std::vector<std::pair<bridge::DocId, bridge::Score>> hits;
+    for (bridge::DocId doc = variants.doc(); doc != TERMINATED; doc = variants.advance()) {
+        hits.emplace_back(doc, variants.score());
+    }
+    std::vector<std::pair<bridge::DocId, bridge::Score>> expected = {
+        {0, 1.5F}, {1, 1.5F}, {4, 2.0F}, {5, 2.0F}, {6, 2.0F}};
+    ASSERT_EQ(hits, expected);
+
+    to_child_scorer seeking(products(), parents);
+    ASSERT_EQ(seeking.seek(1), 1U);
+    ASSERT_EQ(seeking.seek(2), 4U);
+    ASSERT_EQ(seeking.seek(5), 5U);
+    ASSERT_FLOAT_EQ(seeking.score(), 2.0F);
+    ASSERT_EQ(seeking.seek(7), TERMINATED);
+
+    auto matches_child =
+        std::make_unique<fixed_scorer>(std::vector<std::pair<bridge::DocId, bridge::Score>>{{4, 1.0F}});
+    ASSERT_THROW(to_child_scorer(std::move(matches_child), parents), bridge::bridge_error);
+}
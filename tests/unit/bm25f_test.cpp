@@ -0,0 +1,132 @@
+// Copyright (c) 2021 Bridge Project (Marcos Pontes)
+
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to
+//  deal in the Software without restriction, including without limitation the
+//  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+//  sell copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+//  IN THE SOFTWARE.
+
+#include <gtest/gtest.h>
+
+#include "bridge/bridge.hpp"
+
+namespace {
+
+    std::unique_ptr<bridge::postings::postings_cursor> postings(std::vector<std::pair<bridge::DocId, uint32_t>> p) {
+        return std::make_unique<bridge::postings::vec_postings>(std::move(p));
+    }
+
+} // namespace
+
+TEST(Bm25fTest, VecPostings) {
+    using namespace bridge::postings;
+
+    vec_postings cursor({{1, 2}, {4, 1}, {9, 3}});
+    ASSERT_EQ(cursor.doc(), 1);
+    ASSERT_EQ(cursor.term_freq(), 2);
+    ASSERT_EQ(cursor.seek(5), 9);
+    ASSERT_EQ(cursor.term_freq(), 3);
+    ASSERT_EQ(cursor.seek(2), 9);
+    ASSERT_EQ(cursor.advance(), TERMINATED);
+    ASSERT_EQ(cursor.advance(), TERMINATED);
+    ASSERT_THROW(vec_postings({{2, 1}, {2, 1}}), bridge::bridge_error);
+}
+
+TEST(Bm25fTest, SingleFieldIsBm25) {
+    using namespace bridge::query;
+
+    std::vector<uint32_t> norms = {10, 3, 7, 20};
+    std::vector<bm25f_term> terms;
+    terms.emplace_back();
+    terms[0].idf = bridge::scoring::idf(3, 4);
+    terms[0].postings.push_back(postings({{0, 1}, {2, 4}, {3, 2}}));
+
+    bm25f_scorer scorer({{1.0F, &norms, 10.0F}}, std::move(terms));
+    bridge::scoring::bm25_weight bm25(3, 4, 10.0F);
+    ASSERT_EQ(scorer.doc(), 0);
+    ASSERT_FLOAT_EQ(scorer.score(), bm25.score(1, 10));
+    ASSERT_EQ(scorer.advance(), 2);
+    ASSERT_FLOAT_EQ(scorer.score(), bm25.score(4, 7));
+    ASSERT_EQ(scorer.advance(), 3);
+    ASSERT_FLOAT_EQ(scorer.score(), bm25.score(2, 20));
+    ASSERT_EQ(scorer.advance(), bridge::postings::TERMINATED);
+}
+
+TEST(Bm25fTest, CombinesFields) {
+    using namespace bridge::query;
+
+    std::vector<uint32_t> title_norms = {4, 2, 8, 4, 4};
+    std::vector<uint32_t> body_norms = {100, 50, 200, 100, 100};
+    bridge::Score k1 = bridge::scoring::default_k1;
+    bridge::Score b = bridge::scoring::default_b;
+
+    std::vector<bm25f_term> terms(2);
+    terms[0].idf = 1.5F;
+    terms[0].postings.push_back(postings({{1, 1}, {3, 1}}));         // title
+    terms[0].postings.push_back(postings({{0, 2}, {1, 5}, {4, 1}})); // body
+    terms[1].idf = 0.5F;
+    terms[1].postings.push_back(nullptr);
+    terms[1].postings.push_back(postings({{1, 3}, {3, 1}}));
+
+    bm25f_scorer scorer({{3.0F, &title_norms, 4.0F}, {1.0F, &body_norms, 100.0F}}, std::move(terms));
+    ASSERT_EQ(scorer.size_hint(), 3);
+
+    auto expected = [&](bridge::DocId doc, std::vector<std::pair<float, float>> freqs) {
+        std::vector<float> idfs = {1.5F, 0.5F};
+        float score = 0.0F;
+        for (size_t t = 0; t < freqs.size(); t++) {
+            float tf = 3.0F * freqs[t].first / (1.0F - b + b * static_cast<float>(title_norms[doc]) / 4.0F) +
+                       freqs[t].second / (1.0F - b + b * static_cast<float>(body_norms[doc]) / 100.0F);
+            score += idfs[t] * (k1 + 1.0F) * tf / (k1 + tf);
+        }
+        return score;
+    };
+
+    std::vector<bridge::DocId> docs;
+    std::vector<bridge::Score> scores;
+    for (bridge::DocId doc = scorer.doc(); doc != bridge::postings::TERMINATED; doc = scorer.advance()) {
+        docs.push_back(doc);
+        scores.push_back(scorer.score());
+    }
+    ASSERT_EQ(docs, (std::vector<bridge::DocId>{0, 1, 3, 4}));
+    ASSERT_FLOAT_EQ(scores[0], expected(0, {{0, 2}, {0, 0}}));
+    ASSERT_FLOAT_EQ(scores[1], expected(1, {{1, 5}, {0, 3}}));
+    ASSERT_FLOAT_EQ(scores[2], expected(3, {{1, 0}, {0, 1}}));
+    ASSERT_FLOAT_EQ(scores[3], expected(4, {{0, 1}, {0, 0}}));
+
+    // a title match is worth more than the same match in the body
+    ASSERT_GT(scores[2], expected(3, {{0, 1}, {0, 1}}));
+}
+
+TEST(Bm25fTest, Seek) {
+    using namespace bridge::query;
+
+    std::vector<uint32_t> norms(100, 5);
+    std::vector<bm25f_term> terms(1);
+    terms[0].idf = 1.0F;
+    terms[0].postings.push_back(postings({{3, 1}, {50, 1}, {70, 1}}));
+    terms[0].postings.push_back(postings({{10, 1}, {60, 2}}));
+
+    bm25f_scorer scorer({{2.0F, &norms, 5.0F}, {1.0F, &norms, 5.0F}}, std::move(terms));
+    ASSERT_EQ(scorer.seek(55), 60);
+    ASSERT_EQ(scorer.seek(10), 60);
+    ASSERT_EQ(scorer.advance(), 70);
+    ASSERT_EQ(scorer.seek(71), bridge::postings::TERMINATED);
+    ASSERT_FLOAT_EQ(scorer.score(), 0.0F);
+
+    std::vector<bm25f_term> bad(1);
+    bad[0].postings.push_back(nullptr);
+    ASSERT_THROW(bm25f_scorer({{1.0F, &norms, 5.0F}, {1.0F, &norms, 5.0F}}, std::move(bad)), bridge::bridge_error);
+}
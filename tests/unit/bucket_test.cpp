@@ -0,0 +1,130 @@
+// Copyright (c) 2021 Bridge Project (Marcos Pontes)
+
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to
+//  deal in the Software without restriction, including without limitation the
+//  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+//  sell copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+//  IN THE SOFTWARE.
+
+#include <random>
+
+#include <gtest/gtest.h>
+
+#include "bridge/bridge.hpp"
+
+TEST(BucketTest, Ranges) {
+    using namespace bridge::aggregation;
+
+    std::mt19937 rng(4);
+    std::vector<double> prices(10000);
+    for (auto &price : prices) {
+        price = static_cast<double>(rng() % 100000) / 100.0;
+    }
+    prices[0] = -std::numeric_limits<double>::infinity();
+    prices[1] = std::numeric_limits<double>::infinity();
+    auto column = bridge::fastfield::numeric_column::build(prices);
+
+    std::vector<range_bucket> ranges = {{"cheap", std::nullopt, 10.0},
+                                        {"10-50", 10.0, 50.0},
+                                        {"50-100", 50.0, 100.0},
+                                        {"100-200", 100.0, 200.0},
+                                        {"200-500", 200.0, 500.0},
+                                        {"500+", 500.0, std::nullopt},
+                                        {"overlap", 40.0, 150.0},
+                                        {"empty", 7.0, 7.0},
+                                        {"all", std::nullopt, std::nullopt}};
+    range_collector collector(column, ranges);
+    range_collector second(column, ranges);
+    for (bridge::DocId doc = 0; doc < prices.size(); doc++) {
+        if (doc % 2 == 0) {
+            collector.collect(doc, 1.0F);
+        } else {
+            second.collect_block(&doc, 1);
+        }
+    }
+    collector.merge(second);
+
+    auto buckets = collector.buckets();
+    ASSERT_EQ(buckets.size(), ranges.size());
+    for (size_t r = 0; r < ranges.size(); r++) {
+        uint64_t expected = std::count_if(prices.begin(), prices.end(), [&](double price) {
+            return (!ranges[r].from || price >= *ranges[r].from) && (!ranges[r].to || price < *ranges[r].to);
+        });
+        ASSERT_EQ(buckets[r].key, ranges[r].key);
+        ASSERT_EQ(buckets[r].doc_count, expected) << ranges[r].key;
+    }
+    ASSERT_EQ(buckets.back().doc_count, prices.size());
+
+    ASSERT_THROW(range_collector(column, {{"nan", std::numeric_limits<double>::quiet_NaN(), 1.0}}),
+                 bridge::bridge_error);
+    range_collector other(column, {{"x", 1.0, 2.0}});
+    ASSERT_THROW(collector.merge(other), bridge::bridge_error);
+}
+
+TEST(BucketTest, IntegerRanges) {
+    using namespace bridge::aggregation;
+
+    auto stock = bridge::fastfield::numeric_column::build(std::vector<int64_t>{-3, 0, 1, 2, 5, 9, 10});
+    range_collector collector(stock, {{"negative", std::nullopt, 0.0}, {"low", 0.5, 2.5}, {"high", 5.0, 1e30}});
+    for (bridge::DocId doc = 0; doc < stock.num_docs(); doc++) {
+        collector.collect(doc, 1.0F);
+    }
+    auto buckets = collector.buckets();
+    ASSERT_EQ(buckets[0].doc_count, 1);
+    ASSERT_EQ(buckets[1].doc_count, 2);
+    ASSERT_EQ(buckets[2].doc_count, 3);
+
+    auto ids = bridge::fastfield::numeric_column::build(std::vector<uint64_t>{0, 7, ~0ULL});
+    range_collector unsigned_collector(ids, {{"small", -5.0, 7.0}, {"rest", 7.0, std::nullopt}});
+    for (bridge::DocId doc = 0; doc < ids.num_docs(); doc++) {
+        unsigned_collector.collect(doc, 1.0F);
+    }
+    ASSERT_EQ(unsigned_collector.buckets()[0].doc_count, 1);
+    ASSERT_EQ(unsigned_collector.buckets()[1].doc_count, 2);
+}
+
+TEST(BucketTest, Filters) {
+    using namespace bridge::aggregation;
+
+    auto make = [](std::vector<bridge::DocId> docs) {
+        std::vector<std::pair<bridge::DocId, uint32_t>> postings;
+        for (auto doc : docs) {
+            postings.emplace_back(doc, 1);
+        }
+        return std::make_unique<bridge::postings::vec_postings>(std::move(postings));
+    };
+    auto build = [&]() {
+        std::vector<named_filter> filters;
+        filters.push_back({"in_stock", make({1, 2, 3, 8, 9})});
+        filters.push_back({"on_sale", make({0, 3, 4, 9, 12})});
+        return filters_collector(std::move(filters), "other");
+    };
+
+    filters_collector collector = build();
+    for (bridge::DocId doc : {0, 3, 5, 7, 8, 12}) {
+        collector.collect(doc, 1.0F);
+    }
+    auto buckets = collector.buckets();
+    ASSERT_EQ(buckets, (std::vector<filter_bucket>{{"in_stock", 2}, {"on_sale", 3}, {"other", 2}}));
+
+    filters_collector segment = build();
+    segment.collect(9, 1.0F);
+    merge_buckets(buckets, segment.buckets());
+    ASSERT_EQ(buckets, (std::vector<filter_bucket>{{"in_stock", 3}, {"on_sale", 4}, {"other", 2}}));
+    ASSERT_THROW(merge_buckets(buckets, {{"in_stock", 1}}), bridge::bridge_error);
+
+    std::vector<named_filter> missing(1);
+    ASSERT_THROW(filters_collector(std::move(missing)), bridge::bridge_error);
+}
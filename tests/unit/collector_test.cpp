@@ -0,0 +1,164 @@
+// Copyright (c) 2021 Bridge Project (Marcos Pontes)
+
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to
+//  deal in the Software without restriction, including without limitation the
+//  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+//  sell copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+//  IN THE SOFTWARE.
+
+#include <algorithm>
+#include <map>
+#include <random>
+
+#include <gtest/gtest.h>
+
+#include "bridge/bridge.hpp"
+
+TEST(CollectorTest, TopDocs) {
+    using namespace bridge::collector;
+
+    top_docs_collector collector(3);
+    std::vector<float> scores = {1.0F, 5.0F, 3.0F, 5.0F, 0.5F, 4.0F};
+    for (bridge::DocId doc = 0; doc < scores.size(); doc++) {
+        collector.collect(doc, scores[doc]);
+    }
+    ASSERT_EQ(collector.hits(), (std::vector<hit>{{1, 5.0F}, {3, 5.0F}, {5, 4.0F}}));
+
+    top_docs_collector empty(0);
+    empty.collect(0, 1.0F);
+    ASSERT_TRUE(empty.hits().empty());
+}
+
+TEST(CollectorTest, SearchAfter) {
+    using namespace bridge::collector;
+
+    std::mt19937 rng(23);
+    std::vector<float> scores(1000);
+    std::vector<int64_t> prices(scores.size());
+    for (size_t doc = 0; doc < scores.size(); doc++) {
+        scores[doc] = static_cast<float>(rng() % 50);
+        prices[doc] = static_cast<int64_t>(rng() % 200) - 100;
+    }
+    auto price_column = bridge::fastfield::numeric_column::build(prices);
+
+    // paging by score
+    top_docs_collector all(scores.size());
+    for (bridge::DocId doc = 0; doc < scores.size(); doc++) {
+        all.collect(doc, scores[doc]);
+    }
+    std::vector<hit> paged;
+    std::optional<hit> after;
+    while (true) {
+        top_docs_collector page(64, after);
+        for (bridge::DocId doc = 0; doc < scores.size(); doc++) {
+            page.collect(doc, scores[doc]);
+        }
+        std::vector<hit> hits = page.hits();
+        if (hits.empty()) {
+            break;
+        }
+        paged.insert(paged.end(), hits.begin(), hits.end());
+        after = hits.back();
+    }
+    ASSERT_EQ(paged, all.hits());
+
+    // paging by a fast field, both directions
+    for (sort_order order : {sort_order::Ascending, sort_order::Descending}) {
+        top_field_collector everything(scores.size(), price_column, order);
+        std::vector<field_hit> field_paged;
+        std::optional<field_hit> field_after;
+        for (bridge::DocId doc = 0; doc < scores.size(); doc++) {
+            everything.collect(doc, scores[doc]);
+        }
+        while (true) {
+            top_field_collector page(100, price_column, order, field_after);
+            for (bridge::DocId doc = 0; doc < scores.size(); doc++) {
+                page.collect(doc, scores[doc]);
+            }
+            std::vector<field_hit> hits = page.hits();
+            if (hits.empty()) {
+                break;
+            }
+            field_paged.insert(field_paged.end(), hits.begin(), hits.end());
+            field_after = hits.back();
+        }
+        std::vector<field_hit> expected = everything.hits();
+        ASSERT_EQ(field_paged, expected);
+        int64_t first = bridge::fastfield::i64_from_sortable(expected.front().value);
+        int64_t last = bridge::fastfield::i64_from_sortable(expected.back().value);
+        ASSERT_EQ(order == sort_order::Ascending, first < last);
+    }
+}
+
+TEST(CollectorTest, CollapseMatchesBruteForce) {
+    using namespace bridge::collector;
+
+    std::mt19937 rng(17);
+    for (uint64_t num_groups : {1ULL, 5ULL, 50ULL, 5000ULL}) {
+        std::vector<uint64_t> group_of(5000);
+        std::vector<float> scores(group_of.size());
+        for (size_t doc = 0; doc < group_of.size(); doc++) {
+            group_of[doc] = rng() % num_groups;
+            scores[doc] = static_cast<float>(rng() % 1000); // plenty of ties
+        }
+        auto column = bridge::fastfield::numeric_column::build(group_of);
+
+        for (size_t k : {1U, 10U, 100U}) {
+            collapsing_collector collector(k, column);
+            std::map<uint64_t, group_hit> best;
+            for (bridge::DocId doc = 0; doc < group_of.size(); doc++) {
+                collector.collect(doc, scores[doc]);
+                auto [it, inserted] = best.try_emplace(group_of[doc], group_hit{doc, scores[doc], group_of[doc]});
+                if (!inserted && scores[doc] > it->second.score) {
+                    it->second = {doc, scores[doc], group_of[doc]};
+                }
+            }
+
+            std::vector<group_hit> expected;
+            for (const auto &[group, h] : best) {
+                expected.push_back(h);
+            }
+            std::sort(expected.begin(), expected.end(), [](const group_hit &a, const group_hit &b) {
+                return ranks_before({a.doc, a.score}, {b.doc, b.score});
+            });
+            expected.resize(std::min(k, expected.size()));
+            ASSERT_EQ(collector.hits(), expected);
+        }
+    }
+}
+
+TEST(CollectorTest, CollapseScorer) {
+    using namespace bridge::collector;
+
+    // products 7 and 9 have several variants, the best variant of product 7 comes last
+    auto products = bridge::fastfield::numeric_column::build(std::vector<uint64_t>{7, 9, 7, 3, 9, 7});
+    std::vector<uint32_t> norms(6, 1);
+    std::vector<bridge::query::bm25f_term> terms(1);
+    terms[0].idf = 1.0F;
+    terms[0].postings.push_back(std::make_unique<bridge::postings::vec_postings>(
+        std::vector<std::pair<bridge::DocId, uint32_t>>{{0, 1}, {1, 4}, {2, 2}, {3, 1}, {4, 3}, {5, 6}}));
+    bridge::query::bm25f_scorer scorer({{1.0F, &norms, 1.0F}}, std::move(terms));
+
+    collapsing_collector collector(2, products);
+    collect_all(scorer, collector);
+    std::vector<group_hit> hits = collector.hits();
+    ASSERT_EQ(hits.size(), 2);
+    ASSERT_EQ(hits[0].doc, 5);
+    ASSERT_EQ(hits[0].group, 7);
+    ASSERT_EQ(hits[1].doc, 1);
+    ASSERT_EQ(hits[1].group, 9);
+
+    ASSERT_THROW(collector.collect(6, 1.0F), bridge::bridge_error);
+}
@@ -0,0 +1,105 @@
+// Copyright (c) 2021 Bridge Project (Marcos Pontes)
+
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to
+//  deal in the Software without restriction, including without limitation the
+//  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+//  sell copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+//  IN THE SOFTWARE.
+
+#include <algorithm>
+#include <random>
+
+#include <gtest/gtest.h>
+
+#include "bridge/bridge.hpp"
+
+TEST(CompletionTest, TopK) {
+    using namespace bridge::suggest;
+
+    completion_builder builder;
+    builder.add("New York", 100);
+    builder.add("new york times", 80);
+    builder.add("Newark", 60);
+    builder.add("news", 90);
+    builder.add("nyc", "New York", 70);
+    builder.add("boston", 50);
+    builder.add("ny", "New York", 70);
+    completion_suggester suggester = builder.build();
+    ASSERT_EQ(suggester.size(), 7);
+
+    std::vector<suggestion> expected = {{"New York", 100}, {"news", 90}, {"new york times", 80}};
+    ASSERT_EQ(suggester.top_k("NEW", 3), expected);
+    expected = {{"New York", 100}, {"new york times", 80}};
+    ASSERT_EQ(suggester.top_k("new y", 10), expected);
+    expected = {{"New York", 70}, {"New York", 70}};
+    ASSERT_EQ(suggester.top_k("ny", 10), expected);
+    ASSERT_EQ(suggester.top_k("", 1), (std::vector<suggestion>{{"New York", 100}}));
+    ASSERT_TRUE(suggester.top_k("chicago", 5).empty());
+    ASSERT_TRUE(suggester.top_k("new", 0).empty());
+    ASSERT_TRUE(completion_suggester().top_k("a", 3).empty());
+}
+
+TEST(CompletionTest, MatchesBruteForce) {
+    using namespace bridge::suggest;
+
+    std::mt19937 rng(11);
+    std::uniform_int_distribution<int> letter('a', 'e');
+    std::uniform_int_distribution<size_t> length(1, 8);
+    std::uniform_int_distribution<uint64_t> weight(0, 1000000);
+
+    completion_builder builder;
+    std::vector<suggestion> all;
+    for (int i = 0; i < 2000; i++) {
+        std::string word(length(rng), ' ');
+        std::generate(word.begin(), word.end(), [&]() { return static_cast<char>(letter(rng)); });
+        uint64_t w = weight(rng);
+        builder.add(word, w);
+        all.push_back({word, w});
+    }
+    completion_suggester suggester = builder.build();
+
+    std::vector<bridge::byte_t> buffer;
+    {
+        bridge::directory::ArrayWriter out{bridge::directory::ArrayDevice(buffer)};
+        suggester.serialize(out);
+    }
+    const bridge::byte_t *data = buffer.data();
+    completion_suggester read = completion_suggester::deserialize(data, buffer.data() + buffer.size());
+    ASSERT_EQ(data, buffer.data() + buffer.size());
+
+    for (std::string prefix : {"", "a", "ab", "eee", "cad", "bbbb"}) {
+        std::vector<uint64_t> expected;
+        for (const auto &s : all) {
+            if (s.text.starts_with(prefix)) {
+                expected.push_back(s.weight);
+            }
+        }
+        std::sort(expected.rbegin(), expected.rend());
+        expected.resize(std::min<size_t>(expected.size(), 10));
+
+        for (const completion_suggester *s : {&suggester, &read}) {
+            std::vector<suggestion> top = s->top_k(prefix, 10);
+            ASSERT_EQ(top.size(), expected.size());
+            for (size_t i = 0; i < top.size(); i++) {
+                ASSERT_EQ(top[i].weight, expected[i]);
+                ASSERT_TRUE(top[i].text.starts_with(prefix));
+            }
+        }
+    }
+
+    std::vector<bridge::byte_t> truncated(buffer.begin(), buffer.begin() + static_cast<long>(buffer.size() / 2));
+    data = truncated.data();
+    ASSERT_THROW(completion_suggester::deserialize(data, data + truncated.size()), bridge::bridge_error);
+}
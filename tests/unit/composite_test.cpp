@@ -0,0 +1,118 @@
+// Copyright (c) 2021 Bridge Project (Marcos Pontes)
+
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to
+//  deal in the Software without restriction, including without limitation the
+//  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+//  sell copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+//  IN THE SOFTWARE.
+
+#include <functional>
+#include <map>
+#include <random>
+#include <tuple>
+
+#include <gtest/gtest.h>
+
+#include "bridge/bridge.hpp"
+
+namespace {
+
+    struct segment {
+        bridge::fastfield::numeric_column tenant;
+        bridge::fastfield::numeric_column day;
+        bridge::fastfield::numeric_column status;
+    };
+
+} // namespace
+
+TEST(CompositeTest, Paging) {
+    using namespace bridge::aggregation;
+    using bridge::collector::sort_order;
+
+    std::mt19937 rng(21);
+    std::vector<segment> segments;
+    std::map<std::vector<uint64_t>, uint64_t, std::function<bool(const composite_key &, const composite_key &)>>
+        expected([](const composite_key &a, const composite_key &b) {
+            // tenant and day ascending, status descending
+            if (a[0] != b[0] || a[1] != b[1]) {
+                return std::tie(a[0], a[1]) < std::tie(b[0], b[1]);
+            }
+            return a[2] > b[2];
+        });
+    for (size_t s = 0; s < 3; s++) {
+        std::vector<uint64_t> tenants(2000);
+        std::vector<int64_t> days(2000);
+        std::vector<uint64_t> statuses(2000);
+        for (size_t doc = 0; doc < tenants.size(); doc++) {
+            tenants[doc] = rng() % 10;
+            days[doc] = 19000 + static_cast<int64_t>(rng() % 5);
+            statuses[doc] = std::vector<uint64_t>{200, 404, 500}[rng() % 3];
+            if (doc % 3 != 0) { // matching documents
+                expected[{tenants[doc], bridge::fastfield::to_sortable(days[doc]), statuses[doc]}]++;
+            }
+        }
+        segments.push_back({bridge::fastfield::numeric_column::build(tenants),
+                            bridge::fastfield::numeric_column::build(days),
+                            bridge::fastfield::numeric_column::build(statuses)});
+    }
+
+    const size_t size = 7;
+    std::vector<composite_bucket> all;
+    std::optional<composite_key> after;
+    do {
+        std::vector<std::vector<composite_bucket>> pages;
+        std::vector<composite_source> sources;
+        for (const auto &segment : segments) {
+            sources = {{&segment.tenant}, {&segment.day}, {&segment.status, sort_order::Descending}};
+            composite_collector collector(sources, size, after);
+            for (bridge::DocId doc = 0; doc < segment.tenant.num_docs(); doc++) {
+                if (doc % 3 != 0) {
+                    collector.collect(doc, 1.0F);
+                }
+            }
+            pages.push_back(collector.buckets());
+            ASSERT_LE(pages.back().size(), size);
+        }
+        auto page = merge_composite_pages(pages, sources, size);
+        all.insert(all.end(), page.begin(), page.end());
+        after = next_after_key(page, size);
+    } while (after);
+
+    ASSERT_EQ(all.size(), expected.size());
+    size_t i = 0;
+    for (const auto &[key, count] : expected) {
+        ASSERT_EQ(all[i].key, key);
+        ASSERT_EQ(all[i].doc_count, count);
+        i++;
+    }
+    ASSERT_EQ(bridge::fastfield::i64_from_sortable(all.front().key[1]), 19000);
+}
+
+TEST(CompositeTest, Errors) {
+    using namespace bridge::aggregation;
+    auto column = bridge::fastfield::numeric_column::build(std::vector<uint64_t>{3, 1, 3, 2});
+
+    ASSERT_THROW(composite_collector({}, 10), bridge::bridge_error);
+    ASSERT_THROW(composite_collector({{nullptr}}, 10), bridge::bridge_error);
+    ASSERT_THROW(composite_collector({{&column}}, 10, composite_key{1, 2}), bridge::bridge_error);
+
+    composite_collector collector({{&column}}, 2, composite_key{1});
+    for (bridge::DocId doc = 0; doc < 4; doc++) {
+        collector.collect(doc, 1.0F);
+    }
+    ASSERT_EQ(collector.buckets(), (std::vector<composite_bucket>{{{2}, 1}, {{3}, 2}}));
+    ASSERT_EQ(next_after_key(collector.buckets(), 2), composite_key{3});
+    ASSERT_FALSE(next_after_key(collector.buckets(), 3).has_value());
+}
@@ -0,0 +1,95 @@
+// Copyright (c) 2021 Bridge Project (Marcos Pontes)
+
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to
+//  deal in the Software without restriction, including without limitation the
+//  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+//  sell copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+//  IN THE SOFTWARE.
+
+#include <algorithm>
+#include <numeric>
+#include <random>
+
+#include <gtest/gtest.h>
+
+#include "bridge/bridge.hpp"
+
+namespace {
+
+    /// @brief Documents drawn from a few topics, each topic using its own slice of the vocabulary, shuffled.
+    bridge::index::forward_index clustered_docs(size_t num_docs, uint32_t num_topics, uint32_t terms_per_topic) {
+        std::mt19937 rng(42);
+        std::uniform_int_distribution<uint32_t> topic_dist(0, num_topics - 1);
+        std::uniform_int_distribution<uint32_t> term_dist(0, terms_per_topic - 1);
+
+        bridge::index::forward_index docs(num_docs);
+        for (auto &terms : docs) {
+            uint32_t topic = topic_dist(rng);
+            for (int i = 0; i < 8; i++) {
+                terms.push_back(topic * terms_per_topic + term_dist(rng));
+            }
+            std::sort(terms.begin(), terms.end());
+            terms.erase(std::unique(terms.begin(), terms.end()), terms.end());
+        }
+        return docs;
+    }
+
+} // namespace
+
+TEST(DocReorderTest, Permutation) {
+    using namespace bridge::index;
+
+    forward_index docs = clustered_docs(500, 10, 20);
+    std::vector<bridge::DocId> order = recursive_graph_bisection(docs, 200);
+    ASSERT_EQ(order.size(), docs.size());
+
+    std::vector<bridge::DocId> sorted = order;
+    std::sort(sorted.begin(), sorted.end());
+    std::vector<bridge::DocId> identity(docs.size());
+    std::iota(identity.begin(), identity.end(), 0);
+    ASSERT_EQ(sorted, identity);
+
+    std::vector<bridge::DocId> new_ids = to_new_doc_ids(order);
+    for (size_t new_id = 0; new_id < order.size(); new_id++) {
+        ASSERT_EQ(new_ids[order[new_id]], new_id);
+    }
+}
+
+TEST(DocReorderTest, ReducesCost) {
+    using namespace bridge::index;
+
+    forward_index docs = clustered_docs(2000, 16, 30);
+    std::vector<bridge::DocId> identity(docs.size());
+    std::iota(identity.begin(), identity.end(), 0);
+
+    std::vector<bridge::DocId> order = recursive_graph_bisection(docs, 16 * 30);
+    double before = log_gap_cost(docs, 16 * 30, identity);
+    double after = log_gap_cost(docs, 16 * 30, order);
+    ASSERT_LT(after, before * 0.8);
+
+    // a shallow bisection still helps, but less
+    std::vector<bridge::DocId> shallow = recursive_graph_bisection(docs, 16 * 30, {.iterations = 20, .max_depth = 1});
+    double shallow_cost = log_gap_cost(docs, 16 * 30, shallow);
+    ASSERT_LT(shallow_cost, before);
+    ASSERT_LT(after, shallow_cost);
+}
+
+TEST(DocReorderTest, SmallAndInvalid) {
+    using namespace bridge::index;
+
+    ASSERT_TRUE(recursive_graph_bisection({}, 0).empty());
+    ASSERT_EQ(recursive_graph_bisection({{0}, {1}, {0}}, 2), (std::vector<bridge::DocId>{0, 1, 2}));
+    ASSERT_THROW(recursive_graph_bisection({{0}, {3}}, 2), bridge::bridge_error);
+}
@@ -0,0 +1,121 @@
+#include "bridge/bridge.hpp"
+
+#include <algorithm>
+#include <random>
+#include <sstream>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+static std::vector<bridge::DocId> random_docs(size_t n, uint32_t max_gap, unsigned seed) {
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<uint32_t> gap(1, max_gap);
+    std::vector<bridge::DocId> docs;
+    bridge::DocId doc = 0;
+    for (size_t i = 0; i < n; i++) {
+        doc += gap(rng);
+        docs.push_back(doc);
+    }
+    return docs;
+}
+
+TEST(EliasFanoTest, Iterate) {
+    using namespace bridge::postings;
+
+    for (uint32_t max_gap : {1U, 3U, 50U, 100000U}) {
+        std::vector<bridge::DocId> docs = random_docs(1000, max_gap, max_gap);
+        elias_fano_postings postings = elias_fano_postings::build(docs);
+        ASSERT_EQ(postings.len(), docs.size());
+
+        elias_fano_cursor cursor = postings.cursor();
+        ASSERT_EQ(cursor.size_hint(), docs.size());
+        for (bridge::DocId doc : docs) {
+            ASSERT_EQ(cursor.doc(), doc);
+            cursor.advance();
+        }
+        ASSERT_EQ(cursor.doc(), TERMINATED);
+        ASSERT_EQ(cursor.advance(), TERMINATED);
+    }
+
+    // dense lists cost about one bit per document
+    std::vector<bridge::DocId> dense = random_docs(10000, 2, 7);
+    ASSERT_LT(elias_fano_postings::build(dense).num_bytes(), dense.size() / 4);
+
+    ASSERT_EQ(elias_fano_postings().cursor().doc(), TERMINATED);
+    ASSERT_ANY_THROW(elias_fano_postings::build({3, 3}));
+}
+
+TEST(EliasFanoTest, Seek) {
+    using namespace bridge::postings;
+
+    std::vector<bridge::DocId> docs = random_docs(5000, 40, 42);
+    elias_fano_postings postings = elias_fano_postings::build(docs);
+
+    std::mt19937 rng(1);
+    std::uniform_int_distribution<uint32_t> step(0, 2000);
+    elias_fano_cursor cursor = postings.cursor();
+    bridge::DocId target = 0;
+    while (cursor.doc() != TERMINATED) {
+        target += step(rng);
+        auto expected = std::lower_bound(docs.begin(), docs.end(), target);
+        bridge::DocId doc = cursor.seek(target);
+        ASSERT_EQ(doc, expected == docs.end() ? TERMINATED : *expected);
+    }
+
+    // seeking backward does not move the cursor
+    elias_fano_cursor other = postings.cursor();
+    other.seek(docs[300]);
+    ASSERT_EQ(other.seek(docs[10]), docs[300]);
+    ASSERT_EQ(other.advance(), docs[301]);
+}
+
+TEST(EliasFanoTest, Serialize) {
+    using namespace bridge::postings;
+
+    std::vector<bridge::DocId> docs = random_docs(777, 9, 3);
+    elias_fano_postings postings = elias_fano_postings::build(docs);
+
+    std::stringstream ss;
+    uint64_t written = postings.serialize(ss);
+    std::string raw = ss.str();
+    ASSERT_EQ(written, raw.size());
+
+    const bridge::byte_t *data = raw.data();
+    elias_fano_postings read = elias_fano_postings::deserialize(data, raw.data() + raw.size());
+    ASSERT_EQ(data, raw.data() + raw.size());
+
+    elias_fano_cursor cursor = read.cursor();
+    for (bridge::DocId doc : docs) {
+        ASSERT_EQ(cursor.doc(), doc);
+        cursor.advance();
+    }
+    ASSERT_EQ(cursor.doc(), TERMINATED);
+}
+
+TEST(EliasFanoTest, Corrupted) {
+    using namespace bridge::postings;
+
+    std::stringstream ss;
+    elias_fano_postings::build({3, 1000}).serialize(ss);
+    std::string raw = ss.str();
+    // len, partitions, size, two-byte last, dense flag, low bits, lows word count
+    ASSERT_EQ(raw[5], 0);
+
+    auto deserialize = [](const std::string &bytes) {
+        const bridge::byte_t *data = bytes.data();
+        return elias_fano_postings::deserialize(data, bytes.data() + bytes.size());
+    };
+    ASSERT_NO_THROW(deserialize(raw));
+
+    std::string low_bits = raw;
+    low_bits[6] = 64;
+    ASSERT_ANY_THROW(deserialize(low_bits));
+
+    std::string words = raw;
+    words[7] = 0x7F;
+    ASSERT_ANY_THROW(deserialize(words));
+
+    std::string size = raw;
+    size[2] = 3;
+    ASSERT_ANY_THROW(deserialize(size));
+}
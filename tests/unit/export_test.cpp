@@ -0,0 +1,103 @@
+// Copyright (c) 2021 Bridge Project (Marcos Pontes)
+
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to
+//  deal in the Software without restriction, including without limitation the
+//  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+//  sell copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+//  IN THE SOFTWARE.
+
+#include <sstream>
+
+#include <gtest/gtest.h>
+
+#include "bridge/bridge.hpp"
+
+namespace {
+
+    bridge::postings::vec_postings postings_of(const std::vector<bridge::DocId> &docs) {
+        std::vector<std::pair<bridge::DocId, uint32_t>> postings;
+        for (bridge::DocId doc : docs) {
+            postings.emplace_back(doc, 1);
+        }
+        return bridge::postings::vec_postings(std::move(postings));
+    }
+
+} // namespace
+
+TEST(ExportTest, OpenColumnInPlace) {
+    using namespace bridge::fastfield;
+
+    std::vector<int64_t> values = {-7, 0, 12, 1000, -3};
+    numeric_column column = numeric_column::build(values);
+
+    bridge::directory::RAMDirectory ram_dir;
+    std::filesystem::path path = "prices.fast";
+    {
+        auto writer = ram_dir.open_write(path);
+        column.serialize(*writer);
+        writer->flush();
+    }
+    numeric_column opened = numeric_column::open(ram_dir.open_read(path));
+    ASSERT_EQ(opened.kind(), numeric_kind::I64);
+    ASSERT_EQ(opened.num_docs(), values.size());
+    for (bridge::DocId doc = 0; doc < values.size(); doc++) {
+        ASSERT_EQ(opened.get(doc), static_cast<double>(values[doc]));
+    }
+    opened.advise(bridge::directory::access_pattern::Sequential);
+
+    ASSERT_THROW((void)numeric_column::open(bridge::directory::in_memory_source::empty()), bridge::bridge_error);
+}
+
+TEST(ExportTest, ExportDocs) {
+    using namespace bridge::collector;
+
+    std::vector<uint64_t> ids(100);
+    std::vector<double> prices(100);
+    for (size_t i = 0; i < ids.size(); i++) {
+        ids[i] = 1000 + i;
+        prices[i] = static_cast<double>(i) / 4;
+    }
+    auto id_column = bridge::fastfield::numeric_column::build(ids);
+    auto price_column = bridge::fastfield::numeric_column::build(prices);
+
+    std::vector<bridge::DocId> matching = {0, 3, 4, 10, 50, 51, 52, 99};
+    auto docs = postings_of(matching);
+    std::vector<bridge::DocId> exported;
+    size_t blocks = 0;
+    uint64_t total = export_docs(
+        docs, {&id_column, &price_column},
+        [&](const export_block &block) {
+            blocks++;
+            ASSERT_LE(block.docs.size(), 3);
+            ASSERT_EQ(block.values.size(), 2);
+            for (size_t i = 0; i < block.docs.size(); i++) {
+                exported.push_back(block.docs[i]);
+                ASSERT_EQ(block.values[0][i], ids[block.docs[i]]);
+                ASSERT_EQ(price_column.decode(block.values[1][i]), prices[block.docs[i]]);
+            }
+        },
+        3);
+    ASSERT_EQ(total, matching.size());
+    ASSERT_EQ(blocks, 3);
+    ASSERT_EQ(exported, matching);
+
+    auto again = postings_of({1, 2, 7});
+    std::ostringstream os;
+    ASSERT_EQ(export_tsv(again, {&id_column, &price_column}, os), 3);
+    ASSERT_EQ(os.str(), "1\t1001\t0.25\n2\t1002\t0.5\n7\t1007\t1.75\n");
+
+    auto none = postings_of({});
+    ASSERT_EQ(export_docs(none, {&id_column}, [](const export_block &) { FAIL(); }), 0);
+}
@@ -0,0 +1,92 @@
+// Copyright (c) 2021 Bridge Project (Marcos Pontes)
+
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to
+//  deal in the Software without restriction, including without limitation the
+//  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+//  sell copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+//  IN THE SOFTWARE.
+
+#include <random>
+
+#include <gtest/gtest.h>
+
+#include "bridge/bridge.hpp"
+
+TEST(FastFieldTest, SortableEncoding) {
+    using namespace bridge::fastfield;
+
+    std::vector<int64_t> ints = {std::numeric_limits<int64_t>::min(), -5, -1, 0, 1, 42,
+                                 std::numeric_limits<int64_t>::max()};
+    for (size_t i = 0; i < ints.size(); i++) {
+        ASSERT_EQ(i64_from_sortable(to_sortable(ints[i])), ints[i]);
+        if (i > 0) {
+            ASSERT_LT(to_sortable(ints[i - 1]), to_sortable(ints[i]));
+        }
+    }
+
+    std::vector<double> doubles = {-std::numeric_limits<double>::infinity(), -1e300, -2.5, -0.0, 0.0, 1e-300, 3.0,
+                                   std::numeric_limits<double>::infinity()};
+    for (size_t i = 0; i < doubles.size(); i++) {
+        ASSERT_EQ(f64_from_sortable(to_sortable(doubles[i])), doubles[i]);
+        if (i > 0) {
+            ASSERT_LE(to_sortable(doubles[i - 1]), to_sortable(doubles[i]));
+        }
+    }
+}
+
+TEST(FastFieldTest, NumericColumn) {
+    using namespace bridge::fastfield;
+
+    std::mt19937_64 rng(3);
+    for (uint64_t range : {0ULL, 1ULL, 1000ULL, 1ULL << 40, ~0ULL}) {
+        std::vector<uint64_t> values(1000);
+        for (auto &value : values) {
+            value = range == ~0ULL ? rng() : 500 + (range == 0 ? 0 : rng() % range);
+        }
+        numeric_column column = numeric_column::build(values);
+        ASSERT_EQ(column.num_docs(), values.size());
+        ASSERT_EQ(column.min_raw(), *std::min_element(values.begin(), values.end()));
+        ASSERT_EQ(column.max_raw(), *std::max_element(values.begin(), values.end()));
+
+        std::vector<bridge::byte_t> buffer;
+        {
+            bridge::directory::ArrayWriter out{bridge::directory::ArrayDevice(buffer)};
+            column.serialize(out);
+        }
+        const bridge::byte_t *data = buffer.data();
+        numeric_column read = numeric_column::deserialize(data, buffer.data() + buffer.size());
+        ASSERT_EQ(data, buffer.data() + buffer.size());
+        ASSERT_EQ(read.num_bits(), column.num_bits());
+        for (bridge::DocId doc = 0; doc < values.size(); doc++) {
+            ASSERT_EQ(column.get_raw(doc), values[doc]);
+            ASSERT_EQ(read.get_raw(doc), values[doc]);
+        }
+    }
+
+    numeric_column dates = numeric_column::build(std::vector<int64_t>{-100, 0, 250});
+    ASSERT_EQ(dates.kind(), numeric_kind::I64);
+    ASSERT_EQ(dates.get(0), -100.0);
+    ASSERT_EQ(dates.decode(dates.max_raw()), 250.0);
+    numeric_column prices = numeric_column::build(std::vector<double>{1.5, -2.25});
+    ASSERT_EQ(prices.get(1), -2.25);
+
+    std::vector<bridge::DocId> docs = {2, 0, 7};
+    std::vector<double> out(3);
+    ASSERT_THROW(dates.get_many(docs.data(), docs.size(), out.data()), bridge::bridge_error);
+
+    std::vector<bridge::byte_t> truncated(10, 0);
+    const bridge::byte_t *data = truncated.data();
+    ASSERT_THROW(numeric_column::deserialize(data, data + truncated.size()), bridge::bridge_error);
+}
@@ -0,0 +1,104 @@
+// Copyright (c) 2021 Bridge Project (Marcos Pontes)
+
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to
+//  deal in the Software without restriction, including without limitation the
+//  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+//  sell copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+//  IN THE SOFTWARE.
+
+#include <gtest/gtest.h>
+
+#include "bridge/bridge.hpp"
+
+TEST(FeatureLogTest, FieldFeatures) {
+    using namespace bridge::ltr;
+    using namespace bridge::postings;
+
+    term_vector_writer writer(bridge::schema::text_indexing_option::TokenizedWithTermVector);
+    writer.add_document(0, {{1, 2, {}}, {4, 1, {}}});
+    writer.add_document(1, {{4, 3, {}}, {9, 5, {}}});
+    std::vector<bridge::byte_t> buffer;
+    {
+        bridge::directory::ArrayWriter out{bridge::directory::ArrayDevice(buffer)};
+        writer.serialize(out);
+    }
+    term_vector_reader vectors(std::make_shared<bridge::directory::in_memory_source>(buffer));
+
+    field_query query{&vectors, {{1, 10}, {9, 20}}, 100, 5.0F};
+    std::vector<bridge::DocId> docs = {1, 0, 2};
+    feature_batch batch(features_per_field + 1, docs.size());
+    extract_field_features(query, docs, batch, 1);
+
+    bridge::scoring::bm25_weight term_1(10, 100, 5.0F);
+    bridge::scoring::bm25_weight term_9(20, 100, 5.0F);
+    ASSERT_FLOAT_EQ(batch.get(0, 1), term_9.score(5, 8));
+    ASSERT_FLOAT_EQ(batch.get(1, 1), term_1.score(2, 3));
+    ASSERT_FLOAT_EQ(batch.get(2, 1), 0.0F);
+    ASSERT_FLOAT_EQ(batch.get(0, 2), 5.0F);
+    ASSERT_FLOAT_EQ(batch.get(1, 2), 2.0F);
+    ASSERT_FLOAT_EQ(batch.get(0, 3), 8.0F);
+    ASSERT_FLOAT_EQ(batch.get(1, 3), 3.0F);
+    ASSERT_FLOAT_EQ(batch.get(0, 0), 0.0F);
+
+    ASSERT_THROW(extract_field_features(query, docs, batch, 2), bridge::bridge_error);
+}
+
+TEST(FeatureLogTest, LogAndRead) {
+    using namespace bridge::ltr;
+
+    // queries in no particular order, the features are a function of the query and the document
+    std::vector<judgment> judgments;
+    for (uint32_t i = 0; i < 200; i++) {
+        judgments.push_back({(i * 7) % 23, i, static_cast<float>(i % 4)});
+    }
+    feature_extractor extractor = [](uint32_t query_id, std::span<const bridge::DocId> docs, feature_batch &batch) {
+        for (size_t i = 0; i < docs.size(); i++) {
+            batch.set(i, 0, static_cast<float>(query_id));
+            batch.set(i, 1, static_cast<float>(docs[i]) * 0.5F);
+        }
+    };
+
+    bridge::directory::RAMDirectory dir;
+    {
+        auto out = dir.open_write("features.bin");
+        ASSERT_EQ(feature_logger(2, 4).log(judgments, extractor, *out), judgments.size());
+        out->flush();
+    }
+
+    feature_log_reader reader(dir.open_read("features.bin"));
+    ASSERT_EQ(reader.num_rows(), judgments.size());
+    ASSERT_EQ(reader.num_features(), 2);
+
+    std::vector<judgment> expected = judgments;
+    std::stable_sort(expected.begin(), expected.end(),
+                     [](const judgment &a, const judgment &b) { return a.query_id < b.query_id; });
+    std::vector<float> queries = reader.column(0);
+    std::vector<float> halves = reader.column(1);
+    for (uint64_t row = 0; row < reader.num_rows(); row++) {
+        ASSERT_EQ(reader.row(row), expected[row]);
+        ASSERT_FLOAT_EQ(queries[row], static_cast<float>(expected[row].query_id));
+        ASSERT_FLOAT_EQ(halves[row], static_cast<float>(expected[row].doc) * 0.5F);
+    }
+    ASSERT_THROW((void)reader.column(2), bridge::bridge_error);
+
+    feature_extractor failing = [](uint32_t query_id, std::span<const bridge::DocId>, feature_batch &) {
+        if (query_id == 5) {
+            throw bridge::bridge_error("extraction failed");
+        }
+    };
+    std::vector<bridge::byte_t> buffer;
+    bridge::directory::ArrayWriter out{bridge::directory::ArrayDevice(buffer)};
+    ASSERT_THROW(feature_logger(2, 4).log(judgments, failing, out), bridge::bridge_error);
+}
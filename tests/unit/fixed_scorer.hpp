@@ -0,0 +1,79 @@
+// Copyright (c) 2021 Bridge Project (Marcos Pontes)
+
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to
+//  deal in the Software without restriction, including without limitation the
+//  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+//  sell copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+//  IN THE SOFTWARE.
+
+//! \brief Scorer over fixed (doc, score) pairs, shared by the query tests.
+
+#ifndef BRIDGE_TESTS_FIXED_SCORER_HPP_
+#define BRIDGE_TESTS_FIXED_SCORER_HPP_
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+#include "bridge/bridge.hpp"
+
+namespace bridge::testing {
+
+    /**
+     * @brief Scorer over fixed (doc, score) pairs sorted by doc id, optionally counting the documents it visits.
+     * @details Each advance and each seek counts as one visit, however far the seek jumps.
+     */
+    class fixed_scorer : public bridge::query::scorer {
+      public:
+        explicit fixed_scorer(std::vector<std::pair<bridge::DocId, bridge::Score>> hits, uint32_t *visited = nullptr)
+            : hits_(std::move(hits)), visited_(visited) {}
+
+        bridge::DocId advance() override {
+            position_ = std::min(position_ + 1, hits_.size());
+            visit();
+            return doc();
+        }
+
+        [[nodiscard]] bridge::DocId doc() const override {
+            return position_ < hits_.size() ? hits_[position_].first : bridge::postings::TERMINATED;
+        }
+
+        bridge::DocId seek(bridge::DocId target) override {
+            auto it = std::lower_bound(hits_.begin() + static_cast<long>(position_), hits_.end(), target,
+                                       [](const auto &hit, bridge::DocId t) { return hit.first < t; });
+            position_ = static_cast<size_t>(it - hits_.begin());
+            visit();
+            return doc();
+        }
+
+        [[nodiscard]] uint32_t size_hint() const override { return static_cast<uint32_t>(hits_.size()); }
+
+        [[nodiscard]] bridge::Score score() const override { return hits_[position_].second; }
+
+      private:
+        void visit() {
+            if (visited_ != nullptr) {
+                ++*visited_;
+            }
+        }
+
+        std::vector<std::pair<bridge::DocId, bridge::Score>> hits_;
+        uint32_t *visited_;
+        size_t position_ = 0;
+    };
+
+} // namespace bridge::testing
+
+#endif // BRIDGE_TESTS_FIXED_SCORER_HPP_
@@ -0,0 +1,182 @@
+// Copyright (c) 2021 Bridge Project (Marcos Pontes)
+
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to
+//  deal in the Software without restriction, including without limitation the
+//  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+//  sell copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+//  IN THE SOFTWARE.
+
+#include <algorithm>
+#include <cmath>
+
+#include <gtest/gtest.h>
+
+#include "bridge/bridge.hpp"
+#include "fixed_scorer.hpp"
+
+namespace {
+
+    using bridge::testing::fixed_scorer;
+
+    /// @brief Constant function counting the documents it is evaluated on.
+    class counting_function : public bridge::query::score_function {
+      public:
+        explicit counting_function(size_t &evaluated) : evaluated_(&evaluated) {}
+
+        void evaluate(const bridge::DocId * /*docs*/, size_t count, bridge::Score *out) const override {
+            *evaluated_ += count;
+            std::fill(out, out + count, 2.0F);
+        }
+
+      private:
+        size_t *evaluated_;
+    };
+
+} // namespace
+
+TEST(FunctionScoreTest, Decay) {
+    using namespace bridge::query;
+
+    auto column = bridge::fastfield::numeric_column::build(std::vector<int64_t>{100, 90, 80, 60, 0, 110});
+    std::vector<bridge::DocId> docs = {0, 1, 2, 3, 4, 5};
+    std::vector<bridge::Score> out(docs.size());
+
+    decay_function gauss(decay_kind::Gauss, column, 100.0, 20.0, 0.0, 0.5);
+    gauss.evaluate(docs.data(), docs.size(), out.data());
+    ASSERT_FLOAT_EQ(out[0], 1.0F);
+    ASSERT_FLOAT_EQ(out[2], 0.5F);
+    ASSERT_FLOAT_EQ(out[1], std::pow(0.5F, 0.25F));
+    ASSERT_FLOAT_EQ(out[5], out[1]);
+
+    decay_function exp(decay_kind::Exp, column, 100.0, 20.0, 0.0, 0.5);
+    exp.evaluate(docs.data(), docs.size(), out.data());
+    ASSERT_FLOAT_EQ(out[2], 0.5F);
+    ASSERT_FLOAT_EQ(out[3], 0.25F);
+
+    decay_function linear(decay_kind::Linear, column, 100.0, 20.0, 10.0, 0.5);
+    linear.evaluate(docs.data(), docs.size(), out.data());
+    ASSERT_FLOAT_EQ(out[1], 1.0F);
+    ASSERT_FLOAT_EQ(out[2], 0.75F);
+    ASSERT_FLOAT_EQ(out[3], 0.25F);
+    ASSERT_FLOAT_EQ(out[4], 0.0F);
+
+    ASSERT_THROW(decay_function(decay_kind::Exp, column, 0.0, 0.0), bridge::bridge_error);
+    ASSERT_THROW(decay_function(decay_kind::Exp, column, 0.0, 1.0, 0.0, 1.0), bridge::bridge_error);
+}
+
+TEST(FunctionScoreTest, GeoDecay) {
+    using namespace bridge::query;
+
+    // Paris, then a point about 111km north of it
+    auto latitudes = bridge::fastfield::numeric_column::build(std::vector<double>{48.8566, 49.8566});
+    auto longitudes = bridge::fastfield::numeric_column::build(std::vector<double>{2.3522, 2.3522});
+    geo_decay_function geo(decay_kind::Exp, latitudes, longitudes, 48.8566, 2.3522, 111195.0, 0.0, 0.5);
+
+    std::vector<bridge::DocId> docs = {0, 1};
+    std::vector<bridge::Score> out(docs.size());
+    geo.evaluate(docs.data(), docs.size(), out.data());
+    ASSERT_FLOAT_EQ(out[0], 1.0F);
+    ASSERT_NEAR(out[1], 0.5F, 1e-3);
+}
+
+TEST(FunctionScoreTest, FieldValueFactor) {
+    using namespace bridge::query;
+
+    auto popularity = bridge::fastfield::numeric_column::build(std::vector<uint64_t>{0, 9, 99});
+    std::vector<bridge::DocId> docs = {0, 1, 2};
+    std::vector<bridge::Score> out(docs.size());
+
+    field_value_factor(popularity, 1.0, value_modifier::Log1p).evaluate(docs.data(), docs.size(), out.data());
+    ASSERT_EQ(out, (std::vector<bridge::Score>{0.0F, 1.0F, 2.0F}));
+    field_value_factor(popularity, 2.0, value_modifier::None).evaluate(docs.data(), docs.size(), out.data());
+    ASSERT_EQ(out, (std::vector<bridge::Score>{0.0F, 18.0F, 198.0F}));
+    field_value_factor(popularity, 1.0, value_modifier::Square).evaluate(docs.data(), docs.size(), out.data());
+    ASSERT_EQ(out[1], 81.0F);
+}
+
+TEST(FunctionScoreTest, Scorer) {
+    using namespace bridge::query;
+
+    // more hits than a block, scores equal to the doc id
+    std::vector<uint64_t> popularity;
+    std::vector<std::pair<bridge::DocId, bridge::Score>> hits;
+    for (bridge::DocId doc = 0; doc < 300; doc++) {
+        popularity.push_back(doc % 10);
+        if (doc % 2 == 0) {
+            hits.emplace_back(doc, static_cast<bridge::Score>(doc));
+        }
+    }
+    auto column = bridge::fastfield::numeric_column::build(popularity);
+
+    auto make = [&](score_mode functions_mode, boost_mode query_mode) {
+        std::vector<std::unique_ptr<score_function>> functions;
+        functions.push_back(std::make_unique<field_value_factor>(column));
+        functions.push_back(std::make_unique<field_value_factor>(column, 2.0));
+        return function_score_scorer(std::make_unique<fixed_scorer>(hits), std::move(functions), functions_mode,
+                                     query_mode);
+    };
+
+    function_score_scorer sum = make(score_mode::Sum, boost_mode::Multiply);
+    size_t matched = 0;
+    for (bridge::DocId doc = sum.doc(); doc != bridge::postings::TERMINATED; doc = sum.advance()) {
+        ASSERT_EQ(doc, hits[matched].first);
+        ASSERT_FLOAT_EQ(sum.score(), static_cast<bridge::Score>(doc) * 3.0F * static_cast<bridge::Score>(doc % 10));
+        matched++;
+    }
+    ASSERT_EQ(matched, hits.size());
+
+    function_score_scorer replace = make(score_mode::Multiply, boost_mode::Replace);
+    ASSERT_EQ(replace.seek(13), 14);
+    ASSERT_FLOAT_EQ(replace.score(), 32.0F);
+    ASSERT_EQ(replace.seek(201), 202);
+    ASSERT_FLOAT_EQ(replace.score(), 8.0F);
+    ASSERT_EQ(replace.seek(100), 202);
+    ASSERT_EQ(replace.advance(), 204);
+
+    function_score_scorer avg = make(score_mode::Avg, boost_mode::Sum);
+    ASSERT_EQ(avg.seek(4), 4);
+    ASSERT_FLOAT_EQ(avg.score(), 4.0F + 6.0F);
+    ASSERT_EQ(avg.seek(1000), bridge::postings::TERMINATED);
+}
+
+TEST(FunctionScoreTest, SeekScoresLazily) {
+    using namespace bridge::query;
+
+    std::vector<std::pair<bridge::DocId, bridge::Score>> hits;
+    for (bridge::DocId doc = 0; doc < 1000; doc++) {
+        hits.emplace_back(doc, 1.0F);
+    }
+    size_t evaluated = 0;
+    std::vector<std::unique_ptr<score_function>> functions;
+    functions.push_back(std::make_unique<counting_function>(evaluated));
+    function_score_scorer scorer(std::make_unique<fixed_scorer>(hits), std::move(functions));
+
+    // skipping around, as the follower of a conjunction does, only evaluates the documents that are scored
+    for (bridge::DocId target = 10; target < 1000; target += 100) {
+        ASSERT_EQ(scorer.seek(target), target);
+    }
+    ASSERT_EQ(evaluated, 0);
+    ASSERT_FLOAT_EQ(scorer.score(), 2.0F);
+    ASSERT_FLOAT_EQ(scorer.score(), 2.0F);
+    ASSERT_EQ(evaluated, 1);
+
+    // iterating switches back to blocks
+    ASSERT_EQ(scorer.advance(), 911);
+    ASSERT_FLOAT_EQ(scorer.score(), 2.0F);
+    ASSERT_EQ(evaluated, 1 + score_function::block_size);
+    ASSERT_EQ(scorer.seek(920), 920);
+    ASSERT_FLOAT_EQ(scorer.score(), 2.0F);
+    ASSERT_EQ(evaluated, 1 + score_function::block_size);
+}
@@ -0,0 +1,105 @@
+#include "bridge/bridge.hpp"
+
+#include <sstream>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+TEST(ImpactTest, Quantizer) {
+    using bridge::postings::impact_quantizer;
+
+    impact_quantizer quantizer(10.0F);
+    ASSERT_EQ(quantizer.quantize(10.0F), 255);
+    ASSERT_EQ(quantizer.quantize(42.0F), 255);
+    ASSERT_EQ(quantizer.quantize(0.0F), 1);
+    ASSERT_LT(quantizer.quantize(2.0F), quantizer.quantize(3.0F));
+    ASSERT_NEAR(quantizer.dequantize(quantizer.quantize(5.0F)), 5.0F, 10.0F / 255);
+
+    ASSERT_ANY_THROW(impact_quantizer(0.0F));
+    ASSERT_ANY_THROW(impact_quantizer(1.0F, 9));
+}
+
+TEST(ImpactTest, PostingsRoundTrip) {
+    using namespace bridge::postings;
+
+    impact_quantizer quantizer(1.0F, 2); // impacts in [1, 3]
+    impact_postings postings = impact_postings::build({{9, 1.0F}, {3, 0.1F}, {5, 0.9F}, {1, 0.5F}}, quantizer);
+
+    ASSERT_EQ(postings.len(), 4);
+    ASSERT_EQ(postings.segments().size(), 3);
+    ASSERT_EQ(postings.segments()[0], (impact_segment{3, {5, 9}}));
+    ASSERT_EQ(postings.segments()[1], (impact_segment{2, {1}}));
+    ASSERT_EQ(postings.segments()[2], (impact_segment{1, {3}}));
+
+    std::stringstream ss;
+    uint64_t written = postings.serialize(ss);
+    std::string raw = ss.str();
+    ASSERT_EQ(written, raw.size());
+
+    const bridge::byte_t *data = raw.data();
+    impact_postings read = impact_postings::deserialize(data, raw.data() + raw.size());
+    ASSERT_EQ(data, raw.data() + raw.size());
+    ASSERT_EQ(read.segments(), postings.segments());
+
+    // Counts larger than the remaining input are rejected before anything is allocated.
+    std::string segments = raw;
+    segments[0] = 0x7F;
+    data = segments.data();
+    ASSERT_ANY_THROW(impact_postings::deserialize(data, segments.data() + segments.size()));
+    std::string docs = raw;
+    docs[2] = 0x7F;
+    data = docs.data();
+    ASSERT_ANY_THROW(impact_postings::deserialize(data, docs.data() + docs.size()));
+}
+
+TEST(ImpactTest, ScoreAtATime) {
+    using namespace bridge::postings;
+    using bridge::query::impact_hit;
+    using bridge::query::score_at_a_time;
+    using bridge::scoring::bm25_weight;
+
+    // BM25 drives the quantization: longer documents get smaller impacts.
+    bm25_weight weight(3, 10, 10.0F);
+    ASSERT_GT(weight.score(2, 5), weight.score(2, 20));
+    ASSERT_LT(weight.score(1000, 10), weight.max_score());
+
+    impact_quantizer quantizer(4.0F, 4);
+    impact_postings tax = impact_postings::build({{0, 4.0F}, {1, 1.0F}, {2, 2.0F}}, quantizer);
+    impact_postings happy = impact_postings::build({{1, 4.0F}, {3, 0.5F}}, quantizer);
+
+    score_at_a_time evaluator(4);
+
+    evaluator.add_term(tax);
+    evaluator.add_term(happy);
+    std::vector<impact_hit> exact = evaluator.top_k(3);
+    ASSERT_EQ(evaluator.processed(), 5);
+    ASSERT_EQ(exact.size(), 3);
+    ASSERT_EQ(exact[0], (impact_hit{1, 19}));
+    ASSERT_EQ(exact[1], (impact_hit{0, 15}));
+    ASSERT_EQ(exact[2], (impact_hit{2, 8}));
+
+    // With a budget of two postings, only the highest impacts are visited.
+    evaluator.add_term(tax);
+    evaluator.add_term(happy);
+    std::vector<impact_hit> approximate = evaluator.top_k(3, 2);
+    ASSERT_EQ(evaluator.processed(), 2);
+    ASSERT_EQ(approximate.size(), 2);
+    ASSERT_EQ(approximate[0], (impact_hit{0, 15}));
+    ASSERT_EQ(approximate[1], (impact_hit{1, 15}));
+
+    // Accumulators are reset between queries.
+    evaluator.add_term(happy, 2);
+    std::vector<impact_hit> weighted = evaluator.top_k(1);
+    ASSERT_EQ(weighted[0], (impact_hit{1, 30}));
+
+    // Invalid terms are rejected before they can dirty the accumulators.
+    impact_postings out_of_range = impact_postings::build({{1, 4.0F}, {7, 4.0F}}, quantizer);
+    evaluator.add_term(happy);
+    ASSERT_THROW(evaluator.add_term(out_of_range), bridge::bridge_error);
+    ASSERT_THROW(evaluator.add_term(tax, 0), bridge::bridge_error);
+    std::vector<impact_hit> after_error = evaluator.top_k(3);
+    ASSERT_EQ(after_error.size(), 2);
+    ASSERT_EQ(after_error[0], (impact_hit{1, 15}));
+    ASSERT_EQ(after_error[1], (impact_hit{3, 2}));
+}
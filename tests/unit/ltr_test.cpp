@@ -0,0 +1,177 @@
+// Copyright (c) 2021 Bridge Project (Marcos Pontes)
+
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to
+//  deal in the Software without restriction, including without limitation the
+//  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+//  sell copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+//  IN THE SOFTWARE.
+
+#include <cmath>
+#include <functional>
+#include <random>
+
+#include <gtest/gtest.h>
+
+#include "bridge/bridge.hpp"
+
+namespace {
+
+    /// @brief Random tree of the given depth over num_features features in [0, 1).
+    bridge::ltr::regression_tree random_tree(std::mt19937 &rng, uint32_t depth, uint32_t num_features) {
+        std::uniform_int_distribution<uint32_t> feature_dist(0, num_features - 1);
+        std::uniform_real_distribution<float> value_dist(0.0F, 1.0F);
+
+        bridge::ltr::regression_tree tree;
+        std::function<int32_t(uint32_t)> grow = [&](uint32_t level) -> int32_t {
+            auto index = static_cast<int32_t>(tree.nodes.size());
+            tree.nodes.emplace_back();
+            if (level == depth || (level > 1 && value_dist(rng) < 0.2F)) {
+                tree.nodes[index].value = value_dist(rng) - 0.5F;
+                return index;
+            }
+            bridge::ltr::tree_node node;
+            node.feature = feature_dist(rng);
+            node.threshold = value_dist(rng);
+            node.missing_left = value_dist(rng) < 0.5F;
+            node.left = grow(level + 1);
+            node.right = grow(level + 1);
+            tree.nodes[index] = node;
+            return index;
+        };
+        grow(0);
+        return tree;
+    }
+
+} // namespace
+
+TEST(LtrTest, FromJson) {
+    using namespace bridge::ltr;
+
+    auto json = bridge::serialization::json_t::parse(R"({
+        "base_score": 0.5,
+        "trees": [
+            {"nodeid": 0, "split": "f1", "split_condition": 2.0, "yes": 1, "no": 2, "children": [
+                {"nodeid": 1, "leaf": 1.0},
+                {"nodeid": 2, "split": "f0", "split_condition": 10.0, "yes": 4, "no": 3, "missing": 3,
+                 "children": [
+                    {"nodeid": 3, "leaf": 3.0},
+                    {"nodeid": 4, "leaf": 2.0}
+                ]}
+            ]},
+            {"nodeid": 0, "leaf": 0.25}
+        ]
+    })");
+    tree_ensemble ensemble = tree_ensemble::from_json(json);
+    ASSERT_EQ(ensemble.trees().size(), 2);
+    ASSERT_EQ(ensemble.num_features(), 2);
+    ASSERT_EQ(ensemble.trees()[0].num_leaves(), 3);
+
+    std::vector<float> doc = {0.0F, 1.0F};
+    ASSERT_FLOAT_EQ(ensemble.score(doc.data()), 1.75F);
+    doc = {5.0F, 2.0F};
+    ASSERT_FLOAT_EQ(ensemble.score(doc.data()), 2.75F);
+    doc = {10.0F, 2.0F};
+    ASSERT_FLOAT_EQ(ensemble.score(doc.data()), 3.75F);
+
+    // missing features follow the learnt direction: left by default, right where "missing" is "no"
+    doc = {0.0F, std::nanf("")};
+    ASSERT_FLOAT_EQ(ensemble.score(doc.data()), 1.75F);
+    doc = {std::nanf(""), 2.0F};
+    ASSERT_FLOAT_EQ(ensemble.score(doc.data()), 3.75F);
+
+    ASSERT_THROW(tree_ensemble::from_json(bridge::serialization::json_t::parse(
+                     R"([{"nodeid": 0, "split": "x", "split_condition": 1, "yes": 1, "no": 2, "children": []}])")),
+                 bridge::bridge_error);
+    ASSERT_THROW(tree_ensemble::from_json(bridge::serialization::json_t::parse(
+                     R"([{"nodeid": 0, "split": "f0", "split_condition": 1, "yes": 1, "no": 2, "missing": 5,
+                          "children": [{"nodeid": 1, "leaf": 1.0}, {"nodeid": 2, "leaf": 2.0}]}])")),
+                 bridge::bridge_error);
+}
+
+TEST(LtrTest, QuickScorer) {
+    using namespace bridge::ltr;
+
+    std::mt19937 rng(7);
+    const uint32_t num_features = 12;
+    std::vector<regression_tree> trees;
+    for (int i = 0; i < 100; i++) {
+        trees.push_back(random_tree(rng, 6, num_features));
+    }
+    tree_ensemble ensemble(std::move(trees), num_features, 0.1F);
+    quick_scorer scorer(ensemble);
+
+    // not a multiple of the block size, with a few missing values
+    feature_batch batch(num_features, 101);
+    std::uniform_real_distribution<float> value_dist(0.0F, 1.0F);
+    for (size_t doc = 0; doc < batch.num_docs(); doc++) {
+        for (uint32_t feature = 0; feature < num_features; feature++) {
+            batch.set(doc, feature, doc % 17 == 3 && feature == 2 ? std::nanf("") : value_dist(rng));
+        }
+    }
+
+    std::vector<bridge::Score> scores = scorer.score(batch);
+    ASSERT_EQ(scores.size(), batch.num_docs());
+    for (size_t doc = 0; doc < batch.num_docs(); doc++) {
+        ASSERT_FLOAT_EQ(scores[doc], ensemble.score(batch.row(doc).data()));
+    }
+
+    ASSERT_THROW((void)scorer.score(feature_batch(3, 1)), bridge::bridge_error);
+}
+
+TEST(LtrTest, QuickScorerLeadingNaN) {
+    using namespace bridge::ltr;
+
+    std::mt19937 rng(11);
+    const uint32_t num_features = 4;
+    std::vector<regression_tree> trees;
+    for (int i = 0; i < 20; i++) {
+        trees.push_back(random_tree(rng, 5, num_features));
+    }
+    tree_ensemble ensemble(std::move(trees), num_features);
+    quick_scorer scorer(ensemble);
+
+    // the first document of each block misses a feature the others have
+    feature_batch batch(num_features, 2 * quick_scorer::block_size);
+    std::uniform_real_distribution<float> value_dist(0.0F, 1.0F);
+    for (size_t doc = 0; doc < batch.num_docs(); doc++) {
+        for (uint32_t feature = 0; feature < num_features; feature++) {
+            batch.set(doc, feature, doc % quick_scorer::block_size == 0 ? std::nanf("") : value_dist(rng));
+        }
+    }
+
+    std::vector<bridge::Score> scores = scorer.score(batch);
+    for (size_t doc = 0; doc < batch.num_docs(); doc++) {
+        ASSERT_FLOAT_EQ(scores[doc], ensemble.score(batch.row(doc).data()));
+    }
+}
+
+TEST(LtrTest, Rerank) {
+    using namespace bridge::ltr;
+
+    // a single stump preferring a high first feature
+    regression_tree stump{{{0, 0.5F, 1, 2, 0.0F}, {0, 0.0F, -1, -1, 0.0F}, {0, 0.0F, -1, -1, 1.0F}}};
+    std::vector<regression_tree> trees{stump};
+    quick_scorer scorer(tree_ensemble(std::move(trees), 1));
+
+    std::vector<ranked_doc> candidates = {{4, 9.0F}, {7, 8.0F}, {1, 7.0F}};
+    feature_batch batch(1, candidates.size());
+    batch.set(0, 0, 0.1F);
+    batch.set(1, 0, 0.9F);
+    batch.set(2, 0, 0.2F);
+
+    std::vector<ranked_doc> expected = {{7, 1.0F}, {1, 0.0F}, {4, 0.0F}};
+    ASSERT_EQ(rerank(candidates, batch, scorer), expected);
+    ASSERT_THROW(rerank(candidates, feature_batch(1, 2), scorer), bridge::bridge_error);
+}
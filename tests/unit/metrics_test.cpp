@@ -0,0 +1,132 @@
+// Copyright (c) 2021 Bridge Project (Marcos Pontes)
+
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to
+//  deal in the Software without restriction, including without limitation the
+//  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+//  sell copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+//  IN THE SOFTWARE.
+
+#include <algorithm>
+#include <random>
+
+#include <gtest/gtest.h>
+
+#include "bridge/bridge.hpp"
+
+TEST(MetricsTest, HyperLogLog) {
+    using namespace bridge::aggregation;
+    ASSERT_THROW(hyperloglog(3), bridge::bridge_error);
+
+    hyperloglog empty;
+    ASSERT_EQ(empty.estimate(), 0);
+
+    for (uint64_t n : {10ULL, 1000ULL, 100000ULL, 2000000ULL}) {
+        hyperloglog sketch;
+        for (uint64_t i = 0; i < n; i++) {
+            sketch.add(i * 7919);
+            sketch.add(i * 7919); // duplicates do not count
+        }
+        double error = std::abs(static_cast<double>(sketch.estimate()) - static_cast<double>(n)) / n;
+        ASSERT_LT(error, 0.03) << n;
+    }
+
+    // merging sketches of overlapping sets counts their union
+    hyperloglog a;
+    hyperloglog b;
+    for (uint64_t i = 0; i < 60000; i++) {
+        a.add(i);
+        b.add(i + 40000);
+    }
+    a.merge(b);
+    ASSERT_NEAR(static_cast<double>(a.estimate()), 100000.0, 3000.0);
+    ASSERT_THROW(a.merge(hyperloglog(10)), bridge::bridge_error);
+}
+
+TEST(MetricsTest, TDigest) {
+    using namespace bridge::aggregation;
+    ASSERT_THROW(tdigest(1.0), bridge::bridge_error);
+
+    tdigest empty;
+    ASSERT_TRUE(std::isnan(empty.quantile(0.5)));
+
+    std::mt19937_64 rng(9);
+    std::lognormal_distribution<double> latency(3.0, 1.0);
+    std::vector<double> values(200000);
+    tdigest digest;
+    for (auto &value : values) {
+        value = latency(rng);
+        digest.add(value);
+    }
+    digest.add(std::numeric_limits<double>::quiet_NaN());
+    std::sort(values.begin(), values.end());
+
+    ASSERT_EQ(digest.count(), values.size());
+    ASSERT_LE(digest.centroids().size(), 200);
+    ASSERT_EQ(digest.quantile(0.0), values.front());
+    ASSERT_EQ(digest.quantile(1.0), values.back());
+    for (double q : {0.01, 0.1, 0.5, 0.9, 0.99, 0.999}) {
+        // rank of the estimate among the values
+        double estimate = digest.quantile(q);
+        double rank = static_cast<double>(std::lower_bound(values.begin(), values.end(), estimate) - values.begin()) /
+                      static_cast<double>(values.size());
+        ASSERT_NEAR(rank, q, std::min(q, 1 - q) < 0.05 ? 0.0005 : 0.005) << q; // more accurate at the tails
+    }
+    ASSERT_THROW((void)digest.quantile(1.5), bridge::bridge_error);
+
+    tdigest single;
+    single.add(42.0);
+    ASSERT_EQ(single.quantile(0.3), 42.0);
+}
+
+TEST(MetricsTest, SegmentAggregations) {
+    using namespace bridge::aggregation;
+
+    // 4 segments of response times, where even documents match
+    std::vector<bridge::fastfield::numeric_column> segments;
+    std::vector<double> matching;
+    for (size_t s = 0; s < 4; s++) {
+        std::vector<double> values(5000);
+        for (size_t i = 0; i < values.size(); i++) {
+            values[i] = static_cast<double>((s * values.size() + i) % 7000);
+            if (i % 2 == 0) {
+                matching.push_back(values[i]);
+            }
+        }
+        segments.push_back(bridge::fastfield::numeric_column::build(values));
+    }
+
+    auto collect_even = [](bridge::collector::collector &collector, const bridge::fastfield::numeric_column &column) {
+        for (bridge::DocId doc = 0; doc < column.num_docs(); doc += 2) {
+            collector.collect(doc, 1.0F);
+        }
+    };
+    hyperloglog distinct = aggregate_segments<hyperloglog>(segments.size(), [&](size_t s) {
+        cardinality_collector collector(segments[s]);
+        collect_even(collector, segments[s]);
+        return collector.sketch();
+    });
+    tdigest percentiles = aggregate_segments<tdigest>(segments.size(), [&](size_t s) {
+        percentiles_collector collector(segments[s]);
+        collect_even(collector, segments[s]);
+        return collector.sketch();
+    });
+
+    std::sort(matching.begin(), matching.end());
+    double exact_median = matching[matching.size() / 2];
+    auto exact_distinct = static_cast<double>(std::unique(matching.begin(), matching.end()) - matching.begin());
+    ASSERT_NEAR(static_cast<double>(distinct.estimate()), exact_distinct, 0.03 * exact_distinct);
+    ASSERT_EQ(percentiles.count(), 10000);
+    ASSERT_NEAR(percentiles.quantile(0.5), exact_median, 50.0);
+}
@@ -0,0 +1,118 @@
+// Copyright (c) 2021 Bridge Project (Marcos Pontes)
+
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to
+//  deal in the Software without restriction, including without limitation the
+//  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+//  sell copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+//  IN THE SOFTWARE.
+
+#include <map>
+#include <random>
+
+#include <gtest/gtest.h>
+
+#include "bridge/bridge.hpp"
+#include "fixed_scorer.hpp"
+
+namespace {
+
+    using bridge::postings::TERMINATED;
+    using bridge::testing::fixed_scorer;
+
+    using postings_list = std::vector<std::pair<bridge::DocId, bridge::Score>>;
+
+    std::vector<std::unique_ptr<bridge::query::scorer>> clauses(const std::vector<postings_list> &lists,
+                                                                uint32_t &visited) {
+        std::vector<std::unique_ptr<bridge::query::scorer>> out;
+        for (const auto &list : lists) {
+            out.push_back(std::make_unique<fixed_scorer>(list, &visited));
+        }
+        return out;
+    }
+
+} // namespace
+
+TEST(MinShouldMatchTest, MatchesBruteForce) {
+    std::mt19937 rng(42);
+    std::vector<postings_list> lists(6);
+    std::map<bridge::DocId, std::pair<uint32_t, bridge::Score>> expected;
+    for (size_t i = 0; i < lists.size(); i++) {
+        std::bernoulli_distribution keep(0.1 + 0.1 * static_cast<double>(i));
+        for (bridge::DocId doc = 0; doc < 500; doc++) {
+            if (keep(rng)) {
+                auto score = static_cast<bridge::Score>(i + 1);
+                lists[i].emplace_back(doc, score);
+                expected[doc].first++;
+                expected[doc].second += score;
+            }
+        }
+    }
+
+    for (uint32_t minimum = 1; minimum <= 7; minimum++) {
+        uint32_t visited = 0;
+        bridge::query::min_should_match_scorer scorer(clauses(lists, visited), minimum);
+        std::vector<bridge::DocId> docs;
+        for (bridge::DocId doc = scorer.doc(); doc != TERMINATED; doc = scorer.advance()) {
+            ASSERT_GE(scorer.num_matches(), minimum);
+            ASSERT_EQ(scorer.num_matches(), expected[doc].first) << doc;
+            ASSERT_FLOAT_EQ(scorer.score(), expected[doc].second) << doc;
+            docs.push_back(doc);
+        }
+        std::vector<bridge::DocId> brute_force;
+        for (const auto &[doc, match] : expected) {
+            if (match.first >= minimum) {
+                brute_force.push_back(doc);
+            }
+        }
+        ASSERT_EQ(docs, brute_force) << minimum;
+        ASSERT_LE(brute_force.size(), scorer.size_hint());
+
+        bridge::query::min_should_match_scorer seeking(clauses(lists, visited), minimum);
+        for (bridge::DocId target = 0; target < 520; target += 37) {
+            auto it = std::lower_bound(brute_force.begin(), brute_force.end(), target);
+            bridge::DocId doc = seeking.seek(target);
+            ASSERT_EQ(doc, it == brute_force.end() ? TERMINATED : *it) << target;
+            if (doc != TERMINATED) {
+                ASSERT_EQ(seeking.num_matches(), expected[doc].first);
+            }
+        }
+    }
+}
+
+TEST(MinShouldMatchTest, SkipsAhead) {
+    postings_list rare = {{100, 1.0F}, {5000, 1.0F}};
+    postings_list common;
+    postings_list frequent;
+    for (bridge::DocId doc = 0; doc < 10000; doc++) {
+        common.emplace_back(doc, 0.5F);
+        if (doc % 2 == 0) {
+            frequent.emplace_back(doc, 0.25F);
+        }
+    }
+
+    uint32_t visited = 0;
+    bridge::query::min_should_match_scorer scorer(clauses({rare, common, frequent}, visited), 3);
+    ASSERT_EQ(scorer.doc(), 100U);
+    ASSERT_FLOAT_EQ(scorer.score(), 1.75F);
+    ASSERT_EQ(scorer.advance(), 5000U);
+    ASSERT_EQ(scorer.advance(), TERMINATED);
+    ASSERT_LT(visited, 20U); // the common clauses are sought to the rare one, not walked
+
+    ASSERT_EQ(bridge::query::min_should_match_scorer::from_percentage(10, 70.0), 7U);
+    ASSERT_EQ(bridge::query::min_should_match_scorer::from_percentage(4, 70.0), 2U);
+    ASSERT_EQ(bridge::query::min_should_match_scorer::from_percentage(1, 10.0), 1U);
+    ASSERT_THROW((void)bridge::query::min_should_match_scorer::from_percentage(3, 120.0), bridge::bridge_error);
+    ASSERT_THROW(bridge::query::min_should_match_scorer(clauses({rare}, visited), 0), bridge::bridge_error);
+}
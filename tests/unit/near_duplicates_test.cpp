@@ -0,0 +1,138 @@
+// Copyright (c) 2021 Bridge Project (Marcos Pontes)
+
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to
+//  deal in the Software without restriction, including without limitation the
+//  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+//  sell copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+//  IN THE SOFTWARE.
+
+#include <algorithm>
+#include <random>
+
+#include <gtest/gtest.h>
+
+#include "bridge/bridge.hpp"
+
+namespace {
+
+    std::vector<std::string> random_words(std::mt19937 &rng, size_t n) {
+        static const std::vector<std::string> vocabulary = {
+            "index", "search", "query",  "segment", "merge",  "term",  "score", "field", "token",  "shard",
+            "fast",  "slow",   "engine", "disk",    "memory", "cache", "page",  "block", "stream", "doc"};
+        std::vector<std::string> words;
+        for (size_t i = 0; i < n; i++) {
+            words.push_back(vocabulary[rng() % vocabulary.size()] + std::to_string(rng() % 50));
+        }
+        return words;
+    }
+
+    std::string join(const std::vector<std::string> &words) {
+        std::string text;
+        for (const auto &word : words) {
+            text += word + " ";
+        }
+        return text;
+    }
+
+} // namespace
+
+TEST(NearDuplicatesTest, SimHash) {
+    using namespace bridge::index;
+    std::mt19937 rng(5);
+    auto words = random_words(rng, 1000);
+
+    ASSERT_EQ(simhash({}), 0);
+    ASSERT_EQ(simhash_text(join(words)), simhash(words));
+    ASSERT_EQ(simhash_text("Hello, World!"), simhash_text("hello world"));
+    ASSERT_THROW((void)simhash(words, 0), bridge::bridge_error);
+
+    auto edited = words;
+    edited[500] = "changed";
+    ASSERT_LE(hamming_distance(simhash(words), simhash(edited)), 3);
+    ASSERT_GT(hamming_distance(simhash(words), simhash(random_words(rng, 1000))), 10);
+}
+
+TEST(NearDuplicatesTest, Detector) {
+    using namespace bridge::index;
+    ASSERT_THROW(near_duplicate_detector(3, 5), bridge::bridge_error);
+    ASSERT_THROW(near_duplicate_detector(4, 4), bridge::bridge_error);
+
+    near_duplicate_detector detector;
+    uint64_t base = 0x0123456789ABCDEFULL;
+    ASSERT_EQ(detector.add(base), 0);
+    ASSERT_EQ(detector.add(~base), 1);
+    // three flipped bits in three different bands, and then in the same band
+    ASSERT_EQ(detector.add(base ^ 0x0001000100010000ULL), 0);
+    ASSERT_EQ(detector.add(base ^ 0x7ULL), 0);
+    ASSERT_EQ(detector.add(base ^ 0xFULL), 0); // too far from 0, but close to 3 which is in the cluster of 0
+    ASSERT_FALSE(detector.find(base ^ 0xFF00FF00ULL).has_value());
+
+    ASSERT_EQ(detector.find(base ^ 0x1ULL), 0);
+    ASSERT_EQ(detector.near_duplicates(base ^ 0x1ULL), (std::vector<bridge::DocId>{0, 3, 4}));
+
+    // collapsing on the cluster column shows one document per cluster
+    auto clusters = detector.cluster_column();
+    ASSERT_EQ(detector.signature_column().get_raw(1), ~base);
+    bridge::collector::collapsing_collector collector(10, clusters);
+    std::vector<float> scores = {1.0F, 2.0F, 3.0F, 0.5F, 0.2F};
+    for (bridge::DocId doc = 0; doc < scores.size(); doc++) {
+        collector.collect(doc, scores[doc]);
+    }
+    ASSERT_EQ(collector.hits(),
+              (std::vector<bridge::collector::group_hit>{{2, 3.0F, 0}, {1, 2.0F, 1}}));
+}
+
+TEST(NearDuplicatesTest, IdenticalSignatures) {
+    using namespace bridge::index;
+
+    // empty texts all get the 0 signature: they are indexed once, not once per document
+    near_duplicate_detector detector;
+    uint64_t other = 0xF0F0F0F0F0F0F0F0ULL;
+    for (bridge::DocId doc = 0; doc < 20000; doc++) {
+        ASSERT_EQ(detector.add(doc % 4 == 1 ? other : simhash_text("")), doc % 4 == 1 ? 1 : 0);
+    }
+    ASSERT_EQ(detector.add(0x3ULL), 0);
+    ASSERT_EQ(detector.num_docs(), 20001);
+    ASSERT_EQ(detector.num_distinct_signatures(), 3);
+
+    ASSERT_EQ(detector.find(0x1ULL), 0);
+    std::vector<bridge::DocId> duplicates = detector.near_duplicates(0x1ULL);
+    ASSERT_EQ(duplicates.size(), 15001);
+    ASSERT_TRUE(std::is_sorted(duplicates.begin(), duplicates.end()));
+    ASSERT_EQ(duplicates.back(), 20000);
+    ASSERT_EQ(detector.near_duplicates(other).size(), 5000);
+}
+
+TEST(NearDuplicatesTest, Corpus) {
+    using namespace bridge::index;
+    std::mt19937 rng(17);
+    std::vector<std::vector<std::string>> originals;
+    for (size_t i = 0; i < 100; i++) {
+        originals.push_back(random_words(rng, 1000));
+    }
+
+    near_duplicate_detector detector;
+    for (bridge::DocId doc = 0; doc < originals.size(); doc++) {
+        ASSERT_EQ(detector.add(simhash(originals[doc])), doc);
+    }
+    size_t detected = 0;
+    for (const auto &words : originals) {
+        auto copy = words;
+        copy[rng() % copy.size()] = "boilerplate";
+        detected += detector.find(simhash(copy)).has_value() ? 1 : 0;
+    }
+    // SimHash is approximate: an edit may flip more bits than the maximum distance
+    ASSERT_GE(detected, 85);
+}
@@ -0,0 +1,135 @@
+// Copyright (c) 2021 Bridge Project (Marcos Pontes)
+
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to
+//  deal in the Software without restriction, including without limitation the
+//  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+//  sell copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+//  IN THE SOFTWARE.
+
+#include <filesystem>
+#include <fstream>
+
+#include <gtest/gtest.h>
+
+#include "bridge/bridge.hpp"
+#include "temp_path.hpp"
+
+namespace {
+
+    using bridge::testing::temp_path;
+
+    std::filesystem::path temp_dir(const std::string &name) {
+        std::filesystem::path path = temp_path(name);
+        std::filesystem::create_directories(path);
+        return path;
+    }
+
+    void write_file(const std::filesystem::path &path, const std::string &content) {
+        std::ofstream(path, std::ios::binary) << content;
+    }
+
+    std::string read_file(const std::filesystem::path &path) {
+        std::ifstream in(path, std::ios::binary);
+        return {std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>()};
+    }
+
+} // namespace
+
+TEST(ReplicationTest, Manifest) {
+    using namespace bridge::index;
+    auto dir = temp_dir("bridge_manifest");
+    ASSERT_FALSE(segment_manifest::load(dir).has_value());
+
+    write_file(dir / "seg_1.postings", "abcdef");
+    write_file(dir / "seg_1.fast", "xy");
+    auto manifest = segment_manifest::of_files(dir, {"seg_1.postings", "seg_1.fast"}, 1);
+    ASSERT_EQ(manifest.files, (std::vector<segment_file>{{"seg_1.fast", 2}, {"seg_1.postings", 6}}));
+    manifest.publish(dir);
+    ASSERT_EQ(segment_manifest::load(dir), manifest);
+    ASSERT_FALSE(std::filesystem::exists(dir / "manifest.json.tmp"));
+
+    for (const char *name : {"manifest.json", "retired.json", "seg_2.fast.tmp", "../seg_2.fast", ".."}) {
+        ASSERT_THROW((void)segment_manifest::of_files(dir, {name}, 2), bridge::bridge_error) << name;
+        bridge::serialization::json_t json = {{"generation", 2}, {"files", {{{"name", name}, {"size", 1}}}}};
+        ASSERT_THROW((void)segment_manifest::from_json(json), bridge::bridge_error) << name;
+    }
+    write_file(dir / manifest_file_name, "{\"generation\": 3}");
+    ASSERT_THROW((void)segment_manifest::load(dir), bridge::bridge_error);
+    std::filesystem::remove_all(dir);
+}
+
+TEST(ReplicationTest, Replicate) {
+    using namespace bridge::index;
+    auto leader = temp_dir("bridge_leader");
+    auto follower = temp_path("bridge_follower");
+
+    ASSERT_THROW((void)replicate(leader, follower), bridge::bridge_error);
+
+    write_file(leader / "seg_1", "first segment");
+    write_file(leader / "seg_2", "second");
+    segment_manifest::of_files(leader, {"seg_1", "seg_2"}, 1).publish(leader);
+    replication_result result = replicate(leader, follower);
+    ASSERT_EQ(result.generation, 1);
+    ASSERT_EQ(result.files_copied, 2);
+    ASSERT_EQ(result.bytes_copied, 19);
+    ASSERT_EQ(read_file(follower / "seg_1"), "first segment");
+    ASSERT_EQ(segment_manifest::load(follower), segment_manifest::load(leader));
+
+    // nothing to do when the follower is up to date
+    result = replicate(leader, follower);
+    ASSERT_EQ(result.files_copied, 0);
+    ASSERT_EQ(result.files_reused, 2);
+
+    // a merge replaces both segments, and a new segment is flushed
+    write_file(leader / "seg_3", "merged segment");
+    write_file(leader / "seg_4", "new");
+    segment_manifest::of_files(leader, {"seg_3", "seg_4"}, 2).publish(leader);
+    std::filesystem::remove(leader / "seg_1");
+    std::filesystem::remove(leader / "seg_2");
+    result = replicate(leader, follower, copy_method::Copy);
+    ASSERT_EQ(result.generation, 2);
+    ASSERT_EQ(result.files_copied, 2);
+    ASSERT_EQ(result.files_removed, 0);
+    ASSERT_EQ(read_file(follower / "seg_4"), "new");
+    ASSERT_EQ(segment_manifest::load(follower)->generation, 2);
+
+    // readers of the previous commit can still open its files until the next replication
+    ASSERT_EQ(read_file(follower / "seg_1"), "first segment");
+    write_file(leader / "seg_6", "flushed");
+    segment_manifest::of_files(leader, {"seg_3", "seg_4", "seg_6"}, 3).publish(leader);
+    result = replicate(leader, follower);
+    ASSERT_EQ(result.files_copied, 1);
+    ASSERT_EQ(result.files_removed, 2);
+    ASSERT_FALSE(std::filesystem::exists(follower / "seg_1"));
+    ASSERT_FALSE(std::filesystem::exists(follower / "seg_2"));
+
+    // a live follower file is never replaced by a different one of the same name
+    write_file(leader / "seg_4", "rewritten");
+    segment_manifest::of_files(leader, {"seg_3", "seg_4", "seg_6"}, 4).publish(leader);
+    ASSERT_THROW((void)replicate(leader, follower), bridge::bridge_error);
+    ASSERT_EQ(read_file(follower / "seg_4"), "new");
+    ASSERT_EQ(segment_manifest::load(follower)->generation, 3);
+
+    // a leader file that does not match its manifest is never published
+    write_file(leader / "seg_5", "truncated");
+    auto manifest = segment_manifest::of_files(leader, {"seg_3", "seg_5"}, 5);
+    manifest.files.back().size = 100;
+    manifest.publish(leader);
+    ASSERT_THROW((void)replicate(leader, follower), bridge::bridge_error);
+    ASSERT_EQ(segment_manifest::load(follower)->generation, 3);
+
+    std::filesystem::remove_all(leader);
+    std::filesystem::remove_all(follower);
+}
@@ -53,6 +53,52 @@ TEST(SchemaOptionsTest, TextFieldOptions) {
     ASSERT_TRUE(text_and_stored_options.is_position_enabled());
 }
 
+TEST(SchemaOptionsTest, TermVectorOptions) {
+    using bridge::schema::text_indexing_option;
+
+    text_indexing_option text_options = bridge::schema::TEXT.get_indexing_options();
+    ASSERT_FALSE(text_options.is_term_vector_enabled());
+    ASSERT_FALSE(text_options.is_offset_enabled());
+
+    text_indexing_option term_vector = text_indexing_option::TokenizedWithTermVector;
+    ASSERT_TRUE(term_vector.is_tokenized());
+    ASSERT_TRUE(term_vector.is_termfreq_enabled());
+    ASSERT_TRUE(term_vector.is_position_enabled());
+    ASSERT_TRUE(term_vector.is_term_vector_enabled());
+    ASSERT_FALSE(term_vector.is_offset_enabled());
+
+    text_indexing_option with_offsets = text_indexing_option::TokenizedWithTermVectorAndOffsets;
+    ASSERT_TRUE(with_offsets.is_term_vector_enabled());
+    ASSERT_TRUE(with_offsets.is_offset_enabled());
+
+    ASSERT_EQ(text_indexing_option::from_str(with_offsets.get_str()), with_offsets);
+    ASSERT_EQ(text_indexing_option::from_str(term_vector.get_str()), term_vector);
+}
+
+TEST(SchemaOptionsTest, PostingsCodec) {
+    using bridge::schema::postings_codec;
+    using bridge::schema::text_field_option;
+
+    text_field_option text_field = bridge::schema::TEXT;
+    ASSERT_EQ(text_field.get_postings_codec(), postings_codec::Default);
+    ASSERT_FALSE(text_field.to_json().contains("codec"));
+
+    text_field_option category = bridge::schema::STRING;
+    category.set_postings_codec(postings_codec::EliasFano);
+    ASSERT_NE(category, bridge::schema::STRING);
+    ASSERT_EQ(category.to_json()["codec"], "elias_fano");
+    ASSERT_EQ(text_field_option::from_json(category.to_json()), category);
+
+    // the codec survives a combination with a default option
+    text_field_option stored_category = category | bridge::schema::STORED;
+    ASSERT_TRUE(stored_category.is_stored());
+    ASSERT_EQ(stored_category.get_postings_codec(), postings_codec::EliasFano);
+
+    std::stringstream ss;
+    bridge::serialization::marshall(ss, category);
+    ASSERT_EQ(bridge::serialization::unmarshall<text_field_option>(ss), category);
+}
+
 TEST(SchemaOptionsTest, SerializeTest) {
     auto string_field = bridge::schema::STRING; // assignment operator
     auto text_field = bridge::schema::TEXT;     // assignment operator
@@ -0,0 +1,129 @@
+// Copyright (c) 2021 Bridge Project (Marcos Pontes)
+
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to
+//  deal in the Software without restriction, including without limitation the
+//  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+//  sell copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+//  IN THE SOFTWARE.
+
+#include <filesystem>
+#include <random>
+#include <set>
+
+#include <gtest/gtest.h>
+
+#include "bridge/bridge.hpp"
+#include "temp_path.hpp"
+
+namespace {
+
+    using bridge::testing::temp_path;
+
+    std::vector<bridge::schema::document> make_documents(size_t n) {
+        std::vector<std::string> words = {"red", "green", "blue", "fast", "slow", "car", "bike", "train"};
+        std::mt19937 rng(11);
+        std::vector<bridge::schema::document> documents;
+        for (uint32_t id = 0; id < n; id++) {
+            std::string text;
+            size_t length = 1 + rng() % 12;
+            for (size_t i = 0; i < length; i++) {
+                text += words[rng() % words.size()] + " ";
+            }
+            bridge::schema::document document;
+            document.add_u32(0, id);
+            document.add_text(1, text);
+            documents.push_back(document);
+        }
+        return documents;
+    }
+
+    uint32_t id_of(const bridge::index::sharded_index &index, const bridge::index::shard_hit &hit) {
+        auto document = index.shard(hit.shard).document(hit.doc);
+        auto [field, end] = document.get_first_by_id(0);
+        return *std::get<bridge::schema::uint32_field>(*field).get_value();
+    }
+
+} // namespace
+
+TEST(ShardedIndexTest, GlobalStatistics) {
+    using namespace bridge::index;
+    auto single_root = temp_path("bridge_single_index");
+    auto sharded_root = temp_path("bridge_sharded_index");
+    auto documents = make_documents(300);
+
+    sharded_index single(single_root, 1, 0);
+    sharded_index sharded(sharded_root, 4, 0);
+    single.add_documents(documents);
+    sharded.add_documents(documents);
+
+    uint64_t total = 0;
+    for (uint32_t shard = 0; shard < sharded.num_shards(); shard++) {
+        ASSERT_GT(sharded.shard(shard).num_docs(), 0);
+        total += sharded.shard(shard).num_docs();
+    }
+    ASSERT_EQ(total, documents.size());
+    ASSERT_LT(sharded.shard_of(documents[0]), 4);
+
+    std::vector<std::string> terms = {"fast", "train", "unknown"};
+    search_statistics stats = sharded.statistics(1, terms);
+    ASSERT_EQ(stats.num_docs, documents.size());
+    ASSERT_EQ(stats.doc_freqs, single.statistics(1, terms).doc_freqs);
+    ASSERT_EQ(stats.doc_freqs[2], 0);
+
+    // every shard scores with the global statistics, so the ranking is the one of a single index
+    auto expected = single.search(1, terms, 20);
+    auto hits = sharded.search(1, terms, 20);
+    ASSERT_EQ(hits.size(), 20);
+    std::set<uint32_t> expected_ids;
+    std::set<uint32_t> ids;
+    for (size_t i = 0; i < hits.size(); i++) {
+        ASSERT_FLOAT_EQ(hits[i].score, expected[i].score);
+        // ties at the last score may be cut differently, since doc ids differ across shards
+        if (hits[i].score > hits.back().score) {
+            expected_ids.insert(id_of(single, expected[i]));
+            ids.insert(id_of(sharded, hits[i]));
+        }
+    }
+    ASSERT_EQ(ids, expected_ids);
+    ASSERT_TRUE(sharded.search(1, {"unknown"}, 5).empty());
+    ASSERT_TRUE(sharded.search(7, {"fast"}, 5).empty());
+
+    std::filesystem::remove_all(single_root);
+    std::filesystem::remove_all(sharded_root);
+}
+
+TEST(ShardedIndexTest, ReopenReplaysLogs) {
+    using namespace bridge::index;
+    auto root = temp_path("bridge_reopened_index");
+    auto documents = make_documents(50);
+
+    std::vector<shard_hit> before;
+    {
+        sharded_index index(root, 3, 0);
+        index.add_documents(documents);
+        before = index.search(1, {"red", "car"}, 10);
+    }
+
+    sharded_index reopened(root, 3, 0);
+    ASSERT_EQ(reopened.search(1, {"red", "car"}, 10), before);
+    ASSERT_THROW(sharded_index(root, 2, 0), bridge::bridge_error);
+    ASSERT_THROW(sharded_index(root, 4, 0), bridge::bridge_error);
+    ASSERT_FALSE(std::filesystem::exists(root / "shard_3"));
+
+    bridge::schema::document no_route;
+    no_route.add_text(1, "red");
+    ASSERT_THROW(reopened.add_documents({no_route}), bridge::bridge_error);
+    std::filesystem::remove_all(root);
+}
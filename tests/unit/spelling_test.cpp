@@ -0,0 +1,150 @@
+// Copyright (c) 2021 Bridge Project (Marcos Pontes)
+
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to
+//  deal in the Software without restriction, including without limitation the
+//  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+//  sell copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+//  IN THE SOFTWARE.
+
+#include <algorithm>
+#include <random>
+
+#include <gtest/gtest.h>
+
+#include "bridge/bridge.hpp"
+
+namespace {
+
+    size_t edit_distance(std::string_view a, std::string_view b) {
+        std::vector<size_t> row(b.size() + 1);
+        for (size_t j = 0; j <= b.size(); j++) {
+            row[j] = j;
+        }
+        for (size_t i = 1; i <= a.size(); i++) {
+            size_t diagonal = row[0];
+            row[0] = i;
+            for (size_t j = 1; j <= b.size(); j++) {
+                size_t up = row[j];
+                row[j] = std::min({up + 1, row[j - 1] + 1, diagonal + (a[i - 1] == b[j - 1] ? 0 : 1)});
+                diagonal = up;
+            }
+        }
+        return row[b.size()];
+    }
+
+} // namespace
+
+TEST(SpellingTest, TermDictionary) {
+    using namespace bridge::postings;
+
+    term_dictionary dictionary = term_dictionary::build({{"search", 10}, {"apple", 3}, {"bridge", 7}, {"", 1}});
+    ASSERT_EQ(dictionary.size(), 4);
+    ASSERT_EQ(dictionary.term(0), "");
+    ASSERT_EQ(dictionary.term(1), "apple");
+    ASSERT_EQ(dictionary.doc_freq(3), 10);
+    ASSERT_EQ(dictionary.ordinal("bridge"), 2);
+    ASSERT_FALSE(dictionary.ordinal("brid").has_value());
+    ASSERT_EQ(dictionary.lower_bound("c"), 3);
+    ASSERT_EQ(dictionary.lower_bound("z"), 4);
+
+    std::vector<bridge::byte_t> buffer;
+    {
+        bridge::directory::ArrayWriter out{bridge::directory::ArrayDevice(buffer)};
+        dictionary.serialize(out);
+    }
+    const bridge::byte_t *data = buffer.data();
+    term_dictionary read = term_dictionary::deserialize(data, buffer.data() + buffer.size());
+    ASSERT_EQ(read.size(), 4);
+    ASSERT_EQ(read.term(3), "search");
+    ASSERT_EQ(read.doc_freq(2), 7);
+
+    ASSERT_THROW(term_dictionary::build({{"a", 1}, {"a", 2}}), bridge::bridge_error);
+}
+
+TEST(SpellingTest, FuzzyTermsMatchBruteForce) {
+    using namespace bridge::suggest;
+
+    std::mt19937 rng(5);
+    std::uniform_int_distribution<int> letter('a', 'f');
+    std::uniform_int_distribution<size_t> length(1, 9);
+    std::vector<std::pair<std::string, uint64_t>> terms;
+    std::vector<std::string> seen;
+    for (int i = 0; i < 3000; i++) {
+        std::string word(length(rng), ' ');
+        std::generate(word.begin(), word.end(), [&]() { return static_cast<char>(letter(rng)); });
+        if (std::find(seen.begin(), seen.end(), word) == seen.end()) {
+            seen.push_back(word);
+            terms.emplace_back(word, rng() % 100);
+        }
+    }
+    auto dictionary = bridge::postings::term_dictionary::build(terms);
+
+    for (std::string query : {"abc", "fedcba", "aaaaaa", "b", "cafebabe"}) {
+        for (uint8_t distance : {0, 1, 2}) {
+            std::vector<correction> found = fuzzy_terms(dictionary, query, distance);
+            std::vector<std::string> expected;
+            for (const auto &[term, doc_freq] : terms) {
+                if (edit_distance(term, query) <= distance) {
+                    expected.push_back(term);
+                }
+            }
+            ASSERT_EQ(found.size(), expected.size());
+            for (size_t i = 0; i < found.size(); i++) {
+                ASSERT_EQ(found[i].distance, edit_distance(found[i].term, query));
+                if (i > 0) {
+                    ASSERT_LE(found[i - 1].distance, found[i].distance);
+                }
+            }
+        }
+    }
+}
+
+TEST(SpellingTest, SaturatedAutomaton) {
+    using namespace bridge::suggest;
+
+    // with the largest distance, saturated states sit at 255 and must not wrap around
+    levenshtein_automaton automaton(std::string(260, 'a'), 254);
+    levenshtein_automaton::state state = automaton.start();
+    levenshtein_automaton::state next;
+    for (int i = 0; i < 600; i++) {
+        automaton.step(state, 'b', next);
+        std::swap(state, next);
+    }
+    ASSERT_FALSE(automaton.distance(state).has_value());
+    ASSERT_FALSE(automaton.can_match(state));
+
+    ASSERT_THROW(levenshtein_automaton("a", 255), bridge::bridge_error);
+}
+
+TEST(SpellingTest, DidYouMean) {
+    using namespace bridge::suggest;
+
+    auto dictionary = bridge::postings::term_dictionary::build(
+        {{"search", 500}, {"starch", 20}, {"engine", 300}, {"engines", 40}, {"fast", 200}, {"fist", 5}, {"of", 900}});
+    spell_checker checker(dictionary);
+
+    std::vector<correction> expected = {{"search", 1, 500}, {"starch", 2, 20}};
+    ASSERT_EQ(checker.candidates("seatch"), expected);
+    ASSERT_EQ(checker.candidates("fazt"), (std::vector<correction>{{"fast", 1, 200}}));
+    ASSERT_TRUE(checker.candidates("oc").empty()); // too short to correct
+
+    auto rewritten = checker.did_you_mean({"fazt", "serch", "engine"});
+    ASSERT_TRUE(rewritten.has_value());
+    ASSERT_EQ(*rewritten, (std::vector<std::string>{"fast", "search", "engine"}));
+    ASSERT_FALSE(checker.did_you_mean({"fast", "search"}).has_value());
+    ASSERT_FALSE(checker.did_you_mean({"zzzzzz"}).has_value());
+
+    ASSERT_THROW(spell_checker(dictionary, 3), bridge::bridge_error);
+}
@@ -0,0 +1,42 @@
+// Copyright (c) 2021 Bridge Project (Marcos Pontes)
+
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to
+//  deal in the Software without restriction, including without limitation the
+//  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+//  sell copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+//  IN THE SOFTWARE.
+
+//! \brief Scratch paths under the temporary directory, shared by the tests that touch the file system.
+
+#ifndef BRIDGE_TESTS_TEMP_PATH_HPP_
+#define BRIDGE_TESTS_TEMP_PATH_HPP_
+
+#include <filesystem>
+#include <string>
+
+namespace bridge::testing {
+
+    /**
+     * @brief Path of a file or directory under the temporary directory, removed if a previous run left it.
+     */
+    inline std::filesystem::path temp_path(const std::string &name) {
+        std::filesystem::path path = std::filesystem::temp_directory_path() / name;
+        std::filesystem::remove_all(path);
+        return path;
+    }
+
+} // namespace bridge::testing
+
+#endif // BRIDGE_TESTS_TEMP_PATH_HPP_
@@ -0,0 +1,102 @@
+#include "bridge/bridge.hpp"
+
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+TEST(TermVectorTest, BuildAndReadBack) {
+    using namespace bridge::postings;
+    using bridge::directory::RAMDirectory;
+    using bridge::schema::text_indexing_option;
+
+    // "tax happy tax" -> ordinals: tax = 7, happy = 2
+    term_vector_builder builder;
+    builder.add_token(7, 0, 3);
+    builder.add_token(2, 4, 9);
+    builder.add_token(7, 10, 13);
+
+    term_vector first = builder.build();
+    ASSERT_EQ(first.size(), 2);
+    ASSERT_EQ(first[0].term_ordinal, 2);
+    ASSERT_EQ(first[0].term_freq, 1);
+    ASSERT_EQ(first[1].term_ordinal, 7);
+    ASSERT_EQ(first[1].term_freq, 2);
+    ASSERT_EQ(first[1].offsets[1], (term_offset{10, 13}));
+
+    builder.add_token(1, 0, 5);
+    term_vector third = builder.build();
+
+    term_vector_writer writer(text_indexing_option::TokenizedWithTermVectorAndOffsets);
+    writer.add_document(0, first);
+    writer.add_document(2, third); // doc 1 has no term vector
+
+    RAMDirectory dir;
+    {
+        auto out = dir.open_write("segment.tv");
+        writer.serialize(*out);
+        out->flush();
+    }
+
+    term_vector_reader reader(dir.open_read("segment.tv"));
+    ASSERT_EQ(reader.num_docs(), 3);
+    ASSERT_TRUE(reader.has_offsets());
+    ASSERT_EQ(reader.get(0), first);
+    ASSERT_TRUE(reader.get(1).empty());
+    ASSERT_EQ(reader.get(2), third);
+    ASSERT_TRUE(reader.get(42).empty());
+}
+
+TEST(TermVectorTest, WithoutOffsets) {
+    using namespace bridge::postings;
+    using bridge::schema::text_indexing_option;
+
+    ASSERT_ANY_THROW(term_vector_writer(text_indexing_option::TokenizedWithFreqAndPosition));
+
+    term_vector_writer writer(text_indexing_option::TokenizedWithTermVector);
+    writer.add_document(0, {{3, 2, {}}, {1000, 1, {}}});
+    ASSERT_ANY_THROW(writer.add_document(0, {}));
+
+    std::vector<bridge::byte_t> buffer;
+    {
+        bridge::directory::ArrayWriter out{bridge::directory::ArrayDevice(buffer)};
+        writer.serialize(out);
+    }
+
+    term_vector_reader reader(std::make_shared<bridge::directory::in_memory_source>(buffer));
+    ASSERT_FALSE(reader.has_offsets());
+
+    term_vector vector = reader.get(0);
+    ASSERT_EQ(vector.size(), 2);
+    ASSERT_EQ(vector[1].term_ordinal, 1000);
+    ASSERT_EQ(vector[0].term_freq, 2);
+    ASSERT_TRUE(vector[0].offsets.empty());
+}
+
+TEST(TermVectorTest, Corrupted) {
+    using namespace bridge::postings;
+    using bridge::schema::text_indexing_option;
+
+    term_vector_writer writer(text_indexing_option::TokenizedWithTermVectorAndOffsets);
+    writer.add_document(0, {{3, 1, {{0, 4}}}});
+    writer.add_document(1, {{5, 1, {{2, 6}}}});
+    std::vector<bridge::byte_t> buffer;
+    {
+        bridge::directory::ArrayWriter out{bridge::directory::ArrayDevice(buffer)};
+        writer.serialize(out);
+    }
+    size_t addresses = buffer.size() - 5 - 3 * sizeof(uint64_t);
+
+    // an address past the data section is rejected when the file is opened
+    std::vector<bridge::byte_t> out_of_range = buffer;
+    out_of_range[addresses + sizeof(uint64_t)] = static_cast<bridge::byte_t>(0x7F);
+    ASSERT_THROW(term_vector_reader(std::make_shared<bridge::directory::in_memory_source>(out_of_range)),
+                 bridge::bridge_error);
+
+    // a huge entry count is rejected before anything is allocated
+    std::vector<bridge::byte_t> huge_count = buffer;
+    huge_count[0] = static_cast<bridge::byte_t>(0x7F);
+    term_vector_reader reader(std::make_shared<bridge::directory::in_memory_source>(huge_count));
+    ASSERT_THROW((void)reader.get(0), bridge::bridge_error);
+    ASSERT_EQ(reader.get(1)[0].term_ordinal, 5);
+}
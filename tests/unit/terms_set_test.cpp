@@ -0,0 +1,126 @@
+// Copyright (c) 2021 Bridge Project (Marcos Pontes)
+
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to
+//  deal in the Software without restriction, including without limitation the
+//  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+//  sell copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+//  IN THE SOFTWARE.
+
+#include <cstdio>
+#include <set>
+
+#include <gtest/gtest.h>
+
+#include "bridge/bridge.hpp"
+
+namespace {
+
+    using bridge::postings::TERMINATED;
+
+    std::string user_id(uint32_t i) {
+        char buffer[16];
+        std::snprintf(buffer, sizeof(buffer), "u%06u", i);
+        return buffer;
+    }
+
+    /// @brief Dictionary of the even user ids below 2 * num_terms. Term ordinal i is held by docs i and i + num_terms.
+    struct entitlements {
+        static constexpr uint32_t num_terms = 5000;
+
+        entitlements() {
+            std::vector<std::pair<std::string, uint64_t>> terms;
+            for (uint32_t i = 0; i < num_terms; i++) {
+                terms.emplace_back(user_id(2 * i), 2);
+            }
+            dictionary = bridge::postings::term_dictionary::build(std::move(terms));
+        }
+
+        [[nodiscard]] bridge::query::postings_opener opener() {
+            return [this](uint32_t ordinal) {
+                opened++;
+                return std::make_unique<bridge::postings::vec_postings>(
+                    std::vector<std::pair<bridge::DocId, uint32_t>>{{ordinal, 1}, {ordinal + num_terms, 1}});
+            };
+        }
+
+        bridge::postings::term_dictionary dictionary;
+        uint32_t opened = 0;
+    };
+
+    std::vector<bridge::DocId> drain(bridge::postings::doc_set &docs) {
+        std::vector<bridge::DocId> out;
+        for (bridge::DocId doc = docs.doc(); doc != TERMINATED; doc = docs.advance()) {
+            out.push_back(doc);
+        }
+        return out;
+    }
+
+} // namespace
+
+TEST(TermsSetTest, GallopingLowerBound) {
+    entitlements index;
+    uint32_t from = 0;
+    for (uint32_t i = 0; i < 2 * entitlements::num_terms + 10; i += 7) {
+        std::string key = user_id(i);
+        uint32_t expected = index.dictionary.lower_bound(key);
+        ASSERT_EQ(index.dictionary.lower_bound(key, from), expected) << key;
+        from = expected;
+    }
+    ASSERT_EQ(index.dictionary.lower_bound("", 0), 0U);
+    ASSERT_EQ(index.dictionary.lower_bound("z", 0), entitlements::num_terms);
+}
+
+TEST(TermsSetTest, Ordinals) {
+    entitlements index;
+    bridge::query::terms_set set({user_id(10), user_id(3), user_id(9998), user_id(10), "a", "zz", user_id(0)});
+    ASSERT_EQ(set.size(), 6U);
+    std::vector<uint32_t> expected = {0, 5, 4999};
+    ASSERT_EQ(set.ordinals(index.dictionary), expected);
+    ASSERT_TRUE(bridge::query::terms_set({}).ordinals(index.dictionary).empty());
+}
+
+TEST(TermsSetTest, MatchingDocs) {
+    constexpr uint32_t max_doc = 2 * entitlements::num_terms;
+    for (uint32_t num_ids : {3U, 100000U}) {
+        entitlements index;
+        std::vector<std::string> ids;
+        std::set<bridge::DocId> expected;
+        for (uint32_t i = 0; i < num_ids; i++) {
+            uint32_t id = (i * 7919U) % (4 * entitlements::num_terms); // odd ids and ids past the end never match
+            ids.push_back(user_id(id));
+            if (id % 2 == 0 && id < max_doc) {
+                expected.insert(id / 2);
+                expected.insert(id / 2 + entitlements::num_terms);
+            }
+        }
+        bridge::query::terms_set set(ids);
+        auto docs = set.matching_docs(index.dictionary, index.opener(), max_doc);
+        ASSERT_EQ(drain(*docs), std::vector<bridge::DocId>(expected.begin(), expected.end()));
+        ASSERT_EQ(index.opened, expected.size() / 2);
+    }
+
+    entitlements index;
+    bridge::query::terms_set set({user_id(0), user_id(2), user_id(4)});
+    for (size_t threshold : {0UL, 16UL}) {
+        auto docs = set.matching_docs(index.dictionary, index.opener(), max_doc, threshold);
+        ASSERT_EQ(docs->doc(), 0U);
+        ASSERT_EQ(docs->seek(2), 2U);
+        ASSERT_EQ(docs->seek(3), 5000U);
+        ASSERT_EQ(docs->advance(), 5001U);
+        ASSERT_EQ(docs->seek(1), 5001U);
+        ASSERT_EQ(docs->advance(), 5002U);
+        ASSERT_EQ(docs->advance(), TERMINATED);
+    }
+}
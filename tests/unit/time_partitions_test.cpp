@@ -0,0 +1,113 @@
+// Copyright (c) 2021 Bridge Project (Marcos Pontes)
+
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to
+//  deal in the Software without restriction, including without limitation the
+//  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+//  sell copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+//  IN THE SOFTWARE.
+
+#include <gtest/gtest.h>
+
+#include "bridge/bridge.hpp"
+
+namespace {
+
+    constexpr int64_t hour = 3600;
+    constexpr int64_t day = 24 * hour;
+
+    bridge::index::segment_meta make_segment(const std::string &name, std::vector<int64_t> timestamps) {
+        bridge::index::segment_meta meta;
+        meta.name = name;
+        meta.num_docs = static_cast<uint32_t>(timestamps.size());
+        meta.add_field("timestamp", bridge::fastfield::numeric_column::build(timestamps));
+        return meta;
+    }
+
+    std::vector<std::string> names(const bridge::index::partition_selection &selection) {
+        std::vector<std::string> result;
+        for (const auto *segment : selection.segments) {
+            result.push_back(segment->name);
+        }
+        return result;
+    }
+
+} // namespace
+
+TEST(TimePartitionsTest, SegmentMeta) {
+    using namespace bridge::index;
+
+    segment_meta meta = make_segment("seg", {50, -20, 30});
+    meta.add_field("price", bridge::fastfield::numeric_column::build(std::vector<double>{2.5, 9.0}));
+    meta.add_field("empty", bridge::fastfield::numeric_column::build(std::vector<uint64_t>{}));
+    ASSERT_EQ(meta.range("timestamp"), value_range::of(int64_t{-20}, int64_t{50}));
+    ASSERT_FALSE(meta.range("empty").has_value());
+
+    ASSERT_TRUE(meta.may_match("timestamp", value_range::of(int64_t{-100}, int64_t{-20})));
+    ASSERT_FALSE(meta.may_match("timestamp", value_range::of(int64_t{51}, int64_t{100})));
+    ASSERT_TRUE(meta.may_match("price", value_range::of(9.0, 10.0)));
+    ASSERT_FALSE(meta.may_match("price", value_range::of(-1.0, 2.0)));
+    ASSERT_FALSE(meta.may_match("empty", value_range::of(uint64_t{0}, ~uint64_t{0})));
+    ASSERT_FALSE(meta.may_match("missing", value_range::of(uint64_t{0}, ~uint64_t{0})));
+
+    ASSERT_EQ(segment_meta::from_json(meta.to_json()), meta);
+    ASSERT_THROW((void)segment_meta::from_json(bridge::serialization::json_t{{"name", "x"}}), bridge::bridge_error);
+}
+
+TEST(TimePartitionsTest, Pruning) {
+    using namespace bridge::index;
+
+    time_partitioned_index index("timestamp", day);
+    ASSERT_EQ(index.window_start(day + 5), day);
+    ASSERT_EQ(index.window_start(-5), -day);
+
+    // 30 days with 4 segments of 6 hours each
+    for (int64_t d = 0; d < 30; d++) {
+        for (int64_t s = 0; s < 4; s++) {
+            int64_t begin = d * day + s * 6 * hour;
+            std::string name = std::to_string(d) + "_" + std::to_string(s);
+            const time_partition &partition = index.add_segment(make_segment(name, {begin, begin + 6 * hour - 1}));
+            ASSERT_EQ(partition.start, d * day);
+        }
+    }
+    ASSERT_EQ(index.partitions().size(), 30);
+
+    // the last hour only visits the last window and its last segment
+    int64_t now = 30 * day - 1;
+    partition_selection last_hour = index.select(now - hour, now);
+    ASSERT_EQ(names(last_hour), (std::vector<std::string>{"29_3"}));
+    ASSERT_EQ(last_hour.partitions_visited, 1);
+    ASSERT_EQ(last_hour.segments_skipped, 3);
+
+    // a range across midnight visits two windows
+    partition_selection midnight = index.select(3 * day - hour, 3 * day + hour);
+    ASSERT_EQ(names(midnight), (std::vector<std::string>{"2_3", "3_0"}));
+    ASSERT_EQ(midnight.partitions_visited, 2);
+
+    ASSERT_TRUE(index.select(40 * day, 41 * day).segments.empty());
+    ASSERT_TRUE(index.select(10, 5).segments.empty());
+    ASSERT_EQ(index.select(0, 30 * day).segments.size(), 120);
+
+    ASSERT_THROW(index.add_segment(make_segment("across", {day - 1, day})), bridge::bridge_error);
+    segment_meta untimed;
+    ASSERT_THROW(index.add_segment(untimed), bridge::bridge_error);
+
+    ASSERT_EQ(time_partitioned_index::from_json(index.to_json()).partitions(), index.partitions());
+
+    auto expired = index.expire(7 * day);
+    ASSERT_EQ(expired.size(), 7);
+    ASSERT_EQ(expired.front().segments.size(), 4);
+    ASSERT_EQ(index.partitions().begin()->first, 7 * day);
+    ASSERT_TRUE(index.select(0, 7 * day - 1).segments.empty());
+}
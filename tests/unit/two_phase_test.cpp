@@ -0,0 +1,136 @@
+// Copyright (c) 2021 Bridge Project (Marcos Pontes)
+
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to
+//  deal in the Software without restriction, including without limitation the
+//  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+//  sell copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+//  IN THE SOFTWARE.
+
+#include <numeric>
+
+#include <gtest/gtest.h>
+
+#include "bridge/bridge.hpp"
+#include "fixed_scorer.hpp"
+
+namespace {
+
+    using bridge::postings::TERMINATED;
+    using bridge::testing::fixed_scorer;
+
+    std::unique_ptr<bridge::query::scorer> scorer_of(const std::vector<bridge::DocId> &docs, bridge::Score score) {
+        std::vector<std::pair<bridge::DocId, bridge::Score>> hits;
+        for (bridge::DocId doc : docs) {
+            hits.emplace_back(doc, score);
+        }
+        return std::make_unique<fixed_scorer>(std::move(hits));
+    }
+
+    std::unique_ptr<bridge::query::scorer> all_docs(bridge::DocId max_doc) {
+        std::vector<bridge::DocId> docs(max_doc);
+        std::iota(docs.begin(), docs.end(), 0);
+        return scorer_of(docs, 0.5F);
+    }
+
+    /// @brief Predicate counting its calls.
+    bridge::query::doc_predicate counted(uint32_t &calls, bridge::DocId divisor) {
+        return [&calls, divisor](bridge::DocId doc) {
+            calls++;
+            return doc % divisor == 0;
+        };
+    }
+
+    std::vector<bridge::DocId> drain(bridge::postings::doc_set &docs) {
+        std::vector<bridge::DocId> out;
+        for (bridge::DocId doc = docs.doc(); doc != TERMINATED; doc = docs.advance()) {
+            out.push_back(doc);
+        }
+        return out;
+    }
+
+    template <typename... Scorers> std::vector<std::unique_ptr<bridge::query::scorer>> clauses(Scorers... scorers) {
+        std::vector<std::unique_ptr<bridge::query::scorer>> out;
+        (out.push_back(std::move(scorers)), ...);
+        return out;
+    }
+
+} // namespace
+
+TEST(TwoPhaseTest, PredicateScorer) {
+    uint32_t calls = 0;
+    bridge::query::predicate_scorer filtered(all_docs(100), counted(calls, 10), 100.0F);
+    ASSERT_NE(filtered.two_phase(), nullptr);
+    ASSERT_FLOAT_EQ(filtered.two_phase()->match_cost(), 100.0F);
+    ASSERT_EQ(filtered.doc(), 0U);
+    ASSERT_EQ(filtered.advance(), 10U);
+    ASSERT_EQ(filtered.seek(31), 40U);
+    ASSERT_FLOAT_EQ(filtered.score(), 0.5F);
+    ASSERT_EQ(calls, 21U); // 31 to 39 are checked, 11 to 30 are skipped
+
+    std::vector<bridge::DocId> expected = {40, 50, 60, 70, 80, 90};
+    ASSERT_EQ(drain(filtered), expected);
+    ASSERT_EQ(filtered.advance(), TERMINATED);
+}
+
+TEST(TwoPhaseTest, ConjunctionConfirmsOnAgreement) {
+    uint32_t calls = 0;
+    bridge::query::conjunction_scorer conjunction(
+        clauses(std::make_unique<bridge::query::predicate_scorer>(all_docs(100), counted(calls, 10), 100.0F),
+                scorer_of({10, 20, 30, 55}, 1.0F)));
+    ASSERT_NE(conjunction.two_phase(), nullptr);
+    ASSERT_EQ(conjunction.doc(), 10U);
+    ASSERT_FLOAT_EQ(conjunction.score(), 1.5F);
+    std::vector<bridge::DocId> expected = {10, 20, 30};
+    ASSERT_EQ(drain(conjunction), expected);
+    ASSERT_EQ(calls, 5U); // doc 0 when the clause is built, then only the documents of the cheap clause
+
+    bridge::query::conjunction_scorer plain(clauses(scorer_of({1, 3, 5, 7, 9}, 1.0F), scorer_of({3, 4, 9}, 2.0F)));
+    ASSERT_EQ(plain.two_phase(), nullptr);
+    ASSERT_EQ(plain.doc(), 3U);
+    ASSERT_FLOAT_EQ(plain.score(), 3.0F);
+    ASSERT_EQ(plain.seek(4), 9U);
+    ASSERT_EQ(plain.advance(), TERMINATED);
+
+    ASSERT_THROW(bridge::query::conjunction_scorer({}), bridge::bridge_error);
+}
+
+TEST(TwoPhaseTest, CheapestConfirmationFirst) {
+    uint32_t cheap_calls = 0;
+    uint32_t costly_calls = 0;
+    bridge::query::conjunction_scorer conjunction(
+        clauses(std::make_unique<bridge::query::predicate_scorer>(all_docs(60), counted(costly_calls, 3), 50.0F),
+                std::make_unique<bridge::query::predicate_scorer>(all_docs(60), counted(cheap_calls, 2), 1.0F)));
+    std::vector<bridge::DocId> expected = {0, 6, 12, 18, 24, 30, 36, 42, 48, 54};
+    ASSERT_EQ(drain(conjunction), expected);
+    ASSERT_EQ(cheap_calls, 60U);
+    ASSERT_EQ(costly_calls, 30U);
+}
+
+TEST(TwoPhaseTest, NestedConjunctionsDeferConfirmation) {
+    uint32_t calls = 0;
+    auto inner = std::make_unique<bridge::query::conjunction_scorer>(
+        clauses(std::make_unique<bridge::query::predicate_scorer>(all_docs(100), counted(calls, 5), 10.0F),
+                all_docs(100)));
+    ASSERT_NE(inner->two_phase(), nullptr);
+    ASSERT_EQ(calls, 1U); // positioned on doc 0
+
+    calls = 0;
+    bridge::query::conjunction_scorer outer(clauses(std::move(inner), scorer_of({7, 15, 16, 95}, 1.0F)));
+    ASSERT_EQ(outer.doc(), 15U);
+    ASSERT_FLOAT_EQ(outer.score(), 2.0F);
+    std::vector<bridge::DocId> expected = {15, 95};
+    ASSERT_EQ(drain(outer), expected);
+    ASSERT_EQ(calls, 4U);
+}
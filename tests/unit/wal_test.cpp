@@ -0,0 +1,251 @@
+// Copyright (c) 2021 Bridge Project (Marcos Pontes)
+
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to
+//  deal in the Software without restriction, including without limitation the
+//  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+//  sell copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+//  IN THE SOFTWARE.
+
+#include <csignal>
+#include <filesystem>
+#include <fstream>
+#include <thread>
+
+#include <sys/resource.h>
+
+#include <gtest/gtest.h>
+
+#include "bridge/bridge.hpp"
+#include "temp_path.hpp"
+
+namespace {
+
+    using bridge::testing::temp_path;
+
+    bridge::schema::document make_document(const std::string &title, uint32_t year) {
+        bridge::schema::document document;
+        document.add_text(0, title);
+        document.add_u32(1, year);
+        return document;
+    }
+
+    std::vector<bridge::index::wal_record> replay_all(const std::filesystem::path &path, uint64_t after = 0) {
+        std::vector<bridge::index::wal_record> records;
+        bridge::index::write_ahead_log::replay(
+            path, [&](const bridge::index::wal_record &record) { records.push_back(record); }, after);
+        return records;
+    }
+
+} // namespace
+
+TEST(WalTest, Replay) {
+    using namespace bridge::index;
+    auto path = temp_path("bridge_wal_replay.log");
+
+    {
+        write_ahead_log wal(path);
+        ASSERT_EQ(wal.add_documents({make_document("hello world", 2021), make_document("", 0)}), 1);
+        ASSERT_EQ(wal.delete_terms({bridge::schema::term::from_string(0, "hello")}), 2);
+        ASSERT_EQ(wal.durable_sequence(), 0);
+        wal.sync(2);
+        ASSERT_EQ(wal.durable_sequence(), 2);
+        ASSERT_EQ(wal.num_syncs(), 1);
+    }
+
+    auto records = replay_all(path);
+    ASSERT_EQ(records.size(), 2);
+    ASSERT_EQ(records[0].sequence, 1);
+    ASSERT_EQ(records[0].op, wal_op::AddDocuments);
+    ASSERT_EQ(records[0].documents.size(), 2);
+    ASSERT_TRUE(records[0].documents[0] == make_document("hello world", 2021));
+    ASSERT_TRUE(records[0].documents[1] == make_document("", 0));
+    ASSERT_EQ(records[1].op, wal_op::DeleteTerms);
+    ASSERT_EQ(records[1].terms, (std::vector<bridge::schema::term>{bridge::schema::term::from_string(0, "hello")}));
+    ASSERT_EQ(replay_all(path, 1).size(), 1);
+
+    // the log goes on where it stopped, and a reset keeps the numbering
+    {
+        write_ahead_log wal(path);
+        ASSERT_EQ(wal.last_sequence(), 2);
+        ASSERT_EQ(wal.add_documents({make_document("again", 1)}), 3);
+        wal.reset(3);
+        ASSERT_EQ(wal.add_documents({make_document("after reset", 2)}), 4);
+    }
+    records = replay_all(path);
+    ASSERT_EQ(records.size(), 1);
+    ASSERT_EQ(records[0].sequence, 4);
+    std::filesystem::remove(path);
+}
+
+TEST(WalTest, ResetKeepsLaterBatches) {
+    using namespace bridge::index;
+    auto path = temp_path("bridge_wal_reset.log");
+
+    {
+        write_ahead_log wal(path);
+        wal.add_documents({make_document("one", 1)});
+        wal.add_documents({make_document("two", 2)});
+        wal.sync();
+        // batches 3 and 4 arrive after the segment commit captured batch 2; 4 is not even flushed
+        wal.add_documents({make_document("three", 3)});
+        wal.sync();
+        wal.add_documents({make_document("four", 4)});
+        wal.reset(2);
+        ASSERT_EQ(wal.durable_sequence(), 3);
+        ASSERT_THROW(wal.reset(5), bridge::bridge_error);
+        wal.sync(4);
+        ASSERT_EQ(wal.add_documents({make_document("five", 5)}), 5);
+    }
+    ASSERT_FALSE(std::filesystem::exists(path.string() + ".tmp"));
+    auto records = replay_all(path);
+    ASSERT_EQ(records.size(), 3);
+    ASSERT_EQ(records[0].sequence, 3);
+    ASSERT_TRUE(records[0].documents[0] == make_document("three", 3));
+    ASSERT_EQ(records[2].sequence, 5);
+
+    // an empty log still carries the committed sequence, so numbering resumes above it
+    {
+        write_ahead_log wal(path);
+        wal.reset(5);
+    }
+    ASSERT_EQ(replay_all(path).size(), 0);
+    write_ahead_log wal(path);
+    ASSERT_EQ(wal.last_sequence(), 5);
+    std::filesystem::remove(path);
+}
+
+TEST(WalTest, FailedFlush) {
+    using namespace bridge::index;
+    auto path = temp_path("bridge_wal_failed.log");
+
+    {
+        write_ahead_log wal(path);
+        wal.add_documents({make_document("kept", 1)});
+        wal.sync();
+
+        // a file size limit makes the next flush fail halfway through its group
+        struct rlimit previous {};
+        ASSERT_EQ(::getrlimit(RLIMIT_FSIZE, &previous), 0);
+        auto previous_handler = std::signal(SIGXFSZ, SIG_IGN);
+        struct rlimit limit = previous;
+        limit.rlim_cur = std::filesystem::file_size(path) + 16;
+        ASSERT_EQ(::setrlimit(RLIMIT_FSIZE, &limit), 0);
+        uint64_t lost = wal.add_documents({make_document(std::string(256, 'x'), 2)});
+        ASSERT_THROW(wal.sync(lost), bridge::directory::io_error);
+        ASSERT_EQ(::setrlimit(RLIMIT_FSIZE, &previous), 0);
+        std::signal(SIGXFSZ, previous_handler);
+
+        ASSERT_EQ(wal.durable_sequence(), 1);
+        ASSERT_THROW(wal.sync(lost), bridge::directory::io_error);
+        ASSERT_THROW(wal.add_documents({make_document("refused", 3)}), bridge::directory::io_error);
+        ASSERT_EQ(wal.durable_sequence(), 1);
+    }
+
+    // the torn bytes were cut off, so the log goes on right after the last durable batch
+    {
+        write_ahead_log wal(path);
+        ASSERT_EQ(wal.last_sequence(), 1);
+        wal.add_documents({make_document("after", 2)});
+    }
+    auto records = replay_all(path);
+    ASSERT_EQ(records.size(), 2);
+    ASSERT_TRUE(records[1].documents[0] == make_document("after", 2));
+    std::filesystem::remove(path);
+}
+
+TEST(WalTest, TornRecord) {
+    using namespace bridge::index;
+    auto path = temp_path("bridge_wal_torn.log");
+
+    {
+        write_ahead_log wal(path);
+        wal.add_documents({make_document("first", 1)});
+        wal.add_documents({make_document("second", 2)});
+        wal.sync();
+    }
+    // a crash in the middle of the second record
+    std::filesystem::resize_file(path, std::filesystem::file_size(path) - 3);
+    ASSERT_EQ(replay_all(path).size(), 1);
+
+    {
+        write_ahead_log wal(path);
+        ASSERT_EQ(wal.last_sequence(), 1);
+        wal.add_documents({make_document("third", 3)});
+    }
+    auto records = replay_all(path);
+    ASSERT_EQ(records.size(), 2);
+    ASSERT_TRUE(records[1].documents[0] == make_document("third", 3));
+
+    // a crash while the header of a new log was written
+    std::filesystem::resize_file(path, 5);
+    ASSERT_EQ(replay_all(path).size(), 0);
+    {
+        write_ahead_log wal(path);
+        ASSERT_EQ(wal.last_sequence(), 0);
+        wal.add_documents({make_document("fourth", 4)});
+    }
+    records = replay_all(path);
+    ASSERT_EQ(records.size(), 1);
+    ASSERT_TRUE(records[0].documents[0] == make_document("fourth", 4));
+
+    std::ofstream(path, std::ios::binary | std::ios::trunc) << "not a write-ahead log";
+    ASSERT_THROW(write_ahead_log wal(path), bridge::bridge_error);
+    std::filesystem::remove(path);
+    ASSERT_EQ(write_ahead_log::replay(path, [](const wal_record &) { FAIL(); }), 0);
+}
+
+TEST(WalTest, SyncUnwrittenBatch) {
+    using namespace bridge::index;
+    auto path = temp_path("bridge_wal_unwritten.log");
+
+    write_ahead_log wal(path);
+    uint64_t sequence = wal.add_documents({make_document("first", 1)});
+    ASSERT_THROW(wal.sync(sequence + 1), bridge::bridge_error);
+    wal.sync(sequence);
+    ASSERT_EQ(wal.durable_sequence(), sequence);
+}
+
+TEST(WalTest, GroupCommit) {
+    using namespace bridge::index;
+    auto path = temp_path("bridge_wal_group.log");
+
+    constexpr size_t num_threads = 8;
+    constexpr size_t batches = 25;
+    {
+        write_ahead_log wal(path, wal_options{std::chrono::microseconds(500)});
+        std::vector<std::thread> writers;
+        for (size_t t = 0; t < num_threads; t++) {
+            writers.emplace_back([&, t]() {
+                for (size_t i = 0; i < batches; i++) {
+                    uint64_t sequence = wal.add_documents({make_document("doc", static_cast<uint32_t>(t))});
+                    wal.sync(sequence);
+                    ASSERT_GE(wal.durable_sequence(), sequence);
+                }
+            });
+        }
+        for (auto &writer : writers) {
+            writer.join();
+        }
+        ASSERT_EQ(wal.durable_sequence(), num_threads * batches);
+        ASSERT_LT(wal.num_syncs(), num_threads * batches);
+    }
+
+    auto records = replay_all(path);
+    ASSERT_EQ(records.size(), num_threads * batches);
+    for (size_t i = 0; i < records.size(); i++) {
+        ASSERT_EQ(records[i].sequence, i + 1);
+    }
+    std::filesystem::remove(path);
+}